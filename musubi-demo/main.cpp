@@ -1,24 +1,34 @@
 #include <musubi/application.h>
 #include <musubi/asset_loader.h>
 #include <musubi/asset_registry.h>
+#include <musubi/load_pipeline.h>
 #include <musubi/pixmap.h>
 #include <musubi/screen.h>
+#include <musubi/simd.h>
+#include <musubi/thread_pool.h>
+#include <musubi/gl/dynamic_atlas.h>
+#include <musubi/gl/render_queue.h>
 #include <musubi/gl/shapes.h>
+#include <musubi/gl/sprite_recorder.h>
+#include <musubi/gl/static_batch.h>
+#include <musubi/gl/texture_memory.h>
+#include <musubi/gl/texture_residency.h>
+#include <musubi/gl/texture_streamer.h>
 #include <musubi/gl/textures.h>
 #include <musubi/sdl/sdl_init.h>
 #include <musubi/sdl/sdl_window.h>
 
 #include <epoxy/gl.h>
-#include <glm/ext/matrix_transform.hpp>
+#include <glm/mat3x3.hpp>
 
 #include <chrono>
 #include <cmath>
+#include <cstring>
 #include <thread>
 
 using namespace musubi;
 using namespace std::chrono;
-using glm::mat4, glm::vec3, glm::vec4;
-using glm::identity, glm::rotate, glm::translate;
+using glm::mat3, glm::vec4;
 
 constexpr float hsv_to_rgb_k(uint32 n, float hue) {
     constexpr float PI_3{pi<float> / 3.0f};
@@ -76,6 +86,9 @@ struct renderer_test_screen final : basic_screen {
 
     time_point<clock_type> startTime{};
 
+    thread_pool workers{};
+    std::unique_ptr<load_pipeline> loader{};
+    std::future<std::shared_ptr<gl::texture>> pendingTexture{};
     std::shared_ptr<gl::texture> texture{};
 
     gl::gl_shape_renderer shapes{};
@@ -84,24 +97,22 @@ struct renderer_test_screen final : basic_screen {
     void on_attached(window *window) override {
         basic_screen::on_attached(window);
 
-        {
-            buffer_pixmap<pixmap_format::rgba8> pixmap(1280, 720);
-            const auto radius = std::max(std::min(pixmap.get_width(), pixmap.get_height()) - 100.0f, 100.0f);
-            for (uint32 x = 0; x < pixmap.get_width(); ++x) {
-                for (uint32 y = 0; y < pixmap.get_height(); ++y) {
-                    const float dX = static_cast<float>(x) - pixmap.get_width() / 2.0f,
-                            dY = static_cast<float>(y) - pixmap.get_height() / 2.0f;
+        // Generate the pixmap and its mip chain on worker threads; the texture is created on the window's thread
+        loader = std::make_unique<load_pipeline>(workers, window->get_task_queue());
+        pendingTexture = gl::load_texture_async(*loader, [this]() {
+            auto pixmap = std::make_unique<buffer_pixmap<pixmap_format::rgba8>>(1280, 720);
+            const auto radius = std::max(std::min(pixmap->get_width(), pixmap->get_height()) - 100.0f, 100.0f);
+            const auto centerX = pixmap->get_width() / 2.0f, centerY = pixmap->get_height() / 2.0f;
+            pixmap->generate([=](uint32 x, uint32 y) {
+                const float dX = static_cast<float>(x) - centerX, dY = static_cast<float>(y) - centerY;
 
-                    const auto hue = std::atan2(-dY, dX);
-                    const auto saturation =
-                            std::clamp(std::sqrt(dX * dX + dY * dY) / radius, 0.0f, 1.0f);
+                const auto hue = std::atan2(-dY, dX);
+                const auto saturation = std::clamp(std::sqrt(dX * dX + dY * dY) / radius, 0.0f, 1.0f);
 
-                    pixmap.set_pixel(x, y, hsv_to_rgba(hue, saturation, 1));
-                }
-            }
-
-            texture = std::make_shared<gl::texture>(pixmap, true, GL_RGBA8);
-        }
+                return rgba8_pixel::from_value(hsv_to_rgba(hue, saturation, 1));
+            }, &workers);
+            return pixmap;
+        }, downscale_filter::box, true, GL_RGBA8);
 
         camera camera;
         camera
@@ -119,51 +130,829 @@ struct renderer_test_screen final : basic_screen {
         glClearColor(0.5, 0.5, 0.5, 1);
         glClear(GL_COLOR_BUFFER_BIT);
 
-        textures.begin_batch(texture);
-        musubi::gl::texture_region region(texture, (std::sin(elapsed) / 4 + 0.25f),
-                                          (std::sin(elapsed) / 4 + 0.25f), 1, 1);
-        textures.batch_draw_region(region, -640, -360, 1280, 720);
-        textures.end_batch(false);
+        if (!texture) {
+            if (pendingTexture.wait_for(0s) != std::future_status::ready) return;
+            texture = pendingTexture.get();
+        }
 
         const auto x = 500 * std::sin(elapsed);
         const auto y = 220 * std::cos(2 * pi<float> * elapsed);
         constexpr auto hl = 50.0f;
-        const auto squareTransform = rotate(translate(identity<mat4>(), {x, y, 0}), 4 * elapsed,
-                                            {0, 0, 1});
+        const auto squareAngle = 4 * elapsed, rectangleAngle = elapsed;
+        const mat3 squareTransform{
+                std::cos(squareAngle), std::sin(squareAngle), 0,
+                -std::sin(squareAngle), std::cos(squareAngle), 0,
+                x, y, 1
+        };
+        const mat3 rectangleTransform{
+                std::cos(rectangleAngle), std::sin(rectangleAngle), 0,
+                -std::sin(rectangleAngle), std::cos(rectangleAngle), 0,
+                0, 0, 1
+        };
 
+        // Per-draw transforms keep the rotated square in the same draw call as the background
         textures.begin_batch(texture);
-        textures.transform = squareTransform;
+        musubi::gl::texture_region region(texture, (std::sin(elapsed) / 4 + 0.25f),
+                                          (std::sin(elapsed) / 4 + 0.25f), 1, 1);
+        textures.batch_draw_region(region, -640, -360, 1280, 720);
+        textures.drawTransform = squareTransform;
+        textures.tint = {1, 1, 1, 0.75f};
         textures.batch_draw_texture(-hl, -hl, hl * 2, hl * 2);
+        textures.tint = {1, 1, 1, 1};
         textures.end_batch(true);
 
+        const auto phaseShift = 2.0f / 3.0f * pi<float>;
         shapes.begin_batch();
         shapes.color = {0, 0, 0, 1};
-        shapes.transform = squareTransform;
+        shapes.drawTransform = squareTransform;
         shapes.batch_draw_line(-hl, -hl, -hl, hl);
         shapes.batch_draw_line(-hl, hl, hl, hl);
         shapes.batch_draw_line(hl, hl, hl, -hl);
         shapes.batch_draw_line(hl, -hl, -hl, -hl);
-        shapes.end_batch(true);
 
-        const auto phaseShift = 2.0f / 3.0f * pi<float>;
-        shapes.begin_batch();
         shapes.color = {
                 std::sin(elapsed + 0.0f * phaseShift) / 2.0f + 0.5f,
                 std::sin(elapsed + 1.0f * phaseShift) / 2.0f + 0.5f,
                 std::sin(elapsed + 2.0f * phaseShift) / 2.0f + 0.5f,
                 1
         };
+        shapes.drawTransform = mat3{1.0f};
         shapes.batch_draw_circle(0, 0, 300);
-        shapes.end_batch(false);
 
-        shapes.begin_batch();
         shapes.color = {0, 1, 1, 1};
-        shapes.transform = rotate(identity<mat4>(), elapsed, {0, 0, 1});
+        shapes.drawTransform = rectangleTransform;
         shapes.batch_draw_rectangle(0, -50, 300, 100);
         shapes.end_batch(true);
     }
 };
 
+struct canvas_test_screen final : basic_screen {
+    using clock_type = steady_clock;
+    using delta_type = duration<float>;
+
+    static constexpr uint32 canvasSize = 512;
+    static constexpr uint32 brushSize = 8;
+
+    time_point<clock_type> startTime{};
+
+    buffer_pixmap<pixmap_format::rgba8> canvas{canvasSize, canvasSize};
+    std::shared_ptr<gl::texture> texture{};
+
+    gl::gl_texture_renderer textures{};
+
+    void on_attached(window *window) override {
+        basic_screen::on_attached(window);
+        startTime = clock_type::now();
+
+        canvas.fill(0xFFFFFFFFu);
+        texture = std::make_shared<gl::texture>(canvas, false, GL_RGBA8);
+        canvas.clear_dirty();
+
+        camera camera;
+        camera
+                .set_viewport_ortho(1280, 720)
+                .set_position(0, 0);
+
+        textures.init();
+        textures.camera = camera;
+    }
+
+    void on_update(float dt) override {
+        const auto elapsed = duration_cast<delta_type>(clock_type::now() - startTime).count();
+
+        // Paint a brush stroke; only the touched rows are re-uploaded
+        const auto range = static_cast<float>(canvasSize - brushSize) / 2.0f;
+        const auto x = static_cast<uint32>(range + range * std::sin(3.0f * elapsed));
+        const auto y = static_cast<uint32>(range + range * std::sin(4.0f * elapsed));
+        canvas.fill_rect(x, y, brushSize, brushSize, hsv_to_rgba(elapsed, 1, 1));
+        texture->update(canvas);
+
+        glClearColor(0.5, 0.5, 0.5, 1);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        textures.begin_batch(texture);
+        textures.batch_draw_texture(-256, -256, 512, 512);
+        textures.end_batch(false);
+    }
+};
+
+struct streaming_test_screen final : basic_screen {
+    static constexpr uint32 textureSize = 1024;
+    static constexpr uint32 tileSize = 64;
+
+    std::unique_ptr<gl::texture_streamer> streamer{};
+    std::shared_ptr<gl::texture> texture{};
+    gl::gl_texture_renderer textures{};
+
+    // Declared last, so that all tile tasks have finished before the streamer is destroyed
+    thread_pool workers{};
+
+    void stream_tile(uint32 tileX, uint32 tileY) {
+        const pixmap_rect region{tileX * tileSize, tileY * tileSize, tileSize, tileSize};
+        auto staging = streamer->try_acquire(texture, region);
+        if (!staging) {
+            // The staging ring is full; try again once the render thread has issued some uploads
+            std::this_thread::yield();
+            workers.post([=]() { stream_tile(tileX, tileY); });
+            return;
+        }
+
+        // Pixels are generated directly into the mapped staging memory
+        const auto color = hsv_to_rgba(static_cast<float>(tileX + tileY), 0.5f, 1);
+        for (uint32 y = 0; y < tileSize; ++y) {
+            const auto row = reinterpret_cast<rgba8_pixel *>(staging->row_data(y));
+            for (uint32 x = 0; x < tileSize; ++x) {
+                row[x] = rgba8_pixel::from_value((x ^ y) & 8u ? color : 0x000000FFu);
+            }
+        }
+        streamer->commit(std::move(*staging));
+    }
+
+    void on_attached(window *window) override {
+        basic_screen::on_attached(window);
+
+        // Spread the 4 MiB of tiles over multiple frames
+        streamer = std::make_unique<gl::texture_streamer>(1024u * 1024u, 3, 256u * 1024u);
+        texture = std::make_shared<gl::texture>();
+        texture->allocate(textureSize, textureSize, pixmap_format::rgba8);
+
+        for (uint32 tileY = 0; tileY < textureSize / tileSize; ++tileY) {
+            for (uint32 tileX = 0; tileX < textureSize / tileSize; ++tileX) {
+                workers.post([=]() { stream_tile(tileX, tileY); });
+            }
+        }
+
+        camera camera;
+        camera
+                .set_viewport_ortho(1280, 720)
+                .set_position(0, 0);
+
+        textures.init();
+        textures.camera = camera;
+    }
+
+    void on_update(float dt) override {
+        streamer->process();
+
+        glClearColor(0.5, 0.5, 0.5, 1);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        textures.begin_batch(texture);
+        textures.batch_draw_texture(-320, -320, 640, 640);
+        textures.end_batch(false);
+    }
+};
+
+struct background_load_test_screen final : basic_screen {
+    std::future<std::shared_ptr<gl::texture>> pendingTexture{};
+    std::shared_ptr<gl::texture> texture{};
+
+    gl::gl_texture_renderer textures{};
+
+    void on_attached(window *window) override {
+        basic_screen::on_attached(window);
+
+        // The texture is created and uploaded on the loader's thread; this thread never waits on the driver
+        auto &loader = dynamic_cast<sdl::sdl_window &>(*window).enable_loader();
+        auto pixmap = std::make_shared<buffer_pixmap<pixmap_format::rgba8>>(2048, 2048);
+        pixmap->generate([](uint32 x, uint32 y) {
+            return rgba8_pixel::from_value(hsv_to_rgba(static_cast<float>(x ^ y) / 256.0f, 1, 1));
+        });
+        pendingTexture = loader.load_texture(std::move(pixmap));
+
+        camera camera;
+        camera
+                .set_viewport_ortho(1280, 720)
+                .set_position(0, 0);
+
+        textures.init();
+        textures.camera = camera;
+    }
+
+    void on_update(float dt) override {
+        glClearColor(0.5, 0.5, 0.5, 1);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        if (!texture) {
+            if (pendingTexture.wait_for(0s) != std::future_status::ready) return;
+            texture = pendingTexture.get();
+        }
+
+        textures.begin_batch(texture);
+        textures.batch_draw_texture(-320, -320, 640, 640);
+        textures.end_batch(false);
+    }
+};
+
+struct atlas_test_screen final : basic_screen {
+    static constexpr uint32 iconCount = 256;
+
+    gl::dynamic_atlas atlas{512, 2};
+    std::vector<gl::dynamic_atlas::entry_id> icons{};
+
+    gl::gl_texture_renderer textures{};
+
+    void on_attached(window *window) override {
+        basic_screen::on_attached(window);
+
+        // Generate icons of varying sizes; each is packed into one of the atlas pages
+        for (uint32 i = 0; i < iconCount; ++i) {
+            const auto size = 8 + (i * 7) % 25;
+            buffer_pixmap<pixmap_format::rgba8> icon(size, size);
+            icon.fill(hsv_to_rgba(static_cast<float>(i) / iconCount * 2 * pi<float>, 1, 1));
+            if (const auto id = atlas.insert(icon)) icons.push_back(*id);
+        }
+        const auto stats = atlas.get_stats();
+        std::cout << "Packed " << stats.entries << " icons into " << stats.pages << " atlas pages ("
+                  << 100 * stats.usedArea / std::max<uint64>(stats.capacity, 1) << "% occupied)\n";
+
+        camera camera;
+        camera
+                .set_viewport_ortho(1280, 720)
+                .set_position(0, 0);
+
+        textures.init();
+        textures.camera = camera;
+    }
+
+    void on_update(float dt) override {
+        atlas.next_frame();
+
+        glClearColor(0.5, 0.5, 0.5, 1);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        // All icons are drawn in a single batch, regardless of their page
+        textures.begin_batch();
+        for (std::size_t i = 0; i < icons.size(); ++i) {
+            const auto x = -640.0f + static_cast<float>(i % 32) * 40, y = 320.0f - static_cast<float>(i / 32) * 40;
+            textures.batch_draw_region(atlas.get_region(icons[i]), x, y, 32, 32);
+        }
+        textures.end_batch(false);
+    }
+};
+
+struct residency_test_screen final : basic_screen {
+    static constexpr uint32 textureCount = 8;
+    static constexpr uint32 framesPerTexture = 60;
+
+    gl::texture_residency residency{30};
+    std::vector<gl::texture_residency::texture_id> ids{};
+
+    gl::gl_texture_renderer textures{};
+    uint32 frame{0};
+
+    void on_attached(window *window) override {
+        basic_screen::on_attached(window);
+
+        // Each texture occupies 256 KiB; the budget only fits two of them, so idle ones are evicted
+        gl::set_texture_memory_budget(gl::texture_category::world, 2 * 256 * 256 * 4);
+        for (uint32 i = 0; i < textureCount; ++i) {
+            ids.push_back(residency.add([i]() {
+                auto pixmap = std::make_shared<buffer_pixmap<pixmap_format::rgba8>>(256, 256);
+                pixmap->fill(hsv_to_rgba(static_cast<float>(i) / textureCount * 2 * pi<float>, 1, 1));
+                return pixmap;
+            }, gl::texture_category::world));
+        }
+
+        camera camera;
+        camera
+                .set_viewport_ortho(1280, 720)
+                .set_position(0, 0);
+
+        textures.init();
+        textures.camera = camera;
+    }
+
+    void on_detached(window *window) override {
+        basic_screen::on_detached(window);
+        gl::set_texture_memory_budget(gl::texture_category::world, 0);
+    }
+
+    void on_update(float dt) override {
+        residency.next_frame();
+
+        glClearColor(0.5, 0.5, 0.5, 1);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        // Cycle through the textures, so that every texture is evicted and reloaded on its next turn
+        const auto current = (frame / framesPerTexture) % textureCount;
+        textures.begin_batch();
+        textures.batch_draw_texture(residency.acquire(ids[current]), -128, -128, 256, 256);
+        textures.end_batch(false);
+
+        if (++frame % framesPerTexture == 0) {
+            const auto stats = residency.get_stats();
+            const auto usage = gl::get_texture_memory_usage(gl::texture_category::world);
+            std::cout << "residency: " << stats.resident << '/' << stats.textures << " resident ("
+                      << usage.bytes << '/' << usage.budget << " bytes), " << stats.loads << " loads, "
+                      << stats.reloads << " reloads, " << stats.evictions << " evictions\n";
+        }
+    }
+};
+
+struct instancing_test_screen final : basic_screen {
+    using clock_type = steady_clock;
+    using delta_type = duration<float, std::milli>;
+
+    static constexpr uint32 spriteCount = 100000;
+    static constexpr uint32 framesPerMode = 240;
+
+    std::shared_ptr<gl::texture> texture{};
+    std::vector<gl::sprite_instance> sprites{};
+    std::vector<vec4> velocities{}; // x, y velocity, angular velocity, unused
+
+    gl::gl_texture_renderer textures{};
+
+    uint32 frame{0};
+    float totalMs[2]{};
+
+    void on_attached(window *window) override {
+        basic_screen::on_attached(window);
+
+        buffer_pixmap<pixmap_format::rgba8> pixmap(16, 16);
+        pixmap.fill(rgba8(255, 255, 255));
+        texture = std::make_shared<gl::texture>(pixmap);
+
+        sprites.resize(spriteCount);
+        velocities.resize(spriteCount);
+        for (uint32 i = 0; i < spriteCount; ++i) {
+            const auto angle = static_cast<float>(i) * 0.618f * 2 * pi<float>;
+            auto &sprite = sprites[i];
+            sprite.x = static_cast<float>(i % 1280) - 640;
+            sprite.y = static_cast<float>(i * 7 % 720) - 360;
+            sprite.width = sprite.height = 8;
+            const auto color = hsv_to_rgba(angle, 1, 1);
+            sprite.tint[0] = static_cast<GLubyte>(color >> 24u);
+            sprite.tint[1] = static_cast<GLubyte>(color >> 16u);
+            sprite.tint[2] = static_cast<GLubyte>(color >> 8u);
+            velocities[i] = {std::cos(angle) * 60, std::sin(angle) * 60, std::sin(angle) * 4, 0};
+        }
+
+        camera camera;
+        camera
+                .set_viewport_ortho(1280, 720)
+                .set_position(0, 0);
+
+        textures.init();
+        textures.camera = camera;
+    }
+
+    void on_update(float dt) override {
+        for (uint32 i = 0; i < spriteCount; ++i) {
+            auto &sprite = sprites[i];
+            sprite.x = std::fmod(sprite.x + velocities[i].x * dt + 1920, 1280) - 640;
+            sprite.y = std::fmod(sprite.y + velocities[i].y * dt + 1080, 720) - 360;
+            sprite.rotation += velocities[i].z * dt;
+        }
+
+        glClearColor(0.5, 0.5, 0.5, 1);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        // Alternate between instanced and vertex-expanded submission, including the GPU's work;
+        // the vertex-expanded path draws the same quads without rotation or tint
+        const bool instanced = (frame / framesPerMode) % 2 == 0;
+        const auto start = clock_type::now();
+        textures.begin_batch();
+        if (instanced) {
+            textures.batch_draw_instances(texture, sprites);
+        } else {
+            for (const auto &sprite : sprites) {
+                textures.batch_draw_texture(texture, sprite.x, sprite.y, sprite.width, sprite.height);
+            }
+        }
+        textures.end_batch(false);
+        glFinish();
+        totalMs[instanced ? 0 : 1] += duration_cast<delta_type>(clock_type::now() - start).count();
+
+        const auto stats = textures.get_stats();
+        textures.reset_stats();
+        if (++frame % (framesPerMode * 2) == 0) {
+            const auto instancedMs = totalMs[0] / framesPerMode, expandedMs = totalMs[1] / framesPerMode;
+            std::cout << spriteCount << " sprites: instanced " << instancedMs << " ms/frame, vertex-expanded "
+                      << expandedMs << " ms/frame (" << expandedMs / std::max(instancedMs, 0.001f) << "x), "
+                      << stats.drawCalls << " draw calls ("
+                      << stats.get_flushes(gl::flush_reason::capacity) << " due to capacity)\n";
+            totalMs[0] = totalMs[1] = 0;
+        }
+    }
+};
+
+struct render_queue_test_screen final : basic_screen {
+    static constexpr uint32 textureCount = 4;
+    static constexpr uint32 spriteCount = 2000;
+
+    std::vector<std::shared_ptr<gl::texture>> sprites{};
+    gl::render_queue queue{};
+
+    gl::gl_texture_renderer textures{};
+    gl::gl_shape_renderer shapes{};
+
+    float time{0};
+    uint32 frame{0};
+
+    void on_attached(window *window) override {
+        basic_screen::on_attached(window);
+
+        for (uint32 i = 0; i < textureCount; ++i) {
+            buffer_pixmap<pixmap_format::rgba8> pixmap(16, 16);
+            pixmap.fill(hsv_to_rgba(static_cast<float>(i) / textureCount * 2 * pi<float>, 1, 1));
+            sprites.push_back(std::make_shared<gl::texture>(pixmap));
+        }
+
+        camera camera;
+        camera
+                .set_viewport_ortho(1280, 720)
+                .set_position(0, 0);
+
+        textures.init();
+        shapes.init();
+        textures.camera = shapes.camera = camera;
+    }
+
+    void on_update(float dt) override {
+        time += dt;
+
+        glClearColor(0.5, 0.5, 0.5, 1);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        // Textures, blend modes and shaders are interleaved on purpose; the queue groups them before drawing
+        for (uint32 i = 0; i < spriteCount; ++i) {
+            const auto angle = static_cast<float>(i) * 0.618f * 2 * pi<float>;
+            const auto radius = static_cast<float>(i % 300) + 20 * std::sin(time + angle);
+            const auto x = std::cos(angle) * radius, y = std::sin(angle) * radius;
+            const gl::render_state state{
+                    static_cast<uint8>(i % 2),
+                    i % 3 == 0 ? gl::render_blend::additive : gl::render_blend::alpha,
+                    i
+            };
+
+            if (i % 5 == 0) {
+                queue.draw_line(state, 0, 0, x, y, {0, 0, 0, 0.25f});
+            } else {
+                queue.draw_texture(state, sprites[i % textureCount], x, y, 8, 8);
+            }
+        }
+
+        const auto queueStats = queue.submit(textures, shapes);
+        const auto textureStats = textures.get_stats(), shapeStats = shapes.get_stats();
+        textures.reset_stats();
+        shapes.reset_stats();
+        if (++frame % 240 == 0) {
+            std::cout << "render_queue: " << queueStats.commands << " commands, " << queueStats.textures
+                      << " textures, " << queueStats.batches << " batches, " << queueStats.blendChanges
+                      << " blend changes; " << textureStats.drawCalls << " sprite and "
+                      << shapeStats.drawCalls << " line draw calls\n";
+        }
+    }
+};
+
+struct recording_test_screen final : basic_screen {
+    using clock_type = steady_clock;
+    using delta_type = duration<float, std::milli>;
+
+    static constexpr uint32 spriteCount = 200000;
+    static constexpr uint32 framesPerMode = 240;
+
+    std::shared_ptr<gl::texture> texture{};
+    thread_pool workers{};
+    std::vector<std::unique_ptr<gl::sprite_recorder>> recorders{};
+
+    gl::gl_texture_renderer textures{};
+
+    uint32 frame{0};
+    float time{0};
+    float totalMs[2]{};
+
+    void on_attached(window *window) override {
+        basic_screen::on_attached(window);
+
+        buffer_pixmap<pixmap_format::rgba8> pixmap(16, 16);
+        pixmap.fill(rgba8(255, 255, 255));
+        texture = std::make_shared<gl::texture>(pixmap);
+
+        const auto chunkSize = spriteCount / workers.get_thread_count() + 1;
+        for (std::size_t i = 0; i < workers.get_thread_count(); ++i) {
+            recorders.push_back(std::make_unique<gl::sprite_recorder>(chunkSize));
+        }
+
+        camera camera;
+        camera
+                .set_viewport_ortho(1280, 720)
+                .set_position(0, 0);
+
+        textures.init();
+        textures.camera = camera;
+        textures.culling = true;
+    }
+
+    void record(gl::sprite_recorder &recorder, uint32 begin, uint32 end) const {
+        recorder.clear();
+        recorder.drawTransform = mat3{std::cos(time), std::sin(time), 0, -std::sin(time), std::cos(time), 0, 0, 0, 1};
+        for (uint32 i = begin; i < end; ++i) {
+            const auto angle = static_cast<float>(i) * 0.618f * 2 * pi<float>;
+            const auto radius = static_cast<float>(i % 360) + 20 * std::sin(time + angle);
+            recorder.tint = {0.5f + 0.5f * std::cos(angle), 0.5f + 0.5f * std::sin(angle), 1, 1};
+            recorder.draw_texture(texture, std::cos(angle) * radius, std::sin(angle) * radius, 4, 4);
+        }
+    }
+
+    void on_update(float dt) override {
+        time += dt;
+
+        glClearColor(0.5, 0.5, 0.5, 1);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        // Alternate between recording on one thread and across the pool, excluding the GPU's work
+        const bool parallel = (frame / framesPerMode) % 2 == 0;
+        const auto start = clock_type::now();
+        const auto recorderCount = static_cast<uint32>(parallel ? recorders.size() : 1);
+        const auto chunkSize = (spriteCount + recorderCount - 1) / recorderCount;
+        if (parallel) {
+            std::vector<std::future<void>> pending;
+            for (uint32 i = 0; i < recorderCount; ++i) {
+                pending.push_back(workers.submit([this, i, chunkSize]() {
+                    record(*recorders[i], i * chunkSize, std::min(spriteCount, (i + 1) * chunkSize));
+                }));
+            }
+            for (auto &future : pending) future.get();
+        } else {
+            record(*recorders[0], 0, spriteCount);
+        }
+
+        textures.begin_batch();
+        for (uint32 i = 0; i < recorderCount; ++i) textures.batch_draw_recorded(*recorders[i]);
+        textures.end_batch(false);
+        totalMs[parallel ? 0 : 1] += duration_cast<delta_type>(clock_type::now() - start).count();
+
+        const auto stats = textures.get_stats();
+        textures.reset_stats();
+        if (++frame % (framesPerMode * 2) == 0) {
+            const auto parallelMs = totalMs[0] / framesPerMode, serialMs = totalMs[1] / framesPerMode;
+            std::cout << spriteCount << " sprites: recorded on " << recorders.size() << " threads in "
+                      << parallelMs << " ms/frame, on one thread in " << serialMs << " ms/frame ("
+                      << serialMs / std::max(parallelMs, 0.001f) << "x), " << stats.drawCalls << " draw calls, "
+                      << stats.culled << " sprites culled\n";
+            totalMs[0] = totalMs[1] = 0;
+        }
+    }
+};
+
+struct vertex_kernels_test_screen final : basic_screen {
+    using clock_type = steady_clock;
+    using delta_type = duration<float, std::milli>;
+
+    static constexpr uint32 spriteCount = 100000;
+    static constexpr uint32 lineCount = 20000;
+    static constexpr uint32 framesPerMode = 240;
+
+    std::shared_ptr<gl::texture> texture{};
+    std::vector<gl::sprite> sprites{};
+    std::vector<gl::line> lines{};
+    simd_level supported{simd_level::scalar};
+
+    gl::gl_texture_renderer textures{};
+    gl::gl_shape_renderer shapes{};
+
+    uint32 frame{0};
+    float time{0};
+    float totalMs[2]{};
+
+    // Records every sprite, so that the quads generated by each kernel can be compared
+    [[nodiscard]] std::vector<gl::detail::sprite_vertex> record_quads() const {
+        gl::sprite_recorder recorder(spriteCount);
+        recorder.drawTransform = mat3{std::cos(1.0f), std::sin(1.0f), 0, -std::sin(1.0f), std::cos(1.0f), 0, 3, 5, 1};
+        for (const auto &sprite : sprites) {
+            recorder.tint = vec4{sprite.tint[0], sprite.tint[1], sprite.tint[2], sprite.tint[3]} / 255.0f;
+            recorder.draw_texture(texture, sprite.x, sprite.y, sprite.width, sprite.height,
+                                  sprite.u1, sprite.v1, sprite.u2, sprite.v2);
+        }
+        const auto vertices = recorder.get_vertices();
+        return {vertices.begin(), vertices.end()};
+    }
+
+    void on_attached(window *window) override {
+        basic_screen::on_attached(window);
+
+        buffer_pixmap<pixmap_format::rgba8> pixmap(16, 16);
+        pixmap.fill(rgba8(255, 255, 255));
+        texture = std::make_shared<gl::texture>(pixmap);
+
+        sprites.resize(spriteCount);
+        for (uint32 i = 0; i < spriteCount; ++i) {
+            const auto angle = static_cast<float>(i) * 0.618f * 2 * pi<float>;
+            auto &sprite = sprites[i];
+            sprite.x = static_cast<float>(i % 1280) - 640;
+            sprite.y = static_cast<float>(i * 7 % 720) - 360;
+            sprite.width = sprite.height = static_cast<float>(4 + i % 5);
+            sprite.u1 = sprite.v1 = 0.25f;
+            sprite.u2 = sprite.v2 = 0.75f;
+            const auto color = hsv_to_rgba(angle, 1, 1);
+            sprite.tint[0] = static_cast<GLubyte>(color >> 24u);
+            sprite.tint[1] = static_cast<GLubyte>(color >> 16u);
+            sprite.tint[2] = static_cast<GLubyte>(color >> 8u);
+            sprite.tint[3] = static_cast<GLubyte>(128 + i % 128);
+        }
+
+        lines.resize(lineCount);
+        for (uint32 i = 0; i < lineCount; ++i) {
+            const auto angle = static_cast<float>(i) * 0.618f * 2 * pi<float>;
+            const auto radius = static_cast<float>(i % 360);
+            lines[i] = {0, 0, std::cos(angle) * radius, std::sin(angle) * radius, {0, 0, 0, 0.1f}};
+        }
+
+        // Every kernel must generate the same quads as the scalar reference, bit for bit
+        supported = get_supported_simd_level();
+        set_simd_level(simd_level::scalar);
+        const auto reference = record_quads();
+        for (const auto level : {simd_level::sse2, simd_level::avx2, simd_level::neon}) {
+            try {
+                set_simd_level(level);
+            } catch (const std::invalid_argument &) {
+                continue;
+            }
+
+            const auto quads = record_quads();
+            const auto matches = quads.size() == reference.size()
+                                 && std::memcmp(quads.data(), reference.data(),
+                                                reference.size() * sizeof(gl::detail::sprite_vertex)) == 0;
+            std::cout << get_simd_level_name(level) << " quads " << (matches ? "match" : "DO NOT match")
+                      << " the scalar quads\n";
+        }
+        set_simd_level(supported);
+
+        camera camera;
+        camera
+                .set_viewport_ortho(1280, 720)
+                .set_position(0, 0);
+
+        textures.init();
+        shapes.init();
+        textures.camera = shapes.camera = camera;
+    }
+
+    void on_detached(window *window) override {
+        basic_screen::on_detached(window);
+        set_simd_level(supported);
+    }
+
+    void on_update(float dt) override {
+        time += dt;
+
+        glClearColor(0.5, 0.5, 0.5, 1);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        // Alternate between the scalar and the vectorized kernels, excluding the GPU's work
+        const bool vectorized = (frame / framesPerMode) % 2 == 0;
+        set_simd_level(vectorized ? supported : simd_level::scalar);
+        const auto rotation = mat3{std::cos(time), std::sin(time), 0, -std::sin(time), std::cos(time), 0, 0, 0, 1};
+
+        const auto start = clock_type::now();
+        textures.begin_batch();
+        textures.drawTransform = rotation;
+        textures.batch_draw_regions(texture, sprites);
+        textures.end_batch(false);
+        shapes.begin_batch();
+        shapes.drawTransform = rotation;
+        shapes.batch_draw_lines(lines);
+        shapes.end_batch(false);
+        totalMs[vectorized ? 0 : 1] += duration_cast<delta_type>(clock_type::now() - start).count();
+
+        if (++frame % (framesPerMode * 2) == 0) {
+            const auto vectorizedMs = totalMs[0] / framesPerMode, scalarMs = totalMs[1] / framesPerMode;
+            std::cout << spriteCount << " sprites and " << lineCount << " lines: "
+                      << get_simd_level_name(supported) << " " << vectorizedMs << " ms/frame, scalar "
+                      << scalarMs << " ms/frame (" << scalarMs / std::max(vectorizedMs, 0.001f) << "x)\n";
+            totalMs[0] = totalMs[1] = 0;
+        }
+    }
+};
+
+struct static_batch_test_screen final : basic_screen {
+    static constexpr uint32 tiles = 256;
+    static constexpr float tileSize = 32;
+
+    std::shared_ptr<gl::texture> texture{};
+    gl::static_batch world{};
+
+    gl::gl_texture_renderer textures{};
+    gl::gl_shape_renderer shapes{};
+    ::musubi::camera camera{};
+
+    float time{0};
+    uint32 frame{0};
+
+    void on_attached(window *window) override {
+        basic_screen::on_attached(window);
+
+        buffer_pixmap<pixmap_format::rgba8> pixmap(16, 16);
+        pixmap.fill(rgba8(255, 255, 255));
+        texture = std::make_shared<gl::texture>(pixmap);
+
+        // The level is recorded and uploaded once, and drawn every frame without touching its vertices
+        for (uint32 y = 0; y < tiles; ++y) {
+            for (uint32 x = 0; x < tiles; ++x) {
+                const auto angle = static_cast<float>(x * 7 + y * 13) * 0.1f;
+                world.tint = {0.5f + 0.5f * std::cos(angle), 0.5f + 0.5f * std::sin(angle), 1, 1};
+                world.draw_texture(texture, static_cast<float>(x) * tileSize, static_cast<float>(y) * tileSize,
+                                   tileSize - 2, tileSize - 2);
+            }
+        }
+        world.color = {0, 0, 0, 1};
+        for (uint32 i = 0; i < tiles; i += 16) {
+            world.draw_rectangle(static_cast<float>(i) * tileSize, static_cast<float>(i) * tileSize,
+                                 16 * tileSize, 16 * tileSize);
+        }
+        world.upload();
+
+        camera.set_viewport_ortho(1280, 720);
+
+        textures.init();
+        shapes.init();
+        textures.culling = shapes.culling = true;
+    }
+
+    void on_update(float dt) override {
+        time += dt;
+
+        glClearColor(0.5, 0.5, 0.5, 1);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        const auto extent = tiles * tileSize / 2;
+        camera.set_position(extent + std::cos(time * 0.2f) * extent, extent + std::sin(time * 0.3f) * extent);
+        textures.camera = shapes.camera = camera;
+
+        textures.draw_static(world);
+        shapes.draw_static(world);
+
+        const auto stats = textures.get_stats();
+        textures.reset_stats();
+        shapes.reset_stats();
+        if (++frame % 240 == 0) {
+            std::cout << world.get_sprite_count() << " static sprites: " << stats.drawCalls << " draw calls, "
+                      << stats.get_flushes(gl::flush_reason::retained) << " retained, "
+                      << stats.culled << " culled\n";
+        }
+    }
+};
+
+struct pixmap_ops_test_screen final : basic_screen {
+    using clock_type = steady_clock;
+    using delta_type = duration<float, std::milli>;
+
+    template<typename F>
+    static float time_ms(F &&f, uint32 iterations = 20) {
+        const auto start = clock_type::now();
+        for (uint32 i = 0; i < iterations; ++i) f();
+        return duration_cast<delta_type>(clock_type::now() - start).count() / iterations;
+    }
+
+    void on_attached(window *window) override {
+        basic_screen::on_attached(window);
+
+        buffer_pixmap<pixmap_format::rgba8> target(1920, 1080, 64);
+        buffer_pixmap<pixmap_format::rgba8> overlay(1920, 1080, 64);
+        buffer_pixmap<pixmap_format::rgb8> opaque(1920, 1080);
+        overlay.fill(rgba8(255, 0, 0, 128));
+        opaque.fill(rgb8(0, 0, 255));
+
+        const auto supported = get_supported_simd_level();
+        for (const auto level : {simd_level::scalar, simd_level::sse2, simd_level::avx2, simd_level::neon}) {
+            try {
+                set_simd_level(level);
+            } catch (const std::invalid_argument &) {
+                continue;
+            }
+
+            std::cout << get_simd_level_name(level) << ":\n"
+                      << "  fill         " << time_ms([&]() { target.fill(rgba8(0, 255, 0)); }) << " ms\n"
+                      << "  blit (blend) " << time_ms([&]() { target.blit(overlay, 0, 0, blend_mode::source_over); })
+                      << " ms\n"
+                      << "  rgb8->rgba8  " << time_ms([&]() { target.blit(opaque, 0, 0); }) << " ms\n"
+                      << "  rgba8->r8    " << time_ms([&]() { (void) convert_pixmap<pixmap_format::r8>(target); })
+                      << " ms\n"
+                      << "  rgba8->565   " << time_ms([&]() { (void) convert_pixmap<pixmap_format::rgb565>(target); })
+                      << " ms\n";
+        }
+        set_simd_level(supported);
+
+        // Transient pixmaps of recurring sizes should only allocate during the first iteration
+        pixmap_pool pool;
+        for (uint32 frame = 0; frame < 60; ++frame) {
+            buffer_pixmap<pixmap_format::rgba8> glyph(32, 32, pool), thumbnail(128, 72, pool);
+            glyph.fill(rgba8(255, 255, 255, 0));
+            thumbnail.blit(pixmap_view(overlay, 0, 0, 128, 72), 0, 0);
+        }
+        const auto stats = pool.get_stats();
+        std::cout << "pixmap_pool: " << stats.allocations << " allocations, "
+                  << stats.reuses << " reuses, " << stats.cachedBytes << " bytes cached\n";
+    }
+
+    void on_update(float dt) override {
+        glClearColor(0.5, 0.5, 0.5, 1);
+        glClear(GL_COLOR_BUFFER_BIT);
+    }
+};
+
 struct asset_test_screen : public basic_screen {
     std::unique_ptr<asset_registry> assets;
 
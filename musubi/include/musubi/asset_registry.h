@@ -5,6 +5,7 @@
 #ifndef MUSUBI_ASSET_REGISTRY_H
 #define MUSUBI_ASSET_REGISTRY_H
 
+#include "musubi/common.h"
 #include "musubi/input.h"
 
 #include <nlohmann/json.hpp>
@@ -17,6 +18,7 @@
 #include <memory>
 #include <optional>
 #include <unordered_map>
+#include <vector>
 
 namespace musubi {
     using std::byte;
@@ -28,6 +30,9 @@ namespace musubi {
         /// @details Asset packs can only be loaded into memory in full,
         /// as not all archive formats support random access.
         /// Loaded contents ("items") can be retrieved via @ref get_item().
+        ///
+        /// If patch packs were registered for this pack, each item is read from
+        /// the highest-priority layer that contains it (see @ref asset_registry::load_pack()).
         /// @see pack_item
         struct mpack final {
         public:
@@ -74,8 +79,25 @@ namespace musubi {
             std::optional<std::reference_wrapper<const pack_item>>
             operator[](std::string_view name) const noexcept(noexcept(get_item(name)));
 
+            /// @details Retrieves the name of the registered pack this pack was loaded from.
+            /// @return this pack's name
+            [[nodiscard]] const std::string &get_name() const;
+
+            /// @details Retrieves the name of the pack layer the resource with the specified name was read from.
+            /// @param name the resource name
+            /// @return the name of the base or patch pack providing the resource, or nullopt
+            [[nodiscard]] std::optional<std::string_view> get_origin(std::string_view name) const;
+
         private:
+            /// The layer an item was read from; the sequence distinguishes re-registered versions of a pack.
+            struct item_origin {
+                std::string packName;
+                uint64 sequence;
+            };
+
+            std::string packName;
             std::map<std::string, pack_item, std::less<>> contents;
+            std::map<std::string, item_origin, std::less<>> origins;
         };
 
         LIBMUSUBI_DELCP(asset_registry)
@@ -83,10 +105,27 @@ namespace musubi {
         /// @brief Constructs an asset registry, searching the specified search paths for asset packs.
         /// @details If any discovered pack does not explicitly specify a pack name in its pack.json file,
         /// the pack filename is used instead.
+        ///
+        /// Packs within a directory are registered in lexicographical order of their paths,
+        /// so that the layering of equal-priority patches does not depend on the file system.
         /// @param paths the paths to recursively search for asset packs
         /// @return the newly-constructed asset registry
+        /// @see register_pack()
         static std::unique_ptr<asset_registry> from_paths(std::initializer_list<std::filesystem::path> paths);
 
+        /// @brief Registers a single asset pack file.
+        /// @details
+        /// A pack whose pack.json specifies a `base` pack name is registered as a _patch pack_.
+        /// Patch packs only contain changed or added entries; they are layered over their base pack
+        /// when it is loaded, in ascending order of their optional integral `priority` (0 by default).
+        /// Patches with equal priority are layered in registration order.
+        ///
+        /// If a pack with the same name is already registered, it is replaced, so that a newer version of a patch
+        /// can be registered over an older one; loaded packs pick up the replacement through @ref refresh_pack().
+        /// @param packPath the path to the pack file
+        /// @return whether the pack was registered
+        bool register_pack(const std::filesystem::path &packPath);
+
         /// @details Move constructor; `other` becomes invalid.
         /// @param[in,out] other the registry to move from
         asset_registry(asset_registry &&other) noexcept;
@@ -100,15 +139,39 @@ namespace musubi {
         ~asset_registry();
 
         /// @brief Loads the specified asset pack into memory.
+        /// @details
+        /// All registered patch packs for the specified pack are merged into a single index,
+        /// and each item is read only from the highest-priority layer that contains it;
+        /// overridden entries in lower layers are skipped without being decompressed.
+        ///
+        /// Loading a patch pack by name loads only the entries it contains.
         /// @param packName the asset pack name, as loaded by @ref asset_registry::from_paths()
+        /// @throw resource_read_error if no pack with the specified name was registered,
+        /// or if any of the pack's items could not be read
         std::unique_ptr<mpack> load_pack(const std::string &packName);
 
+        /// @brief Updates a loaded asset pack to reflect the currently registered patch packs.
+        /// @details
+        /// Only items whose resolved layer has changed since the pack was loaded (e.g. because a patch pack
+        /// was registered via @ref register_pack()) are read again; all other items are left untouched.
+        /// If any item cannot be read, the pack is not modified.
+        /// @param pack the pack to update
+        /// @return the number of items that were read again
+        /// @throw resource_read_error if the pack is no longer registered, or if any changed item could not be read
+        std::size_t refresh_pack(mpack &pack);
+
     private:
         asset_registry() noexcept;
 
         struct pack_data;
+        struct item_source;
+
+        [[nodiscard]] std::vector<const pack_data *> get_layers(const std::string &packName) const;
+
+        [[nodiscard]] std::map<std::string, item_source> resolve_index(const std::string &packName) const;
 
         std::unordered_map<std::string, std::unique_ptr<pack_data>> packs;
+        uint64 registered{0};
     };
 }
 
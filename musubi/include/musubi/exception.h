@@ -41,6 +41,12 @@ namespace musubi {
         using application_error::application_error;
     };
 
+    /// @brief An @ref application_error indicating that an attempt to write a resource to disk has failed.
+    class resource_write_error : public application_error {
+    public:
+        using application_error::application_error;
+    };
+
     /// @brief A @ref resource_read_error indicating that an attempt to read from an archive on disk has failed.
     /// @details This may occur when reading an invalid, modified or corrupt @ref asset_registry::mpack "asset pack".
     class archive_read_error : public resource_read_error {
@@ -0,0 +1,89 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#ifndef MUSUBI_FRAME_TASK_QUEUE_H
+#define MUSUBI_FRAME_TASK_QUEUE_H
+
+#include "musubi/common.h"
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+namespace musubi {
+    /// @brief A queue of tasks to be executed on a single owning thread, a limited amount at a time.
+    /// @details
+    /// Tasks can be posted from any thread, and are executed in submission order
+    /// whenever the owning thread calls @ref run().
+    /// Each @ref window owns such a queue and runs it once per tick, with its graphics context current;
+    /// this is where work that must be performed on the rendering thread
+    /// (such as creating OpenGL objects) should be posted.
+    ///
+    /// Running a queue with a time budget spreads large amounts of work over multiple ticks,
+    /// which avoids stalling a single frame.
+    class frame_task_queue final {
+    public:
+        /// @brief The clock used to measure task execution time.
+        using clock_type = std::chrono::steady_clock;
+
+        LIBMUSUBI_DELCP(frame_task_queue)
+
+        /// @brief Constructs an empty task queue.
+        frame_task_queue() noexcept;
+
+        /// @brief Destroys this queue, discarding all pending tasks.
+        ~frame_task_queue() noexcept;
+
+        /// @brief Enqueues a task for execution on the owning thread.
+        /// @details This function is thread-safe.
+        /// @param[in] task the task to execute
+        void post(std::function<void()> task);
+
+        /// @brief Enqueues a callable for execution on the owning thread, returning a future for its result.
+        /// @details This function is thread-safe.
+        /// @tparam Function the callable type
+        /// @param[in] function the callable to execute
+        /// @return a future that receives the result of the callable, or the exception it threw
+        template<typename Function>
+        auto submit(Function &&function) -> std::future<std::invoke_result_t<std::decay_t<Function>>> {
+            using result_type = std::invoke_result_t<std::decay_t<Function>>;
+            auto task = std::make_shared<std::packaged_task<result_type()>>(std::forward<Function>(function));
+            auto future = task->get_future();
+            post([task]() { (*task)(); });
+            return future;
+        }
+
+        /// @brief Executes pending tasks on the calling thread until the specified time budget is exhausted.
+        /// @details
+        /// At least one task is executed if the queue is not empty, even if it exceeds the budget;
+        /// tasks posted while running are not executed until the next call.
+        /// @param[in] budget the maximum amount of time to spend executing tasks
+        /// @return the number of executed tasks
+        std::size_t run(clock_type::duration budget);
+
+        /// @brief Executes all pending tasks on the calling thread.
+        /// @return the number of executed tasks
+        std::size_t run_all();
+
+        /// @details Retrieves the number of pending tasks.
+        /// @return the number of pending tasks
+        [[nodiscard]] std::size_t size() const;
+
+        /// @details Checks if this queue has no pending tasks.
+        /// @return whether this queue is empty
+        [[nodiscard]] bool empty() const;
+
+    private:
+        std::size_t run_until(std::size_t limit, clock_type::time_point deadline);
+
+        mutable std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+}
+
+#endif //MUSUBI_FRAME_TASK_QUEUE_H
@@ -0,0 +1,58 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#ifndef MUSUBI_GL_BATCH_STATS_H
+#define MUSUBI_GL_BATCH_STATS_H
+
+#include "musubi/common.h"
+
+#include <array>
+#include <cstddef>
+
+namespace musubi::gl {
+    /// @brief The reason a batch renderer submitted its pending draw operations.
+    enum class flush_reason : uint8 {
+        explicit_flush, ///< The batch was ended.
+        texture_change, ///< All sampler slots were in use, and another texture was drawn.
+        capacity, ///< The maximum batch size was reached, or the reserved vertex memory was full.
+        mode_change, ///< Quads and sprite instances were interleaved.
+        retained, ///< A @ref static_batch was drawn, or pending operations were drawn ahead of one.
+    };
+
+    /// @brief The number of @ref flush_reason "flush reasons".
+    constexpr std::size_t FLUSH_REASON_COUNT = 5;
+
+    /// @brief Draw statistics of a batch renderer, accumulated until they are reset.
+    /// @details
+    /// Renderers accumulate their statistics until `reset_stats()` is called,
+    /// which is typically done once per frame, after querying them.
+    struct batch_stats final {
+        uint32 drawCalls{0}; ///< @brief The number of draw calls submitted.
+        uint64 vertices{0}; ///< @brief The number of vertices drawn, including vertices expanded from instances.
+        uint64 primitives{0}; ///< @brief The number of primitives (quads, sprite instances or lines) drawn.
+        uint64 culled{0}; ///< @brief The number of primitives discarded by view culling, and therefore not drawn.
+        /// @brief The number of draw calls submitted for each reason, indexed by the value of its @ref flush_reason.
+        std::array<uint32, FLUSH_REASON_COUNT> flushes{};
+
+        /// @details Retrieves the number of draw calls submitted for the specified reason.
+        /// @param[in] reason the flush reason
+        /// @return the number of draw calls
+        [[nodiscard]] constexpr uint32 get_flushes(flush_reason reason) const noexcept {
+            return flushes[static_cast<std::size_t>(reason)];
+        }
+
+        /// @details Records a draw call.
+        /// @param[in] reason the reason the draw call was submitted
+        /// @param[in] primitiveCount the number of primitives drawn
+        /// @param[in] vertexCount the number of vertices drawn
+        constexpr void record(flush_reason reason, uint64 primitiveCount, uint64 vertexCount) noexcept {
+            ++drawCalls;
+            ++flushes[static_cast<std::size_t>(reason)];
+            primitives += primitiveCount;
+            vertices += vertexCount;
+        }
+    };
+}
+
+#endif //MUSUBI_GL_BATCH_STATS_H
@@ -0,0 +1,122 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#ifndef MUSUBI_GL_CULLING_H
+#define MUSUBI_GL_CULLING_H
+
+#include "musubi/camera.h"
+
+#include <epoxy/gl.h>
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace musubi::gl {
+    /// @brief An axis-aligned 2D bounding box.
+    struct bounding_box final {
+        GLfloat minX{std::numeric_limits<GLfloat>::infinity()}; ///< @brief The left edge.
+        GLfloat minY{std::numeric_limits<GLfloat>::infinity()}; ///< @brief The bottom edge.
+        GLfloat maxX{-std::numeric_limits<GLfloat>::infinity()}; ///< @brief The right edge.
+        GLfloat maxY{-std::numeric_limits<GLfloat>::infinity()}; ///< @brief The top edge.
+
+        /// @details Checks if this box contains no points, i.e. has not been extended yet.
+        /// @return whether this box is empty
+        [[nodiscard]] constexpr bool empty() const noexcept { return minX > maxX || minY > maxY; }
+
+        /// @brief Extends this box to contain a point.
+        /// @param[in] x, y the point
+        constexpr void extend(GLfloat x, GLfloat y) noexcept {
+            minX = std::min(minX, x);
+            minY = std::min(minY, y);
+            maxX = std::max(maxX, x);
+            maxY = std::max(maxY, y);
+        }
+    };
+
+    /// @brief A conservative visibility test of 2D bounding boxes against a renderer's view volume.
+    /// @details
+    /// Boxes are specified in model space, i.e. before a renderer's `transform` is applied,
+    /// and are transformed into clip space by the camera's view-projection and the transform.
+    /// A box is only rejected if all of its corners lie outside the same side of the viewport,
+    /// so boxes straddling a corner of the viewport may be accepted although they are not visible.
+    /// The near and far planes are not tested.
+    struct view_culler final {
+        /// @brief The matrix transforming model coordinates into clip coordinates.
+        glm::mat4 matrix{1.0f};
+
+        /// @brief Constructs a culler for the default view volume, [-1, 1] on both axes.
+        view_culler() noexcept = default;
+
+        /// @brief Constructs a culler for the view volume of a camera and a model transformation.
+        /// @param[in] camera the camera
+        /// @param[in] transform the model transformation
+        view_culler(const camera &camera, const glm::mat4 &transform) noexcept
+                : matrix(camera.projection * camera.view * transform) {}
+
+        /// @details Tests if an axis-aligned bounding box may be visible.
+        /// @param[in] minX, minY the lower left corner of the box, in model space
+        /// @param[in] maxX, maxY the upper right corner of the box, in model space
+        /// @return false if the box is certainly outside the view volume, true otherwise
+        [[nodiscard]] bool is_visible(GLfloat minX, GLfloat minY, GLfloat maxX, GLfloat maxY) const noexcept {
+            // Transform one corner and the two edges, rather than each corner
+            const glm::vec4 origin{matrix * glm::vec4{minX, minY, 0, 1}};
+            const glm::vec4 right{matrix[0] * (maxX - minX)}, up{matrix[1] * (maxY - minY)};
+            const glm::vec4 corners[4]{origin, origin + right, origin + up, origin + right + up};
+
+            bool left = true, rightOf = true, below = true, above = true;
+            for (const auto &corner : corners) {
+                left = left && corner.x < -corner.w;
+                rightOf = rightOf && corner.x > corner.w;
+                below = below && corner.y < -corner.w;
+                above = above && corner.y > corner.w;
+            }
+            return !(left || rightOf || below || above);
+        }
+
+        /// @details Tests if a bounding box may be visible; empty boxes are never visible.
+        /// @param[in] box the box, in model space
+        /// @return false if the box is empty or certainly outside the view volume, true otherwise
+        [[nodiscard]] bool is_visible(const bounding_box &box) const noexcept {
+            return !box.empty() && is_visible(box.minX, box.minY, box.maxX, box.maxY);
+        }
+    };
+
+    /// @brief A @ref view_culler that is rebuilt whenever the camera or model transformation it was built from changes.
+    /// @details
+    /// Renderers keep one of these per batch, so that changes to their camera or transformation between draw
+    /// operations are honoured without recomputing the view-projection for every primitive.
+    class view_culler_cache final {
+    public:
+        /// @brief Rebuilds the culler if it has been invalidated, or if the camera or transformation changed.
+        /// @param[in] camera the camera
+        /// @param[in] transform the model transformation
+        /// @return the up-to-date culler
+        const view_culler &update(const camera &camera, const glm::mat4 &transform) noexcept {
+            if (!valid || camera.projection != projection || camera.view != view || transform != model) {
+                projection = camera.projection;
+                view = camera.view;
+                model = transform;
+                culler = view_culler(camera, transform);
+                valid = true;
+            }
+            return culler;
+        }
+
+        /// @brief Forces the culler to be rebuilt on the next call to @ref update.
+        void invalidate() noexcept { valid = false; }
+
+        /// @details Retrieves the culler as of the last call to @ref update.
+        /// @return the culler
+        [[nodiscard]] const view_culler &get() const noexcept { return culler; }
+
+    private:
+        view_culler culler{};
+        glm::mat4 projection{1.0f}, view{1.0f}, model{1.0f};
+        bool valid{false};
+    };
+}
+
+#endif //MUSUBI_GL_CULLING_H
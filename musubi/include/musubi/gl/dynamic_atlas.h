@@ -0,0 +1,139 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#ifndef MUSUBI_GL_DYNAMIC_ATLAS_H
+#define MUSUBI_GL_DYNAMIC_ATLAS_H
+
+#include "musubi/common.h"
+#include "musubi/gl/textures.h"
+#include "musubi/pixmap.h"
+
+#include <epoxy/gl.h>
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+
+namespace musubi::gl {
+    /// @brief Occupancy statistics of a @ref dynamic_atlas.
+    struct dynamic_atlas_stats final {
+        std::size_t pages{0}; ///< @brief The number of allocated atlas pages.
+        std::size_t entries{0}; ///< @brief The number of entries currently stored in the atlas.
+        uint64 usedArea{0}; ///< @brief The number of pixels covered by entries, including padding.
+        uint64 capacity{0}; ///< @brief The number of pixels of all allocated pages.
+
+        uint64 insertions{0}; ///< @brief The number of successful insertions.
+        uint64 evictions{0}; ///< @brief The number of entries evicted to make room for insertions.
+        uint64 defragmentations{0}; ///< @brief The number of calls to dynamic_atlas::defragment().
+    };
+
+    /// @brief A texture atlas that packs pixmaps at runtime.
+    /// @details
+    /// Pixmaps inserted into the atlas (such as generated icons, avatars, or glyphs) are packed into
+    /// a small number of equally-sized texture _pages_ by a shelf allocator, so that they can be drawn
+    /// in the same batch. Only the rectangle of an inserted pixmap is uploaded.
+    ///
+    /// Entries are identified by the IDs returned from @ref insert(); their @ref texture_region "regions"
+    /// are retrieved through @ref get_region(), which also marks them as used in the current frame.
+    /// When the atlas is full, inserting evicts the least recently used entries that have not been used
+    /// in the current frame (see @ref next_frame()), so that regions drawn in the current frame stay valid.
+    ///
+    /// Repeated insertion and eviction fragments pages; @ref defragment() repacks all entries,
+    /// which moves their regions. Cached regions are valid as long as @ref get_generation() does not change.
+    ///
+    /// The atlas keeps a CPU-side copy of every page, which is used to repack entries without reading back
+    /// textures. Atlases must only be used on the thread owning the OpenGL context.
+    class dynamic_atlas final {
+    private:
+        LIBMUSUBI_PIMPL
+
+    public:
+        /// @brief The type of entry identifiers; IDs are never reused by the same atlas.
+        using entry_id = uint64;
+
+        LIBMUSUBI_DELCP(dynamic_atlas)
+
+        /// @brief Constructs an empty atlas.
+        /// @details Pages are created on demand; this does not allocate any textures.
+        /// @param[in] pageSize the width and height of each page, in pixels
+        /// @param[in] maxPages the maximum number of pages
+        /// @param[in] format the format of all pixmaps inserted into the atlas
+        /// @param[in] padding the number of transparent pixels kept between entries, to avoid filtering bleed
+        /// @param[in] internalFormat the OpenGL internal image format for the pages
+        /// @throw std::invalid_argument if the page size or maximum number of pages is zero
+        explicit dynamic_atlas(uint32 pageSize = 1024, std::size_t maxPages = 4,
+                               pixmap_format format = pixmap_format::rgba8, uint32 padding = 1,
+                               GLenum internalFormat = GL_RGBA8);
+
+        /// @brief Destroys this atlas and its pages.
+        ~dynamic_atlas() noexcept;
+
+        /// @brief Packs a pixmap into the atlas, and uploads it to its page.
+        /// @details
+        /// If there is no room for the pixmap, a new page is created; if the maximum number of pages is reached,
+        /// entries not used in the current frame are evicted in least-recently-used order until the pixmap fits.
+        /// @param[in] source the pixmap to insert
+        /// @return the ID of the new entry, or an empty optional if there is no room for the pixmap
+        /// even after evicting all evictable entries
+        /// @throw std::invalid_argument if the format of `source` differs from the atlas format,
+        /// if `source` is empty, or if it does not fit into a page
+        std::optional<entry_id> insert(const pixmap &source);
+
+        /// @details Checks if an entry is stored in the atlas, i.e. has not been erased or evicted.
+        /// @param[in] id the entry ID
+        /// @return whether the atlas contains the entry
+        [[nodiscard]] bool contains(entry_id id) const;
+
+        /// @brief Retrieves the texture region of an entry, and marks it as used in the current frame.
+        /// @param[in] id the entry ID
+        /// @return the region of the entry's page that contains its pixels
+        /// @throw std::out_of_range if the atlas does not contain the entry
+        [[nodiscard]] texture_region get_region(entry_id id);
+
+        /// @brief Removes an entry from the atlas, freeing its space.
+        /// @param[in] id the entry ID
+        /// @return whether the atlas contained the entry
+        bool erase(entry_id id);
+
+        /// @brief Begins a new frame.
+        /// @details Entries used in previous frames become evictable.
+        void next_frame() noexcept;
+
+        /// @brief Repacks all entries, reclaiming fragmented space and releasing unused pages.
+        /// @details
+        /// All pages are re-uploaded, and the regions of most entries move;
+        /// entries that no longer fit (which is rare) are evicted.
+        /// This should not be called between retrieving regions and drawing them.
+        void defragment();
+
+        /// @details
+        /// Retrieves the generation of this atlas, which changes whenever existing entries move or are evicted.
+        /// @return the current generation
+        [[nodiscard]] uint64 get_generation() const noexcept;
+
+        /// @details Retrieves the number of allocated pages.
+        /// @return the number of pages
+        [[nodiscard]] std::size_t get_page_count() const noexcept;
+
+        /// @details Retrieves the texture of a page.
+        /// @param[in] index the page index
+        /// @return the page texture
+        /// @throw std::out_of_range if the index is not less than @ref get_page_count()
+        [[nodiscard]] std::shared_ptr<texture> get_page(std::size_t index) const;
+
+        /// @details Retrieves the width and height of each page, in pixels.
+        /// @return the page size
+        [[nodiscard]] uint32 get_page_size() const noexcept;
+
+        /// @details Retrieves the format of pixmaps stored in this atlas.
+        /// @return the atlas format
+        [[nodiscard]] pixmap_format get_format() const noexcept;
+
+        /// @details Retrieves the occupancy statistics of this atlas.
+        /// @return a snapshot of this atlas's statistics
+        [[nodiscard]] dynamic_atlas_stats get_stats() const;
+    };
+}
+
+#endif //MUSUBI_GL_DYNAMIC_ATLAS_H
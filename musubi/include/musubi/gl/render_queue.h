@@ -0,0 +1,123 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#ifndef MUSUBI_GL_RENDER_QUEUE_H
+#define MUSUBI_GL_RENDER_QUEUE_H
+
+#include "musubi/common.h"
+#include "musubi/gl/shapes.h"
+#include "musubi/gl/textures.h"
+
+#include <epoxy/gl.h>
+#include <glm/mat3x3.hpp>
+#include <glm/vec4.hpp>
+
+#include <cstddef>
+#include <memory>
+
+namespace musubi::gl {
+    /// @brief The blending applied to a command of a @ref render_queue.
+    enum class render_blend : uint8 {
+        opaque, ///< No blending.
+        alpha, ///< Source-over alpha blending.
+        additive, ///< Additive blending, weighted by source alpha.
+    };
+
+    /// @brief The ordering state of a command of a @ref render_queue.
+    struct render_state final {
+        /// @brief The layer of the command; layers are drawn in ascending order.
+        uint8 layer{0};
+        /// @brief The blending of the command.
+        render_blend blend{render_blend::alpha};
+        /// @brief The order of the command among commands with otherwise equal state; lower depths are drawn first.
+        uint32 depth{0};
+    };
+
+    /// @brief Statistics of the last submission of a @ref render_queue.
+    struct render_queue_stats final {
+        std::size_t commands{0}; ///< @brief The number of submitted commands.
+        std::size_t batches{0}; ///< @brief The number of renderer batches the commands were merged into.
+        std::size_t blendChanges{0}; ///< @brief The number of blend state changes.
+        std::size_t textures{0}; ///< @brief The number of distinct textures drawn.
+    };
+
+    /// @brief A deferred queue of draw commands, which are sorted to minimize state changes before drawing.
+    /// @details
+    /// Screens record commands into the queue in any order, each with a @ref render_state.
+    /// On @ref submit(), the commands are sorted by a 64-bit key (from most to least significant:
+    /// layer, shader, blend, texture and depth) through a radix sort, and drawn through the existing renderers,
+    /// merging runs of commands that share a shader and blend state into a single batch.
+    ///
+    /// Commands within the same layer are reordered freely, so draws whose relative order matters
+    /// (e.g. overlapping translucent sprites) must be separated by layer or ordered through their depth.
+    ///
+    /// Commands keep their textures alive until the queue is submitted or cleared.
+    /// Queues must only be submitted on the thread owning the OpenGL context.
+    class render_queue final {
+    private:
+        LIBMUSUBI_PIMPL
+
+    public:
+        LIBMUSUBI_DELCP(render_queue)
+
+        /// @brief Constructs an empty render queue.
+        render_queue();
+
+        /// @brief Destroys this queue and its pending commands.
+        ~render_queue() noexcept;
+
+        /// @brief Records a command drawing a texture.
+        /// @param[in] state the ordering state of the command
+        /// @param[in] texture the texture to draw
+        /// @param[in] x, y the position at which to draw the texture
+        /// @param[in] width, height the desired size of the texture
+        /// @param[in] transform the per-draw transformation (see @ref gl_texture_renderer::drawTransform)
+        /// @param[in] tint the color the texture is multiplied with
+        /// @throw std::invalid_argument if the texture pointer is empty, or its content is not a valid texture
+        void draw_texture(const render_state &state, const std::shared_ptr<texture> &texture,
+                          GLfloat x, GLfloat y, GLfloat width, GLfloat height,
+                          const glm::mat3 &transform = glm::mat3{1.0f}, const glm::vec4 &tint = {1, 1, 1, 1});
+
+        /// @brief Records a command drawing a texture region.
+        /// @param[in] state the ordering state of the command
+        /// @param[in] region the texture region to draw
+        /// @param[in] x, y the position at which to draw the texture region
+        /// @param[in] width, height the dimensions of the texture region
+        /// @param[in] transform the per-draw transformation (see @ref gl_texture_renderer::drawTransform)
+        /// @param[in] tint the color the texture region is multiplied with
+        /// @throw std::invalid_argument if the texture region refers to a deleted texture
+        void draw_region(const render_state &state, const texture_region &region,
+                         GLfloat x, GLfloat y, GLfloat width, GLfloat height,
+                         const glm::mat3 &transform = glm::mat3{1.0f}, const glm::vec4 &tint = {1, 1, 1, 1});
+
+        /// @brief Records a command drawing a line.
+        /// @param[in] state the ordering state of the command
+        /// @param[in] x1, y1, x2, y2 the two points that define the line
+        /// @param[in] color the color of the line
+        /// @param[in] transform the per-draw transformation (see @ref gl_shape_renderer::drawTransform)
+        void draw_line(const render_state &state, GLfloat x1, GLfloat y1, GLfloat x2, GLfloat y2,
+                       const glm::vec4 &color, const glm::mat3 &transform = glm::mat3{1.0f});
+
+        /// @details Retrieves the number of pending commands.
+        /// @return the number of recorded commands
+        [[nodiscard]] std::size_t size() const noexcept;
+
+        /// @brief Discards all pending commands.
+        void clear() noexcept;
+
+        /// @brief Sorts and draws all pending commands, then clears this queue.
+        /// @details
+        /// The renderers' cameras and transformation matrices are used as they are;
+        /// their per-draw transformations and tints are restored afterwards.
+        /// Blending is disabled after drawing. If a draw throws, the active batch is ended,
+        /// the renderers' state is restored, and the remaining commands are discarded.
+        /// @param[in,out] textures the renderer for texture commands; must not have an active batch
+        /// @param[in,out] shapes the renderer for line commands; must not have an active batch
+        /// @return the statistics of this submission
+        /// @throw illegal_state_error if either renderer has an active batch
+        render_queue_stats submit(gl_texture_renderer &textures, gl_shape_renderer &shapes);
+    };
+}
+
+#endif //MUSUBI_GL_RENDER_QUEUE_H
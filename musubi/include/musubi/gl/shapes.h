@@ -8,14 +8,29 @@
 #include "musubi/camera.h"
 #include "musubi/common.h"
 #include "musubi/renderer.h"
+#include "musubi/span.h"
+#include "musubi/gl/batch_stats.h"
+#include "musubi/gl/culling.h"
 
 #include <epoxy/gl.h>
+#include <glm/mat3x3.hpp>
 #include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
 
 namespace musubi::gl {
+    class static_batch;
+
+    /// @brief A line drawn in bulk through @ref gl_shape_renderer::batch_draw_lines().
+    struct line final {
+        GLfloat x1{0}, y1{0}, x2{0}, y2{0}; ///< @brief The two points that define the line.
+        glm::vec4 color{1, 1, 1, 1}; ///< @brief The color of the line.
+    };
+
     /// @brief A @ref renderer for line-based polygons.
     /// @details
     /// This renderer processes _batches_ of draw operations.
+    /// Each operation is drawn with the current @ref color and @ref drawTransform,
+    /// so shapes with different colors and transformations can share a single draw call.
     class gl_shape_renderer final : public renderer {
     private:
         LIBMUSUBI_PIMPL
@@ -24,6 +39,23 @@ namespace musubi::gl {
         /// @brief The current color to use for drawing polygons.
         glm::vec4 color{1, 0, 0, 0};
 
+        /// @brief The affine transformation applied to the vertices of subsequent draw operations.
+        /// @details
+        /// Unlike @ref transform, which applies to a whole draw call, this is applied on the CPU
+        /// as each operation is added to the batch.
+        glm::mat3 drawTransform{1.0f};
+
+        /// @brief Whether subsequent draw operations outside the camera's view are discarded.
+        /// @details
+        /// When enabled, the bounding box of each line, rectangle or circle is tested against the view volume
+        /// of @ref camera and @ref transform before any vertices are generated (see @ref view_culler); discarded
+        /// primitives are counted in @ref batch_stats::culled. The view volume is rebuilt on the first culled draw
+        /// operation of a batch and whenever the camera or transformation changes. This is disabled by default.
+        bool culling{false};
+
+        /// @brief The default maximum number of lines drawn in a single draw call.
+        static constexpr uint32 DEFAULT_MAX_BATCH_SIZE = 16384;
+
         LIBMUSUBI_DELCP(gl_shape_renderer)
 
         /// @copydoc renderer()
@@ -43,8 +75,9 @@ namespace musubi::gl {
 
         /// @brief Finalizes and renders the current batch.
         /// @details
-        /// Loads the current triangle mesh into a vertex buffer, draws it and disposes it.
-        /// @param[in] resetTransform whether to reset the transformation matrix after finishing the batch
+        /// Draws the pending lines from the renderer's stream buffer.
+        /// @param[in] resetTransform whether to reset the transformation matrix and @ref drawTransform
+        /// after finishing the batch
         /// @throw illegal_state_error if there is no active batch
         void end_batch(bool resetTransform);
 
@@ -53,6 +86,14 @@ namespace musubi::gl {
         /// @throw illegal_state_error if there is no active batch
         void batch_draw_line(GLfloat x1, GLfloat y1, GLfloat x2, GLfloat y2);
 
+        /// @brief Draws lines, each with its own color.
+        /// @details
+        /// The vertices are generated by vectorized kernels (see @ref simd_level),
+        /// which transform the end points of many lines by @ref drawTransform at once.
+        /// @param[in] lines the lines to draw
+        /// @throw illegal_state_error if there is no active batch
+        void batch_draw_lines(span<const line> lines);
+
         /// @brief Draws a rectangle with the specified position and dimensions.
         /// @param[in] x, y the position of the rectangle
         /// @param[in] w, h the dimensions of the rectangle
@@ -65,6 +106,32 @@ namespace musubi::gl {
         /// @param[in] segments the number of segments to draw
         /// @throw illegal_state_error if there is no active batch
         void batch_draw_circle(GLfloat x, GLfloat y, GLfloat r, uint32 segments = 20);
+
+        /// @brief Draws the lines of an uploaded @ref static_batch in a single draw call.
+        /// @details
+        /// The batch is drawn under the current @ref camera and @ref transform; its vertices are not touched.
+        /// If there is an active batch, its pending lines are drawn first. With @ref culling enabled,
+        /// the lines are skipped if their combined bounds are outside the view.
+        /// @param[in] batch the static batch to draw
+        /// @throw illegal_state_error if the static batch has not been uploaded
+        void draw_static(const static_batch &batch);
+
+        /// @details Retrieves the maximum number of lines drawn in a single draw call.
+        /// @return the maximum batch size
+        [[nodiscard]] uint32 get_max_batch_size() const noexcept;
+
+        /// @brief Sets the maximum number of lines drawn in a single draw call.
+        /// @details Once a batch reaches this size, its pending lines are drawn early, bounding the size of each upload.
+        /// @param[in] lines the maximum batch size
+        /// @throw std::invalid_argument if `lines` is zero
+        void set_max_batch_size(uint32 lines);
+
+        /// @details Retrieves the draw statistics accumulated since the last call to @ref reset_stats().
+        /// @return a snapshot of this renderer's statistics
+        [[nodiscard]] batch_stats get_stats() const noexcept;
+
+        /// @brief Resets the draw statistics; typically called once per frame.
+        void reset_stats() noexcept;
     };
 }
 
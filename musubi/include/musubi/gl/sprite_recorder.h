@@ -0,0 +1,118 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#ifndef MUSUBI_GL_SPRITE_RECORDER_H
+#define MUSUBI_GL_SPRITE_RECORDER_H
+
+#include "musubi/common.h"
+#include "musubi/span.h"
+#include "musubi/gl/textures.h"
+
+#include <epoxy/gl.h>
+#include <glm/mat3x3.hpp>
+#include <glm/vec4.hpp>
+
+#include <cstddef>
+#include <memory>
+
+namespace musubi::gl {
+    namespace detail {
+        /// @brief The vertex layout of sprite quads, shared by @ref sprite_recorder and @ref gl_texture_renderer.
+        struct sprite_vertex final {
+            GLfloat x, y;
+            GLfloat u, v;
+            GLubyte tint[4];
+            GLubyte slot;
+            GLubyte padding[3];
+        };
+    }
+
+    /// @brief A run of consecutively recorded sprites that share a texture.
+    struct recorded_run final {
+        std::shared_ptr<::musubi::gl::texture> texture{}; ///< @brief The texture of the sprites.
+        std::size_t sprites{0}; ///< @brief The number of sprites in the run.
+    };
+
+    /// @brief A CPU-side buffer of sprite quads, recorded on any thread and drawn by a @ref gl_texture_renderer.
+    /// @details
+    /// A recorder performs all per-sprite work of @ref gl_texture_renderer::batch_draw_region()
+    /// (applying @ref drawTransform and @ref tint, flipping texture coordinates, and generating four vertices)
+    /// without touching OpenGL, so that sprite-heavy frames can be split across worker threads,
+    /// each recording into its own recorder. The render thread then passes every recorder to
+    /// @ref gl_texture_renderer::batch_draw_recorded(), which copies their vertices into a single upload
+    /// and only assigns sampler slots.
+    ///
+    /// A recorder must only be used by one thread at a time, and must not be drawn while it is being recorded.
+    /// Recorded textures are kept alive until the recorder is cleared; they must not be reloaded or unloaded
+    /// while other threads record them. Recorders retain their memory when cleared, so they are best reused
+    /// across frames.
+    class sprite_recorder final {
+    private:
+        LIBMUSUBI_PIMPL
+
+    public:
+        LIBMUSUBI_DELCP(sprite_recorder)
+
+        /// @brief The color that textures and texture regions are multiplied with by subsequent draw operations.
+        glm::vec4 tint{1, 1, 1, 1};
+
+        /// @brief The affine transformation applied to the vertices of subsequent draw operations.
+        /// @see gl_texture_renderer::drawTransform
+        glm::mat3 drawTransform{1.0f};
+
+        /// @brief Constructs an empty recorder.
+        /// @param[in] reservedSprites the number of sprites to reserve memory for
+        explicit sprite_recorder(std::size_t reservedSprites = 0);
+
+        /// @brief Destroys this recorder and its recorded sprites.
+        ~sprite_recorder() noexcept;
+
+        /// @brief Records a sprite drawing the whole texture.
+        /// @param[in] texture the texture to draw
+        /// @param[in] x, y the position at which to draw the texture
+        /// @param[in] width, height the desired size of the texture
+        /// @throw invalid_argument if the specified texture pointer is empty, or its content is not a valid texture
+        void draw_texture(const std::shared_ptr<texture> &texture,
+                          GLfloat x, GLfloat y, GLfloat width, GLfloat height);
+
+        /// @brief Records a sprite drawing part of the texture.
+        /// @param[in] texture the texture to draw
+        /// @param[in] x, y the position at which to draw the texture
+        /// @param[in] width, height the desired size of the texture
+        /// @param[in] u1, v1, u2, v2 the texture coordinates of the drawn part
+        /// @throw invalid_argument if the specified texture pointer is empty, or its content is not a valid texture
+        void draw_texture(const std::shared_ptr<texture> &texture,
+                          GLfloat x, GLfloat y, GLfloat width, GLfloat height,
+                          GLfloat u1, GLfloat v1, GLfloat u2, GLfloat v2);
+
+        /// @brief Records a sprite drawing a texture region.
+        /// @param[in] region the texture region to draw
+        /// @param[in] x, y the position at which to draw the texture region
+        /// @param[in] width, height the dimensions of the texture region
+        /// @throw invalid_argument if the specified texture region refers to a deleted texture
+        void draw_region(const texture_region &region, GLfloat x, GLfloat y, GLfloat width, GLfloat height);
+
+        /// @details Retrieves the number of recorded sprites.
+        /// @return the number of sprites
+        [[nodiscard]] std::size_t size() const noexcept;
+
+        /// @details Checks if no sprites have been recorded.
+        /// @return whether this recorder is empty
+        [[nodiscard]] bool empty() const noexcept;
+
+        /// @brief Discards all recorded sprites, retaining the allocated memory.
+        /// @details This does not reset @ref tint or @ref drawTransform.
+        void clear() noexcept;
+
+        /// @details Retrieves the recorded vertices, four per sprite in recording order.
+        /// @return the recorded vertices; their sampler slots are unassigned
+        [[nodiscard]] span<const detail::sprite_vertex> get_vertices() const noexcept;
+
+        /// @details Retrieves the recorded runs of sprites sharing a texture, in recording order.
+        /// @return the recorded runs
+        [[nodiscard]] span<const recorded_run> get_runs() const noexcept;
+    };
+}
+
+#endif //MUSUBI_GL_SPRITE_RECORDER_H
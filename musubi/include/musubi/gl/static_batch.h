@@ -0,0 +1,148 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#ifndef MUSUBI_GL_STATIC_BATCH_H
+#define MUSUBI_GL_STATIC_BATCH_H
+
+#include "musubi/common.h"
+#include "musubi/span.h"
+#include "musubi/gl/culling.h"
+#include "musubi/gl/textures.h"
+
+#include <epoxy/gl.h>
+#include <glm/mat3x3.hpp>
+#include <glm/vec4.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace musubi::gl {
+    /// @brief A range of the sprites of a @ref static_batch that is drawn in a single draw call.
+    struct static_batch_segment final {
+        /// @brief The textures of the segment, bound to consecutive sampler slots.
+        std::vector<std::shared_ptr<texture>> textures{};
+        GLint baseVertex{0}; ///< @brief The index of the first vertex of the segment.
+        GLsizei quads{0}; ///< @brief The number of quads in the segment.
+        bounding_box bounds{}; ///< @brief The bounds of the segment's quads.
+    };
+
+    /// @brief Retained geometry that is recorded once and drawn repeatedly without regenerating its vertices.
+    /// @details
+    /// Static content, such as backgrounds, level geometry or interface frames, is recorded into the batch
+    /// like into a renderer, using the batch's @ref tint, @ref color and @ref drawTransform.
+    /// @ref upload() then stores the vertices in buffers owned by the batch, together with its own vertex arrays,
+    /// and releases the CPU-side copies.
+    ///
+    /// Uploaded batches are drawn through @ref gl_texture_renderer::draw_static() (sprites) and
+    /// @ref gl_shape_renderer::draw_static() (lines), under the renderer's current camera and transformation;
+    /// each takes one draw call per @ref static_batch_segment "segment" (or one for all lines)
+    /// and no per-vertex work on the CPU.
+    ///
+    /// Recording does not require an OpenGL context; uploading, clearing and destroying an uploaded batch
+    /// must happen on the thread owning the context.
+    class static_batch final {
+    private:
+        LIBMUSUBI_PIMPL
+
+    public:
+        LIBMUSUBI_DELCP(static_batch)
+
+        /// @brief The color that textures and texture regions are multiplied with by subsequent draw operations.
+        glm::vec4 tint{1, 1, 1, 1};
+
+        /// @brief The color of subsequently drawn lines.
+        glm::vec4 color{1, 1, 1, 1};
+
+        /// @brief The affine transformation applied to the vertices of subsequent draw operations.
+        glm::mat3 drawTransform{1.0f};
+
+        /// @brief Constructs an empty batch.
+        /// @details This does not create any OpenGL objects.
+        static_batch();
+
+        /// @brief Destroys this batch, and its OpenGL objects if it has been uploaded.
+        ~static_batch() noexcept;
+
+        /// @brief Records a sprite drawing the whole texture.
+        /// @param[in] texture the texture to draw
+        /// @param[in] x, y the position at which to draw the texture
+        /// @param[in] width, height the desired size of the texture
+        /// @throw illegal_state_error if the batch has already been uploaded
+        /// @throw invalid_argument if the specified texture pointer is empty, or its content is not a valid texture
+        void draw_texture(const std::shared_ptr<texture> &texture,
+                          GLfloat x, GLfloat y, GLfloat width, GLfloat height);
+
+        /// @brief Records a sprite drawing part of the texture.
+        /// @param[in] texture the texture to draw
+        /// @param[in] x, y the position at which to draw the texture
+        /// @param[in] width, height the desired size of the texture
+        /// @param[in] u1, v1, u2, v2 the texture coordinates of the drawn part
+        /// @throw illegal_state_error if the batch has already been uploaded
+        /// @throw invalid_argument if the specified texture pointer is empty, or its content is not a valid texture
+        void draw_texture(const std::shared_ptr<texture> &texture,
+                          GLfloat x, GLfloat y, GLfloat width, GLfloat height,
+                          GLfloat u1, GLfloat v1, GLfloat u2, GLfloat v2);
+
+        /// @brief Records a sprite drawing a texture region.
+        /// @param[in] region the texture region to draw
+        /// @param[in] x, y the position at which to draw the texture region
+        /// @param[in] width, height the dimensions of the texture region
+        /// @throw illegal_state_error if the batch has already been uploaded
+        /// @throw invalid_argument if the specified texture region refers to a deleted texture
+        void draw_region(const texture_region &region, GLfloat x, GLfloat y, GLfloat width, GLfloat height);
+
+        /// @brief Records a line.
+        /// @param[in] x1, y1, x2, y2 the two points that define the line
+        /// @throw illegal_state_error if the batch has already been uploaded
+        void draw_line(GLfloat x1, GLfloat y1, GLfloat x2, GLfloat y2);
+
+        /// @brief Records the outline of a rectangle.
+        /// @param[in] x, y the position of the rectangle
+        /// @param[in] w, h the dimensions of the rectangle
+        /// @throw illegal_state_error if the batch has already been uploaded
+        void draw_rectangle(GLfloat x, GLfloat y, GLfloat w, GLfloat h);
+
+        /// @brief Uploads the recorded geometry into buffers owned by this batch.
+        /// @details
+        /// Sprites are split into segments that use at most as many textures as there are sampler slots
+        /// (see @ref gl_texture_renderer::get_texture_slots()). The CPU-side copies of the vertices are released;
+        /// the recorded textures are kept alive until the batch is cleared or destroyed.
+        /// @throw illegal_state_error if the batch has already been uploaded
+        void upload();
+
+        /// @details Checks if this batch has been uploaded, and can be drawn.
+        /// @return whether the batch has been uploaded
+        [[nodiscard]] bool is_uploaded() const noexcept;
+
+        /// @brief Discards all recorded geometry and OpenGL objects, so that the batch can be recorded again.
+        void clear() noexcept;
+
+        /// @details Retrieves the number of recorded sprites.
+        /// @return the number of sprites
+        [[nodiscard]] std::size_t get_sprite_count() const noexcept;
+
+        /// @details Retrieves the number of recorded lines.
+        /// @return the number of lines
+        [[nodiscard]] std::size_t get_line_count() const noexcept;
+
+        /// @details Retrieves the sprite segments of an uploaded batch.
+        /// @return the segments, or an empty span if the batch has not been uploaded
+        [[nodiscard]] span<const static_batch_segment> get_segments() const noexcept;
+
+        /// @details Retrieves the vertex array of an uploaded batch's sprites, including their index buffer.
+        /// @return the vertex array, or 0 if the batch has not been uploaded
+        [[nodiscard]] GLuint get_sprite_vertex_array() const noexcept;
+
+        /// @details Retrieves the vertex array of an uploaded batch's lines.
+        /// @return the vertex array, or 0 if the batch has not been uploaded
+        [[nodiscard]] GLuint get_line_vertex_array() const noexcept;
+
+        /// @details Retrieves the bounds of the recorded lines.
+        /// @return the bounds of all lines
+        [[nodiscard]] bounding_box get_line_bounds() const noexcept;
+    };
+}
+
+#endif //MUSUBI_GL_STATIC_BATCH_H
@@ -0,0 +1,99 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#ifndef MUSUBI_GL_STREAM_BUFFER_H
+#define MUSUBI_GL_STREAM_BUFFER_H
+
+#include "musubi/common.h"
+#include "musubi/span.h"
+
+#include <epoxy/gl.h>
+
+#include <cstddef>
+
+namespace musubi::gl {
+    /// @brief Statistics of a @ref stream_buffer.
+    struct stream_buffer_stats final {
+        std::size_t regionSize{0}; ///< @brief The current size of each region, in bytes.
+        std::size_t regionCount{0}; ///< @brief The number of regions in the ring.
+        bool persistent{false}; ///< @brief Whether the buffer is persistently mapped.
+
+        uint64 committedBytes{0}; ///< @brief The total number of bytes committed.
+        uint64 wraps{0}; ///< @brief The number of times writing moved on to the next region.
+        uint64 stalls{0}; ///< @brief The number of times the next region was still in use by the GPU.
+        uint64 reallocations{0}; ///< @brief The number of times the regions were enlarged.
+    };
+
+    /// @brief A persistent ring buffer for streaming vertex data.
+    /// @details
+    /// Instead of creating, filling and deleting a buffer object for every draw call, data is written
+    /// directly into a single buffer object, which is split into a ring of equally-sized regions
+    /// (three by default, so that the CPU can write one region while the GPU reads the others).
+    ///
+    /// Writing starts with @ref reserve(), which returns mapped memory from the current region;
+    /// once the data has been written, @ref commit() makes it available at a buffer offset.
+    /// When the current region is exhausted, a fence is inserted behind all draw calls issued so far,
+    /// and writing continues in the next region after waiting for its own fence, if necessary.
+    ///
+    /// If `GL_ARB_buffer_storage` (OpenGL 4.4) is available, the buffer is persistently and coherently mapped
+    /// once; otherwise, each reservation maps its range through `glMapBufferRange` with unsynchronized writes,
+    /// as the fences already protect regions that are in flight.
+    ///
+    /// Stream buffers must only be used on the thread owning the OpenGL context.
+    class stream_buffer final {
+    private:
+        LIBMUSUBI_PIMPL
+
+    public:
+        LIBMUSUBI_DELCP(stream_buffer)
+
+        /// @brief Allocates a stream buffer.
+        /// @param[in] regionSize the initial size of each region, in bytes
+        /// @param[in] regionCount the number of regions
+        /// @param[in] target the buffer binding target used for mapping, e.g. `GL_ARRAY_BUFFER`
+        /// @throw std::invalid_argument if the region size is zero or there are fewer than two regions
+        /// @throw illegal_state_error if the buffer could not be persistently mapped
+        explicit stream_buffer(std::size_t regionSize = 1u << 20u, std::size_t regionCount = 3,
+                               GLenum target = GL_ARRAY_BUFFER);
+
+        /// @brief Deletes the buffer object and its fences.
+        /// @details OpenGL defers the deletion until draw calls reading from the buffer have completed.
+        ~stream_buffer() noexcept;
+
+        /// @brief Reserves mapped memory to write data into.
+        /// @details
+        /// The returned memory spans the rest of the current region, and is at least `minSize` bytes large;
+        /// if the current region has less room, writing moves on to the next region.
+        /// If `minSize` exceeds the region size, the buffer is reallocated with larger regions.
+        ///
+        /// The memory is write-only, and remains valid until @ref commit() is called.
+        /// The buffer is left bound to its target.
+        /// @param[in] minSize the minimum number of bytes to reserve
+        /// @return the reserved memory, aligned to 16 bytes
+        /// @throw illegal_state_error if memory is already reserved, or could not be mapped
+        [[nodiscard]] span<std::byte> reserve(std::size_t minSize);
+
+        /// @brief Commits data written into reserved memory.
+        /// @details The buffer is left bound to its target.
+        /// @param[in] size the number of bytes written, from the start of the reserved memory
+        /// @return the offset of the committed data in the buffer object
+        /// @throw illegal_state_error if no memory is reserved
+        /// @throw std::out_of_range if `size` exceeds the reserved size
+        std::size_t commit(std::size_t size);
+
+        /// @details Checks if memory is currently reserved.
+        /// @return whether @ref reserve() was called without a matching @ref commit()
+        [[nodiscard]] bool is_reserved() const noexcept;
+
+        /// @details Retrieves the buffer object name; it changes when the buffer is reallocated.
+        /// @return the current buffer object
+        [[nodiscard]] GLuint get_buffer() const noexcept;
+
+        /// @details Retrieves the statistics of this buffer.
+        /// @return a snapshot of this buffer's statistics
+        [[nodiscard]] stream_buffer_stats get_stats() const noexcept;
+    };
+}
+
+#endif //MUSUBI_GL_STREAM_BUFFER_H
@@ -0,0 +1,87 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#ifndef MUSUBI_GL_TEXTURE_MEMORY_H
+#define MUSUBI_GL_TEXTURE_MEMORY_H
+
+#include "musubi/common.h"
+
+#include <epoxy/gl.h>
+
+#include <array>
+#include <cstddef>
+
+namespace musubi::gl {
+    /// @brief A category of textures, used to account and budget video memory separately.
+    enum class texture_category : uint8 {
+        general, ///< Textures without a specific category
+        world, ///< Level, sprite and background textures
+        interface, ///< User interface textures
+        glyphs, ///< Font and text textures
+        dynamic, ///< Textures generated or updated at runtime, such as atlases and render targets
+    };
+
+    /// @brief The number of @ref texture_category "texture categories".
+    constexpr std::size_t TEXTURE_CATEGORY_COUNT = 5;
+
+    /// @brief Retrieves the name of a @ref texture_category.
+    /// @param[in] category the category
+    /// @return the name of the category
+    [[nodiscard]] const char *get_texture_category_name(texture_category category) noexcept;
+
+    /// @brief The video memory usage of a @ref texture_category.
+    struct texture_memory_usage final {
+        std::size_t bytes{0}; ///< @brief The estimated size of all textures in the category.
+        std::size_t textures{0}; ///< @brief The number of valid textures in the category.
+        std::size_t budget{0}; ///< @brief The budget of the category in bytes, or 0 if it is unlimited.
+
+        /// @details Checks if the textures in the category exceed its budget.
+        /// @return whether the category is over budget
+        [[nodiscard]] constexpr bool over_budget() const noexcept { return budget != 0 && bytes > budget; }
+    };
+
+    /// @brief The video memory usage of all textures.
+    struct texture_memory_stats final {
+        /// @brief The usage of each category, indexed by the value of its @ref texture_category.
+        std::array<texture_memory_usage, TEXTURE_CATEGORY_COUNT> categories{};
+        std::size_t totalBytes{0}; ///< @brief The estimated size of all textures.
+        std::size_t totalTextures{0}; ///< @brief The number of valid textures.
+    };
+
+    /// @brief Estimates the video memory occupied by a texture.
+    /// @details
+    /// Three-component formats are assumed to be padded to four components, as most implementations do.
+    /// @param[in] internalFormat the OpenGL internal format of the texture
+    /// @param[in] width, height the size of the base level
+    /// @param[in] levels the number of mip levels, including the base level
+    /// @return the estimated size in bytes
+    [[nodiscard]] std::size_t get_texture_memory_size(GLenum internalFormat, uint32 width, uint32 height,
+                                                      uint32 levels = 1) noexcept;
+
+    /// @brief Retrieves the video memory usage of all textures.
+    /// @details This function is thread-safe.
+    /// @return a snapshot of the current usage
+    [[nodiscard]] texture_memory_stats get_texture_memory_stats() noexcept;
+
+    /// @brief Retrieves the video memory usage of a category.
+    /// @details This function is thread-safe.
+    /// @param[in] category the category
+    /// @return a snapshot of the category's current usage
+    [[nodiscard]] texture_memory_usage get_texture_memory_usage(texture_category category) noexcept;
+
+    /// @brief Sets the video memory budget of a category.
+    /// @details
+    /// Budgets are not enforced when textures are loaded; they are used by @ref texture_residency
+    /// to decide which idle textures to evict. This function is thread-safe.
+    /// @param[in] category the category
+    /// @param[in] bytes the budget in bytes, or 0 for an unlimited budget
+    void set_texture_memory_budget(texture_category category, std::size_t bytes) noexcept;
+
+    namespace detail {
+        /// @brief Adds a texture's size to the usage of a category, or removes it if `count` is negative.
+        void track_texture_memory(texture_category category, std::size_t bytes, int count) noexcept;
+    }
+}
+
+#endif //MUSUBI_GL_TEXTURE_MEMORY_H
@@ -0,0 +1,118 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#ifndef MUSUBI_GL_TEXTURE_RESIDENCY_H
+#define MUSUBI_GL_TEXTURE_RESIDENCY_H
+
+#include "musubi/common.h"
+#include "musubi/pixmap.h"
+#include "musubi/gl/texture_memory.h"
+#include "musubi/gl/textures.h"
+
+#include <epoxy/gl.h>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace musubi::gl {
+    /// @brief Statistics of a @ref texture_residency.
+    struct texture_residency_stats final {
+        std::size_t textures{0}; ///< @brief The number of managed textures.
+        std::size_t resident{0}; ///< @brief The number of managed textures currently loaded.
+        std::size_t residentBytes{0}; ///< @brief The estimated size of all resident managed textures.
+
+        uint64 loads{0}; ///< @brief The number of times a managed texture was loaded, including reloads.
+        uint64 reloads{0}; ///< @brief The number of times an evicted texture was reloaded on demand.
+        uint64 evictions{0}; ///< @brief The number of times a managed texture was evicted.
+    };
+
+    /// @brief Manages which textures are resident in video memory.
+    /// @details
+    /// Textures are added together with a _source_, a function that produces their pixmap
+    /// (typically by decoding it from an asset file). Each time a texture is drawn, it should be
+    /// retrieved through @ref acquire(), which marks it as used in the current frame,
+    /// and loads it from its source if it is not resident.
+    ///
+    /// On @ref next_frame(), textures that have not been acquired for the configured number of frames
+    /// are evicted, least recently used first, from every @ref texture_category that exceeds its budget
+    /// (see @ref set_texture_memory_budget()). Evicting only deletes the OpenGL texture; the texture
+    /// object itself is kept, so shared pointers and @ref texture_region "regions" referring to it stay valid,
+    /// and become usable again once the texture is reloaded.
+    ///
+    /// Residency managers must only be used on the thread owning the OpenGL context.
+    class texture_residency final {
+    private:
+        LIBMUSUBI_PIMPL
+
+    public:
+        /// @brief The type of texture sources.
+        /// @details Sources are invoked whenever their texture is (re-)loaded, and must not return null.
+        using source_function = std::function<std::shared_ptr<const pixmap>()>;
+
+        /// @brief The type of managed texture identifiers; IDs are never reused by the same manager.
+        using texture_id = uint64;
+
+        LIBMUSUBI_DELCP(texture_residency)
+
+        /// @brief Constructs an empty residency manager.
+        /// @param[in] idleFrames the number of frames a texture must not have been acquired for to become evictable
+        explicit texture_residency(uint32 idleFrames = 300);
+
+        /// @brief Destroys this manager; textures that are still referenced elsewhere stay loaded.
+        ~texture_residency() noexcept;
+
+        /// @brief Adds a texture to this manager.
+        /// @details The texture is loaded lazily, on its first acquisition.
+        /// @param[in] source the function producing the texture's pixmap
+        /// @param[in] category the category the texture is accounted to
+        /// @param[in] shouldFlip whether the texture should be vertically flipped prior to rendering
+        /// @param[in] internalFormat the OpenGL internal image format for the texture
+        /// @return the ID of the managed texture
+        /// @throw std::invalid_argument if `source` is empty
+        texture_id add(source_function source, texture_category category = texture_category::general,
+                       bool shouldFlip = false, GLenum internalFormat = GL_RGBA8);
+
+        /// @brief Removes a texture from this manager, and unloads it.
+        /// @param[in] id the ID of the managed texture
+        /// @return whether this manager contained the texture
+        bool remove(texture_id id);
+
+        /// @brief Retrieves a managed texture, and marks it as used in the current frame.
+        /// @details If the texture is not resident, it is loaded from its source first.
+        /// @param[in] id the ID of the managed texture
+        /// @return the loaded texture
+        /// @throw std::out_of_range if this manager does not contain the texture
+        /// @throw std::invalid_argument if the texture's source returned null
+        std::shared_ptr<texture> acquire(texture_id id);
+
+        /// @details Checks if a managed texture is currently loaded.
+        /// @param[in] id the ID of the managed texture
+        /// @return whether the texture is resident
+        /// @throw std::out_of_range if this manager does not contain the texture
+        [[nodiscard]] bool is_resident(texture_id id) const;
+
+        /// @brief Begins a new frame, and evicts idle textures from categories that exceed their budgets.
+        void next_frame() noexcept;
+
+        /// @brief Evicts all idle textures, regardless of budgets.
+        /// @details This is useful when memory is known to be scarce, e.g. after switching levels.
+        /// @return the number of evicted textures
+        std::size_t evict_idle() noexcept;
+
+        /// @details Retrieves the number of frames a texture must be idle for to become evictable.
+        /// @return the number of idle frames
+        [[nodiscard]] uint32 get_idle_frames() const noexcept;
+
+        /// @details Sets the number of frames a texture must be idle for to become evictable.
+        /// @param[in] idleFrames the number of idle frames
+        void set_idle_frames(uint32 idleFrames) noexcept;
+
+        /// @details Retrieves the statistics of this manager.
+        /// @return a snapshot of this manager's statistics
+        [[nodiscard]] texture_residency_stats get_stats() const;
+    };
+}
+
+#endif //MUSUBI_GL_TEXTURE_RESIDENCY_H
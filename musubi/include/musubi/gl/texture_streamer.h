@@ -0,0 +1,201 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#ifndef MUSUBI_GL_TEXTURE_STREAMER_H
+#define MUSUBI_GL_TEXTURE_STREAMER_H
+
+#include "musubi/common.h"
+#include "musubi/gl/textures.h"
+#include "musubi/pixmap.h"
+
+#include <epoxy/gl.h>
+
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <optional>
+
+namespace musubi::gl {
+    /// @brief Upload statistics of a @ref texture_streamer.
+    struct texture_streamer_stats final {
+        uint64 uploads{0}; ///< @brief The number of uploads issued to OpenGL.
+        uint64 uploadedBytes{0}; ///< @brief The total size of all issued uploads.
+        uint64 completedUploads{0}; ///< @brief The number of uploads whose fence has been signaled.
+        uint64 stalls{0}; ///< @brief The number of staging requests that failed because the ring was full.
+
+        std::size_t pendingUploads{0}; ///< @brief The number of committed uploads that have not been issued yet.
+        std::size_t pendingBytes{0}; ///< @brief The total size of all committed uploads that have not been issued yet.
+        std::size_t lastFrameBytes{0}; ///< @brief The number of bytes issued by the last call to process().
+
+        bool persistent{false}; ///< @brief Whether the staging ring is persistently mapped.
+    };
+
+    /// @brief An asynchronous texture upload queue backed by a ring of pixel buffer objects.
+    /// @details
+    /// Uploading through @ref texture::load() copies pixels synchronously from client memory,
+    /// which stalls the rendering thread for large images. A texture streamer instead hands out
+    /// _staging buffers_, which point directly into mapped pixel buffer objects (PBOs) and can be filled
+    /// from any thread. Committed staging buffers are then uploaded into their target textures by
+    /// @ref process(), which the thread owning the OpenGL context calls once per frame;
+    /// the copy from the PBO into the texture is performed asynchronously by the driver.
+    ///
+    /// The staging memory is split into a ring of equally-sized segments, each backed by its own PBO.
+    /// If `GL_ARB_buffer_storage` (OpenGL 4.4) is available, segments are persistently mapped once;
+    /// otherwise, each segment is orphaned and re-mapped by @ref process() whenever it is reused.
+    /// A fence is inserted after the uploads of each segment, and the segment is only reused once
+    /// that fence has been signaled; the futures returned by @ref commit() complete at the same time.
+    ///
+    /// Each call to @ref process() issues uploads worth at most the per-frame byte budget
+    /// (but always at least one upload), which spreads the transfer of large batches over multiple frames.
+    ///
+    /// Target textures must already have storage allocated (see @ref texture::allocate()),
+    /// and are referenced weakly; uploads into textures that have been destroyed are discarded.
+    /// The streamer must be constructed and destroyed on the thread owning the OpenGL context,
+    /// and must outlive all staging buffers acquired from it.
+    class texture_streamer final {
+    private:
+        LIBMUSUBI_PIMPL
+
+    public:
+        /// @brief A writable region of staging memory, holding the pixels of a single upload.
+        /// @details
+        /// Rows are tightly packed. A staging buffer must be passed to @ref commit() once its pixels
+        /// have been written; destroying it without committing cancels the upload.
+        class staging_buffer final {
+        public:
+            LIBMUSUBI_DELCP(staging_buffer)
+
+            /// @details Move constructor; `other` becomes empty.
+            /// @param[in,out] other the staging buffer to move from
+            staging_buffer(staging_buffer &&other) noexcept;
+
+            /// @details Move assignment operator; `other` becomes empty.
+            /// @param[in,out] other the staging buffer to move from
+            /// @return this
+            staging_buffer &operator=(staging_buffer &&other) noexcept;
+
+            /// @brief Cancels the upload if this buffer has not been committed.
+            ~staging_buffer() noexcept;
+
+            /// @details Retrieves a mutable pointer to the staging memory.
+            /// @return a pointer to the first row of the upload
+            [[nodiscard]] byte *data() const noexcept { return ptr; }
+
+            /// @details Retrieves a mutable pointer to the specified row of the staging memory.
+            /// @param[in] y the row index; this is not bounds-checked
+            /// @return a pointer to the specified row
+            [[nodiscard]] byte *row_data(uint32 y) const noexcept { return ptr + y * get_stride(); }
+
+            /// @details Retrieves the distance between the starts of two consecutive rows, in bytes.
+            /// @return the row stride of this buffer
+            [[nodiscard]] std::size_t get_stride() const noexcept {
+                return region.width * get_bytes_per_pixel(format);
+            }
+
+            /// @details Retrieves the size of the staging memory, in bytes.
+            /// @return the size of this buffer
+            [[nodiscard]] std::size_t size() const noexcept { return get_stride() * region.height; }
+
+            /// @details Retrieves the region of the target texture that this buffer is uploaded to.
+            /// @return the target region
+            [[nodiscard]] const pixmap_rect &get_region() const noexcept { return region; }
+
+            /// @details Retrieves the pixel format of this buffer.
+            /// @return the format of this buffer
+            [[nodiscard]] pixmap_format get_format() const noexcept { return format; }
+
+            /// @brief Copies the contents of a pixmap into this buffer.
+            /// @param[in] source the pixmap to copy; must have the size of the target region and this buffer's format
+            /// @throw std::invalid_argument if the size or format of `source` differs from this buffer's
+            void copy_from(const pixmap &source);
+
+            /// @details Checks if this buffer refers to staging memory, i.e. has not been committed or moved from.
+            /// @return whether this buffer is valid
+            explicit operator bool() const noexcept { return owner != nullptr; }
+
+        private:
+            friend class texture_streamer;
+
+            staging_buffer(impl *owner, std::size_t segment, std::size_t offset, byte *ptr,
+                           std::weak_ptr<texture> target, const pixmap_rect &region, pixmap_format format) noexcept;
+
+            impl *owner{nullptr};
+            std::size_t segment{0}, offset{0};
+            byte *ptr{nullptr};
+            std::weak_ptr<texture> target{};
+            pixmap_rect region{};
+            pixmap_format format{pixmap_format::rgba8};
+        };
+
+        LIBMUSUBI_DELCP(texture_streamer)
+
+        /// @brief Constructs a texture streamer and allocates its staging ring.
+        /// @details This requires a current OpenGL context.
+        /// @param[in] segmentSize the size of each staging segment in bytes; this limits the size of a single upload
+        /// @param[in] segmentCount the number of staging segments; must be at least 2
+        /// @param[in] frameBudget the maximum number of bytes to upload per call to @ref process()
+        /// @throw std::invalid_argument if the segment size is zero, or there are fewer than 2 segments
+        explicit texture_streamer(std::size_t segmentSize = 4u * 1024u * 1024u, std::size_t segmentCount = 3,
+                                  std::size_t frameBudget = 8u * 1024u * 1024u);
+
+        /// @brief Destroys this streamer, deleting its pixel buffer objects and fences.
+        /// @details
+        /// Uploads that have not completed are abandoned; their futures receive a `std::future_error`.
+        /// This requires a current OpenGL context.
+        ~texture_streamer() noexcept;
+
+        /// @brief Acquires staging memory for an upload into a region of a texture.
+        /// @details This function is thread-safe.
+        /// @param[in] target the texture to upload to
+        /// @param[in] region the region of the texture to upload to
+        /// @return a staging buffer, or an empty optional if the staging ring is currently full
+        /// @throw std::invalid_argument if the target texture has expired or is not valid,
+        /// or if the region exceeds the segment size
+        /// @throw std::out_of_range if the region is not fully contained in the target texture
+        [[nodiscard]] std::optional<staging_buffer> try_acquire(const std::weak_ptr<texture> &target,
+                                                                const pixmap_rect &region);
+
+        /// @brief Queues a filled staging buffer for upload.
+        /// @details This function is thread-safe; `buffer` becomes empty.
+        /// @param[in,out] buffer the staging buffer to upload
+        /// @return a future that completes once the upload's fence has been signaled,
+        /// or receives an @ref illegal_state_error if the target texture was destroyed in the meantime
+        /// @throw std::invalid_argument if the buffer is empty or was acquired from another streamer
+        std::future<void> commit(staging_buffer &&buffer);
+
+        /// @brief Copies a pixmap into staging memory and queues it for upload to a position in a texture.
+        /// @details This function is thread-safe.
+        /// @param[in] target the texture to upload to; its format must match the pixmap's
+        /// @param[in] source the pixmap to upload
+        /// @param[in] x, y the position in the texture to upload to
+        /// @return a future as returned by @ref commit(), or an empty optional if the staging ring is currently full
+        /// @see try_acquire()
+        std::optional<std::future<void>> try_stream(const std::weak_ptr<texture> &target, const pixmap &source,
+                                                    uint32 x = 0, uint32 y = 0);
+
+        /// @brief Issues pending uploads and retires completed ones.
+        /// @details
+        /// This must be called regularly (typically once per frame) on the thread owning the OpenGL context.
+        /// Uploads worth at most the frame budget are issued per call.
+        void process();
+
+        /// @details Retrieves the maximum number of bytes issued per call to @ref process().
+        /// @return the frame budget in bytes
+        [[nodiscard]] std::size_t get_frame_budget() const;
+
+        /// @details Sets the maximum number of bytes issued per call to @ref process().
+        /// @param[in] frameBudget the frame budget in bytes
+        void set_frame_budget(std::size_t frameBudget);
+
+        /// @details Retrieves the size of each staging segment, which is the maximum size of a single upload.
+        /// @return the segment size in bytes
+        [[nodiscard]] std::size_t get_segment_size() const noexcept;
+
+        /// @details Retrieves the upload statistics of this streamer.
+        /// @return a snapshot of this streamer's statistics
+        [[nodiscard]] texture_streamer_stats get_stats() const;
+    };
+}
+
+#endif //MUSUBI_GL_TEXTURE_STREAMER_H
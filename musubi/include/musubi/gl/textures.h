@@ -6,22 +6,55 @@
 #define MUSUBI_GL_TEXTURES_H
 
 #include "musubi/common.h"
+#include "musubi/load_pipeline.h"
+#include "musubi/mipmap.h"
 #include "musubi/renderer.h"
 #include "musubi/pixmap.h"
+#include "musubi/span.h"
+#include "musubi/gl/batch_stats.h"
+#include "musubi/gl/culling.h"
+#include "musubi/gl/texture_memory.h"
 
 #include <epoxy/gl.h>
+#include <glm/mat3x3.hpp>
+#include <glm/vec4.hpp>
 
+#include <functional>
+#include <future>
 #include <memory>
 
 namespace musubi::gl {
+    /// @brief Retrieves the sized OpenGL internal format that matches the storage of a @ref pixmap_format.
+    /// @details
+    /// Textures are loaded as `GL_RGBA8` by default; passing this format to @ref texture::load() instead
+    /// keeps the video memory footprint of smaller formats (such as @ref pixmap_format::rgb565) small.
+    /// This requires a current OpenGL context.
+    /// @param[in] format the pixmap format
+    /// @return the matching internal format
+    [[nodiscard]] GLenum get_internal_format(pixmap_format format);
+
+    /// @brief Retrieves the OpenGL client pixel format (e.g. `GL_RGBA`) of a @ref pixmap_format.
+    /// @param[in] format the pixmap format
+    /// @return the pixel format to pass to `glTexImage2D` and similar
+    [[nodiscard]] GLenum get_pixel_format(pixmap_format format);
+
+    /// @brief Retrieves the OpenGL client pixel type (e.g. `GL_UNSIGNED_BYTE`) of a @ref pixmap_format.
+    /// @param[in] format the pixmap format
+    /// @return the pixel type to pass to `glTexImage2D` and similar
+    [[nodiscard]] GLenum get_pixel_type(pixmap_format format) noexcept;
+
     /// @brief A wrapper for an OpenGL texture name.
     /// @details
     /// This class additionally contains a flag representing whether
     /// the texture should be vertically flipped prior to rendering;
     /// this is usually true for textures loaded from disk.
     ///
-    /// Texture objects do **not** store the contents of the buffer/pixmap used to create them
-    /// and thus have no internal state.
+    /// Texture objects do **not** store the contents of the buffer/pixmap used to create them;
+    /// they only remember the size and format of their base level, so that dynamic textures
+    /// can be partially re-uploaded through @ref update().
+    ///
+    /// The estimated video memory of every valid texture is accounted to its @ref texture_category
+    /// (see @ref get_texture_memory_stats()).
     ///
     /// Textures are considered "valid" if they contain an OpenGL texture name (see @ref is_valid() const).
     /// Valid textures are guaranteed to point to an existing texture,
@@ -54,12 +87,112 @@ namespace musubi::gl {
         ~texture() noexcept;
 
         /// @brief Loads a texture from a @ref pixmap using the specified internal texture format.
+        /// @details
+        /// The source's row stride is honored through `GL_UNPACK_ROW_LENGTH`,
+        /// so a @ref pixmap_view of a sub-region (e.g. of an atlas) is uploaded without an intermediate copy.
+        /// Packed formats are uploaded through the matching packed pixel types (e.g. `GL_UNSIGNED_SHORT_5_6_5`),
+        /// and @ref pixmap_format::la8 is sampled as (L, L, L, A) through a texture swizzle.
+        /// @see get_internal_format()
         /// @param[in] source the source pixmap to be loaded by `glTexImage2D` or similar
         /// @param[in] shouldFlip whether the texture should be vertically flipped prior to rendering
         /// @param[in] internalFormat the OpenGL internal image format for the loaded texture
         /// @return the newly-created texture name
         GLuint load(const pixmap &source, bool shouldFlip = false, GLenum internalFormat = GL_RGBA8);
 
+        /// @brief Loads a mipmapped texture from a base level and its mip chain.
+        /// @details
+        /// Each element of `mips` is uploaded as the next mip level, and the texture is set up for
+        /// trilinear filtering (`GL_LINEAR_MIPMAP_LINEAR`). The chain may be incomplete,
+        /// in which case sampling is restricted to the specified levels.
+        /// @param[in] base the base level
+        /// @param[in] mips mip levels 1 and onward, as built by @ref build_mip_chain()
+        /// @param[in] shouldFlip whether the texture should be vertically flipped prior to rendering
+        /// @param[in] internalFormat the OpenGL internal image format for the loaded texture
+        /// @return the newly-created texture name
+        /// @throw std::invalid_argument if a mip level's format differs from the base level's,
+        /// or its size is not half the size of the previous level
+        GLuint load(const pixmap &base, span<const pixmap_view> mips,
+                    bool shouldFlip = false, GLenum internalFormat = GL_RGBA8);
+
+        /// @brief Creates a texture with uninitialized contents.
+        /// @details
+        /// This allocates storage for the base level only; its contents can then be supplied
+        /// through @ref upload() or a @ref texture_streamer.
+        /// @param[in] width, height the size of the texture
+        /// @param[in] format the format of the pixmaps that will be uploaded to the texture
+        /// @param[in] shouldFlip whether the texture should be vertically flipped prior to rendering
+        /// @param[in] internalFormat the OpenGL internal image format for the texture
+        /// @return the newly-created texture name
+        GLuint allocate(uint32 width, uint32 height, pixmap_format format,
+                        bool shouldFlip = false, GLenum internalFormat = GL_RGBA8);
+
+        /// @brief Re-uploads a region of a pixmap into this texture, reusing the existing texture object.
+        /// @details
+        /// The region is read from `source` and written to the same position in the texture's base level
+        /// through `glTexSubImage2D`, so only the modified rows of a dynamic texture (e.g. a paint canvas,
+        /// minimap, or text layer) are transferred. Mip levels other than the base level are not updated.
+        /// The pixmap's format must match the format the texture was loaded from.
+        /// @param[in] source the pixmap the texture was loaded from; must have the same size as the texture
+        /// @param[in] region the region to upload; if empty, this function does nothing
+        /// @throw illegal_state_error if this texture is not valid
+        /// @throw std::invalid_argument if the size or format of `source` differs from the texture's
+        /// @throw std::out_of_range if the region is not fully contained in the texture
+        void update(const pixmap &source, const pixmap_rect &region);
+
+        /// @brief Re-uploads the dirty region of a @ref buffer_pixmap into this texture, and clears it.
+        /// @details Does nothing if the pixmap is not dirty.
+        /// @param[in,out] source the pixmap the texture was loaded from
+        /// @return whether any pixels were uploaded
+        /// @throw illegal_state_error if this texture is not valid
+        /// @throw std::invalid_argument if the size or format of `source` differs from the texture's
+        /// @see update(const pixmap &, const pixmap_rect &)
+        template<pixmap_format Format, typename Traits>
+        bool update(buffer_pixmap<Format, Traits> &source) {
+            if (!source.is_dirty()) return false;
+            update(source, source.get_dirty_rect());
+            source.clear_dirty();
+            return true;
+        }
+
+        /// @brief Uploads the contents of a pixmap to a position in this texture's base level.
+        /// @details
+        /// Unlike @ref update(), the source need not have the size of the texture;
+        /// this is suitable for writing tiles or glyphs into a larger texture.
+        /// @param[in] source the pixmap to upload; its format must match the texture's
+        /// @param[in] x, y the position in the texture to upload to
+        /// @throw illegal_state_error if this texture is not valid
+        /// @throw std::invalid_argument if the format of `source` differs from the texture's
+        /// @throw std::out_of_range if the source does not fit into the texture at the specified position
+        void upload(const pixmap &source, uint32 x, uint32 y);
+
+        /// @details Retrieves the width of this texture's base level, or 0 if this is not a valid texture.
+        /// @return the width of this texture
+        [[nodiscard]] uint32 get_width() const noexcept;
+
+        /// @details Retrieves the height of this texture's base level, or 0 if this is not a valid texture.
+        /// @return the height of this texture
+        [[nodiscard]] uint32 get_height() const noexcept;
+
+        /// @brief Deletes the associated OpenGL texture, making this texture invalid.
+        /// @details The category of this texture is kept. Does nothing if this texture is not valid.
+        void unload() noexcept;
+
+        /// @details Retrieves the category that this texture's video memory is accounted to.
+        /// @return the category of this texture
+        [[nodiscard]] texture_category get_category() const noexcept;
+
+        /// @brief Sets the category that this texture's video memory is accounted to.
+        /// @param[in] category the new category
+        void set_category(texture_category category) noexcept;
+
+        /// @details Retrieves the estimated video memory occupied by this texture, including all mip levels.
+        /// @return the estimated size in bytes, or 0 if this is not a valid texture
+        [[nodiscard]] std::size_t get_memory_size() const noexcept;
+
+        /// @details Retrieves the format of the pixmaps this texture is loaded from.
+        /// @return the source format of this texture
+        [[nodiscard]] pixmap_format get_format() const noexcept;
+
         /// @brief Checks if this texture should be vertically flipped prior to rendering.
         /// @details If this is not a valid texture, this function returns `false`.
         /// @return whether this texture should be vertically flipped prior to rendering
@@ -85,8 +218,51 @@ namespace musubi::gl {
     private:
         GLuint handle{0};
         bool flip{false};
+        uint32 width{0}, height{0};
+        pixmap_format format{pixmap_format::rgba8};
+        texture_category category{texture_category::general};
+        std::size_t memorySize{0};
+
+        void track_memory(GLenum internalFormat, uint32 levels) noexcept;
+
+        /// Deletes the OpenGL texture if present, and resets this texture to an invalid state.
+        void release() noexcept;
     };
 
+    /// @brief Asynchronously loads a texture through a @ref load_pipeline.
+    /// @details
+    /// The pixmap is produced by `decode()` on one of the pipeline's worker threads;
+    /// the texture is then created from it on the pipeline's finalization thread,
+    /// which must own the current OpenGL context.
+    /// @param[in] pipeline the pipeline to submit the load to
+    /// @param[in] decode a function producing the source pixmap
+    /// @param[in] shouldFlip whether the texture should be vertically flipped prior to rendering
+    /// @param[in] internalFormat the OpenGL internal image format for the loaded texture
+    /// @return a future that receives the loaded texture
+    /// @see texture::load()
+    std::future<std::shared_ptr<texture>> load_texture_async(load_pipeline &pipeline,
+                                                             std::function<std::unique_ptr<pixmap>()> decode,
+                                                             bool shouldFlip = false,
+                                                             GLenum internalFormat = GL_RGBA8);
+
+    /// @brief Asynchronously loads a mipmapped texture through a @ref load_pipeline.
+    /// @details
+    /// The pixmap is produced by `decode()` and its mip chain is built on one of the pipeline's worker threads;
+    /// all levels are then uploaded on the pipeline's finalization thread.
+    /// @param[in] pipeline the pipeline to submit the load to
+    /// @param[in] decode a function producing the base level
+    /// @param[in] filter the filter used to build the mip chain
+    /// @param[in] shouldFlip whether the texture should be vertically flipped prior to rendering
+    /// @param[in] internalFormat the OpenGL internal image format for the loaded texture
+    /// @return a future that receives the loaded texture
+    /// @see build_mip_chain()
+    /// @see texture::load(const pixmap &, span<const pixmap_view>, bool, GLenum)
+    std::future<std::shared_ptr<texture>> load_texture_async(load_pipeline &pipeline,
+                                                             std::function<std::unique_ptr<pixmap>()> decode,
+                                                             downscale_filter filter,
+                                                             bool shouldFlip = false,
+                                                             GLenum internalFormat = GL_RGBA8);
+
     /// @brief A rectangular region of a @ref texture.
     /// @details
     /// This class contains a weak pointer to a @ref texture along with two pairs of UV texture coordinates
@@ -116,10 +292,46 @@ namespace musubi::gl {
         explicit texture_region(std::weak_ptr<::musubi::gl::texture> texture) noexcept;
     };
 
+    /// @brief A sprite drawn in bulk through @ref gl_texture_renderer::batch_draw_regions().
+    struct sprite final {
+        GLfloat x{0}, y{0}; ///< @brief The position of the sprite's lower left corner.
+        GLfloat width{0}, height{0}; ///< @brief The size of the sprite.
+        GLfloat u1{0}, v1{0}, u2{1}, v2{1}; ///< @brief The texture coordinates of the drawn region.
+        GLubyte tint[4]{255, 255, 255, 255}; ///< @brief The RGBA color the texture is multiplied with.
+    };
+
+    /// @brief A compact description of a sprite, which is expanded into a quad on the GPU.
+    /// @see gl_texture_renderer::batch_draw_instances()
+    struct sprite_instance final {
+        GLfloat x{0}, y{0}; ///< @brief The position of the sprite's lower left corner, before rotation.
+        GLfloat width{0}, height{0}; ///< @brief The size of the sprite.
+        GLfloat rotation{0}; ///< @brief The counterclockwise rotation around the sprite's center, in radians.
+        GLfloat u1{0}, v1{0}, u2{1}, v2{1}; ///< @brief The texture coordinates of the drawn region.
+        GLubyte tint[4]{255, 255, 255, 255}; ///< @brief The RGBA color the texture is multiplied with.
+    };
+
+    class sprite_recorder;
+
+    class static_batch;
+
     /// @brief A @ref renderer for @ref texture "textures" and @ref texture_region "texture regions".
     /// @details
     /// This renderer processes _batches_ of draw operations.
-    /// All draw operations performed in the same batch use the same texture.
+    /// Draw operations in the same batch may use different textures: each texture is bound to its own
+    /// sampler slot, and every vertex carries the index of its slot. The pending operations are only drawn
+    /// early (in a separate draw call) once more textures are used than there are slots (see @ref get_texture_slots()),
+    /// so a batch mixing a handful of textures still takes a single draw call.
+    ///
+    /// Each quad is written as four interleaved vertices directly into a persistent @ref stream_buffer,
+    /// and drawn through an index buffer shared by all quads; batches longer than the largest indexed
+    /// draw (16384 quads) are split into multiple draw calls.
+    ///
+    /// For very large numbers of sprites, @ref batch_draw_instances() writes a single @ref sprite_instance
+    /// record per sprite instead, which the vertex shader expands into a quad (`glDrawArraysInstanced`).
+    /// Quads and instances are drawn in separate draw calls, so they should be grouped rather than interleaved.
+    ///
+    /// Quads may also be generated on worker threads through @ref sprite_recorder "sprite recorders",
+    /// which are drawn by @ref batch_draw_recorded().
     class gl_texture_renderer final : public renderer {
     private:
         LIBMUSUBI_PIMPL
@@ -127,6 +339,31 @@ namespace musubi::gl {
     public:
         LIBMUSUBI_DELCP(gl_texture_renderer)
 
+        /// @brief The largest number of textures that can be bound for a single draw call.
+        static constexpr uint32 MAX_TEXTURE_SLOTS = 16;
+
+        /// @brief The color that textures and texture regions are multiplied with by subsequent draw operations.
+        glm::vec4 tint{1, 1, 1, 1};
+
+        /// @brief The affine transformation applied to the vertices of subsequent draw operations.
+        /// @details
+        /// Unlike @ref transform, which applies to a whole draw call, this is applied on the CPU
+        /// as each quad is added to the batch, so independently transformed sprites share a single draw call.
+        /// @ref sprite_instance "Sprite instances" carry their own rotation and tint, and ignore both
+        /// this and @ref tint.
+        glm::mat3 drawTransform{1.0f};
+
+        /// @brief Whether subsequent draw operations outside the camera's view are discarded.
+        /// @details
+        /// When enabled, the bounding box of each operation is tested against the view volume of @ref camera
+        /// and @ref transform before any vertices are generated (see @ref view_culler); discarded primitives are
+        /// counted in @ref batch_stats::culled. The view volume is rebuilt on the first culled draw operation of
+        /// a batch and whenever the camera or transformation changes. This is disabled by default.
+        bool culling{false};
+
+        /// @brief The default maximum number of quads or sprite instances drawn in a single draw call.
+        static constexpr uint32 DEFAULT_MAX_BATCH_SIZE = 16384;
+
         /// @copydoc renderer()
         gl_texture_renderer() noexcept;
 
@@ -137,6 +374,13 @@ namespace musubi::gl {
         /// @details This compiles the default texture shader program and initializes a vertex array.
         void init() override;
 
+        /// @brief Begins a texture batch without a batch texture.
+        /// @details
+        /// Prepares an empty triangle mesh for rendering; textures are specified per draw operation
+        /// through @ref batch_draw_region() or @ref batch_draw_texture(const std::shared_ptr<texture> &, GLfloat, GLfloat, GLfloat, GLfloat).
+        /// @throw illegal_state_error if there is already an active batch
+        void begin_batch();
+
         /// @brief Begins a texture batch.
         /// @details Prepares an empty triangle mesh for rendering and sets the batch texture.
         /// @param[in] texture the batch texture
@@ -147,26 +391,124 @@ namespace musubi::gl {
 
         /// @brief Finalizes and renders the current batch.
         /// @details
-        /// Loads the current triangle mesh into a vertex buffer, draws it and disposes it,
+        /// Draws the pending quads from the renderer's stream buffer,
         /// then clears the batch texture.
-        /// @param[in] resetTransform whether to reset the transformation matrix after finishing the batch
+        /// @param[in] resetTransform whether to reset the transformation matrix and @ref drawTransform
+        /// after finishing the batch
         /// @throw illegal_state_error if there is no active batch
         void end_batch(bool resetTransform);
 
         /// @brief Fully draws the current batch texture.
         /// @param[in] x, y the position at which to draw the texture
         /// @param[in] width, height the desired size of the texture
-        /// @throw illegal_state_error if there is no active batch
+        /// @throw illegal_state_error if there is no active batch, or the batch has no batch texture
         void batch_draw_texture(GLfloat x, GLfloat y, GLfloat width, GLfloat height);
 
-        /// @brief Draws a region of the current batch texture.
+        /// @brief Fully draws the specified texture.
+        /// @param[in] texture the texture to draw
+        /// @param[in] x, y the position at which to draw the texture
+        /// @param[in] width, height the desired size of the texture
+        /// @throw illegal_state_error if there is no active batch
+        /// @throw invalid_argument if the specified texture pointer is empty, or its content is not a valid texture
+        void batch_draw_texture(const std::shared_ptr<texture> &texture,
+                                GLfloat x, GLfloat y, GLfloat width, GLfloat height);
+
+        /// @brief Draws part of the specified texture.
+        /// @details Equivalent to @ref batch_draw_region(), without a @ref texture_region referring to the texture.
+        /// @param[in] texture the texture to draw
+        /// @param[in] x, y the position at which to draw the texture
+        /// @param[in] width, height the desired size of the texture
+        /// @param[in] u1, v1, u2, v2 the texture coordinates of the drawn part
+        /// @throw illegal_state_error if there is no active batch
+        /// @throw invalid_argument if the specified texture pointer is empty, or its content is not a valid texture
+        void batch_draw_texture(const std::shared_ptr<texture> &texture,
+                                GLfloat x, GLfloat y, GLfloat width, GLfloat height,
+                                GLfloat u1, GLfloat v1, GLfloat u2, GLfloat v2);
+
+        /// @brief Draws a texture region.
+        /// @details The region's texture need not be the batch texture.
         /// @param[in] region the texture region to draw
         /// @param[in] x, y the position at which to draw the texture region
         /// @param[in] width,height the dimensions of the texture region
         /// @throw illegal_state_error if there is no active batch
-        /// @throw invalid_argument if the specified texture region refers to a deleted texture,
-        /// or if it does not refer to the current batch texture
+        /// @throw invalid_argument if the specified texture region refers to a deleted texture
         void batch_draw_region(const texture_region &region, GLfloat x, GLfloat y, GLfloat width, GLfloat height);
+
+        /// @brief Draws a single sprite instance.
+        /// @param[in] texture the texture to draw
+        /// @param[in] instance the sprite to draw
+        /// @throw illegal_state_error if there is no active batch
+        /// @throw invalid_argument if the specified texture pointer is empty, or its content is not a valid texture
+        /// @see batch_draw_instances()
+        void batch_draw_instance(const std::shared_ptr<texture> &texture, const sprite_instance &instance);
+
+        /// @brief Draws sprite instances of a texture.
+        /// @details
+        /// Each instance is copied into the stream buffer as-is, and expanded into a rotated, tinted quad
+        /// by the vertex shader; compared to @ref batch_draw_region(), this moves most of the per-sprite work
+        /// to the GPU and roughly halves the streamed data.
+        /// @param[in] texture the texture to draw
+        /// @param[in] instances the sprites to draw
+        /// @throw illegal_state_error if there is no active batch
+        /// @throw invalid_argument if the specified texture pointer is empty, or its content is not a valid texture
+        void batch_draw_instances(const std::shared_ptr<texture> &texture, span<const sprite_instance> instances);
+
+        /// @brief Draws sprites of a texture.
+        /// @details
+        /// Equivalent to calling @ref batch_draw_texture() with explicit texture coordinates for each sprite,
+        /// except that each sprite carries its own tint instead of using @ref tint.
+        /// The quads are generated by vectorized kernels (see @ref simd_level), which transform positions
+        /// by @ref drawTransform and flip texture coordinates for many sprites at once.
+        /// @param[in] texture the texture to draw
+        /// @param[in] sprites the sprites to draw
+        /// @throw illegal_state_error if there is no active batch
+        /// @throw invalid_argument if the specified texture pointer is empty, or its content is not a valid texture
+        void batch_draw_regions(const std::shared_ptr<texture> &texture, span<const sprite> sprites);
+
+        /// @brief Draws the sprites of an uploaded @ref static_batch, with one draw call per segment.
+        /// @details
+        /// The batch is drawn under the current @ref camera and @ref transform; its vertices are not touched.
+        /// If there is an active batch, its pending operations are drawn first. With @ref culling enabled,
+        /// segments whose bounds are outside the view are skipped.
+        /// @param[in] batch the static batch to draw
+        /// @throw illegal_state_error if the static batch has not been uploaded
+        void draw_static(const static_batch &batch);
+
+        /// @brief Draws the sprites recorded by a @ref sprite_recorder.
+        /// @details
+        /// The recorded vertices are copied into the stream buffer as-is, only assigning their sampler slots;
+        /// recorders drawn consecutively in the same batch share a single upload and, texture slots permitting,
+        /// a single draw call. The recorder is not cleared.
+        /// With @ref culling enabled, recorded quads outside the view are skipped while copying.
+        /// @param[in] recorder the recorder to draw; it must not be recorded into concurrently
+        /// @throw illegal_state_error if there is no active batch
+        void batch_draw_recorded(const sprite_recorder &recorder);
+
+        /// @details Retrieves the maximum number of quads or sprite instances drawn in a single draw call.
+        /// @return the maximum batch size
+        [[nodiscard]] uint32 get_max_batch_size() const noexcept;
+
+        /// @brief Sets the maximum number of quads or sprite instances drawn in a single draw call.
+        /// @details
+        /// Once a batch reaches this size, its pending operations are drawn early, bounding the size of each upload.
+        /// Quads are additionally limited to 16384 per draw call by their 16-bit indices.
+        /// @param[in] sprites the maximum batch size
+        /// @throw std::invalid_argument if `sprites` is zero
+        void set_max_batch_size(uint32 sprites);
+
+        /// @details Retrieves the draw statistics accumulated since the last call to @ref reset_stats().
+        /// @return a snapshot of this renderer's statistics
+        [[nodiscard]] batch_stats get_stats() const noexcept;
+
+        /// @brief Resets the draw statistics; typically called once per frame.
+        void reset_stats() noexcept;
+
+        /// @details
+        /// Retrieves the number of textures that can be used in a single draw call;
+        /// this is limited by @ref MAX_TEXTURE_SLOTS and the number of texture units of the OpenGL implementation.
+        /// This is only valid after @ref init() has been called.
+        /// @return the number of sampler slots
+        [[nodiscard]] uint32 get_texture_slots() const noexcept;
     };
 }
 
@@ -0,0 +1,117 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#ifndef MUSUBI_LOAD_PIPELINE_H
+#define MUSUBI_LOAD_PIPELINE_H
+
+#include "musubi/common.h"
+#include "musubi/frame_task_queue.h"
+#include "musubi/thread_pool.h"
+
+#include <atomic>
+#include <exception>
+#include <future>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace musubi {
+    /// @brief A two-phase asset loading pipeline.
+    /// @details
+    /// Loads are split into a _decode_ phase, which runs on a @ref thread_pool,
+    /// and a _finalize_ phase, which receives the decoded value and runs on a @ref frame_task_queue
+    /// (typically the queue of the @ref window that owns the graphics context; see @ref window::get_task_queue()).
+    ///
+    /// This allows CPU-heavy work (such as decoding an image into a @ref buffer_pixmap)
+    /// to overlap with rendering, while GPU-backed objects (such as @ref gl::texture "textures")
+    /// are still created on the thread that owns the graphics context,
+    /// within that queue's per-frame time budget.
+    ///
+    /// The thread pool and the task queue must outlive all loads submitted to a pipeline.
+    class load_pipeline final {
+    public:
+        LIBMUSUBI_DELCP(load_pipeline)
+
+        /// @brief Constructs a pipeline from a worker pool and a finalization queue.
+        /// @param[in] workers the thread pool used to execute decode phases
+        /// @param[in] finalizers the task queue used to execute finalize phases
+        load_pipeline(thread_pool &workers, frame_task_queue &finalizers) noexcept
+                : workers(workers), finalizers(finalizers), pending(std::make_shared<std::atomic<std::size_t>>(0)) {}
+
+        /// @brief Submits a two-phase load.
+        /// @details
+        /// `decode()` is invoked on a worker thread; its result is then moved into `finalize()`,
+        /// which is invoked on the finalization queue's owning thread.
+        /// If `decode()` throws, `finalize()` is never invoked.
+        /// @tparam Decode the decode callable type, invocable with no arguments
+        /// @tparam Finalize the finalize callable type, invocable with the result of Decode
+        /// @param[in] decode the decode phase
+        /// @param[in] finalize the finalize phase
+        /// @return a future that receives the result of `finalize()`, or the exception thrown by either phase
+        template<typename Decode, typename Finalize>
+        auto submit(Decode &&decode, Finalize &&finalize) {
+            using decoded_type = std::invoke_result_t<std::decay_t<Decode>>;
+            using result_type = std::invoke_result_t<std::decay_t<Finalize>, decoded_type &&>;
+
+            auto promise = std::make_shared<std::promise<result_type>>();
+            auto future = promise->get_future();
+            // Both phases are shared, since tasks must be copyable but callables may be move-only
+            auto decodeFunction = std::make_shared<std::decay_t<Decode>>(std::forward<Decode>(decode));
+            auto finalizeFunction = std::make_shared<std::decay_t<Finalize>>(std::forward<Finalize>(finalize));
+
+            // Both phases share the load's guard; the load stops being pending once neither phase is alive,
+            // which includes phases that are discarded without running when the pool or the queue is destroyed
+            auto guard = std::make_shared<pending_guard>(pending);
+            workers.post([decodeFunction, finalizeFunction, promise, guard, &finalizers = finalizers]() {
+                try {
+                    auto decoded = std::make_shared<decoded_type>((*decodeFunction)());
+                    finalizers.post([decoded, finalizeFunction, promise, guard]() {
+                        try {
+                            if constexpr (std::is_void_v<result_type>) {
+                                (*finalizeFunction)(std::move(*decoded));
+                                promise->set_value();
+                            } else {
+                                promise->set_value((*finalizeFunction)(std::move(*decoded)));
+                            }
+                        } catch (...) {
+                            promise->set_exception(std::current_exception());
+                        }
+                    });
+                } catch (...) {
+                    promise->set_exception(std::current_exception());
+                }
+            });
+
+            return future;
+        }
+
+        /// @details
+        /// Retrieves the number of submitted loads that have not completed yet.
+        /// Loads whose phases were discarded (because the thread pool or the task queue was destroyed)
+        /// are no longer counted.
+        /// @return the number of pending loads
+        [[nodiscard]] std::size_t get_pending() const noexcept { return *pending; }
+
+        /// @details Retrieves the thread pool that decode phases run on.
+        /// @return the thread pool of this pipeline
+        [[nodiscard]] thread_pool &get_workers() const noexcept { return workers; }
+
+    private:
+        /// Counts a load as pending for the lifetime of the guard.
+        struct pending_guard final {
+            std::shared_ptr<std::atomic<std::size_t>> pending;
+
+            explicit pending_guard(std::shared_ptr<std::atomic<std::size_t>> pending) noexcept
+                    : pending(std::move(pending)) { ++*this->pending; }
+
+            ~pending_guard() noexcept { --*pending; }
+        };
+
+        thread_pool &workers;
+        frame_task_queue &finalizers;
+        std::shared_ptr<std::atomic<std::size_t>> pending;
+    };
+}
+
+#endif //MUSUBI_LOAD_PIPELINE_H
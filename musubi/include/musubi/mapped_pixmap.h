@@ -0,0 +1,139 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#ifndef MUSUBI_MAPPED_PIXMAP_H
+#define MUSUBI_MAPPED_PIXMAP_H
+
+#include "musubi/common.h"
+#include "musubi/pixmap.h"
+
+#include <cstddef>
+#include <filesystem>
+
+namespace musubi {
+    /// @brief A @ref pixmap backed by a memory-mapped raw image file.
+    /// @details
+    /// The pixel data is not read into memory up front; the operating system pages it in
+    /// as it is accessed, and may evict it again under memory pressure.
+    /// This allows very large images (e.g. world maps or baked lightmaps) to be sampled,
+    /// cropped with a @ref pixmap_view and uploaded tile by tile without reading the entire file.
+    ///
+    /// Files consist of a 32-byte header followed by the pixel rows; all header fields are little-endian:
+    /// <table>
+    /// <caption>Mapped pixmap file header</caption>
+    /// <tr><th>Offset</th><th>Size</th><th>Field</th></tr>
+    /// <tr><td>0</td><td>4</td><td>Magic bytes `MPXM`</td></tr>
+    /// <tr><td>4</td><td>2</td><td>Version (currently 1)</td></tr>
+    /// <tr><td>6</td><td>1</td><td>@ref pixmap_format</td></tr>
+    /// <tr><td>7</td><td>1</td><td>Reserved (0)</td></tr>
+    /// <tr><td>8</td><td>4</td><td>Width in pixels</td></tr>
+    /// <tr><td>12</td><td>4</td><td>Height in pixels</td></tr>
+    /// <tr><td>16</td><td>8</td><td>Row stride in bytes</td></tr>
+    /// <tr><td>24</td><td>8</td><td>Offset of the first row from the start of the file</td></tr>
+    /// </table>
+    /// Packed pixel formats are stored in the byte order of the machine that wrote the file.
+    ///
+    /// Mapped pixmaps are currently only supported on POSIX systems.
+    class mapped_pixmap final : public pixmap {
+    public:
+        /// @brief The access mode of a mapping.
+        enum class access_mode : uint8 {
+            read_only, ///< The mapping can only be read
+            read_write ///< The mapping can be modified; modifications are written back to the file
+        };
+
+        /// @brief The size of the file header, in bytes.
+        static constexpr std::size_t HEADER_SIZE = 32u;
+
+        LIBMUSUBI_DELCP(mapped_pixmap)
+
+        /// @brief Maps an existing raw image file.
+        /// @param[in] path the path to the file
+        /// @param[in] mode the access mode of the mapping
+        /// @throw resource_read_error if the file cannot be opened or mapped,
+        /// or if its header is invalid or does not match its size
+        explicit mapped_pixmap(const std::filesystem::path &path, access_mode mode = access_mode::read_only);
+
+        /// @details Move constructor; `other` becomes an empty, unmapped pixmap.
+        /// @param[in,out] other the pixmap to move from
+        mapped_pixmap(mapped_pixmap &&other) noexcept;
+
+        /// @details Move assignment operator; `other` becomes an empty, unmapped pixmap.
+        /// @param[in,out] other the pixmap to move from
+        /// @return this
+        mapped_pixmap &operator=(mapped_pixmap &&other) noexcept;
+
+        /// @brief Unmaps the file.
+        /// @details Modifications of a read-write mapping are written back by the operating system.
+        ~mapped_pixmap() noexcept override;
+
+        /// @brief Creates a raw image file of the specified size and maps it for reading and writing.
+        /// @details The file is overwritten if it exists. Its pixel data is initially zero.
+        /// @param[in] path the path to the file
+        /// @param[in] format the pixel format
+        /// @param[in] width, height the size of the image
+        /// @param[in] rowAlignment the alignment of each row in bytes; must be a power of two
+        /// @return the mapped pixmap
+        /// @throw resource_write_error if the file cannot be created or mapped
+        /// @throw std::invalid_argument if the row alignment is not a power of two
+        [[nodiscard]] static mapped_pixmap create(const std::filesystem::path &path, pixmap_format format,
+                                                  uint32 width, uint32 height, std::size_t rowAlignment = 1);
+
+        /// @brief Writes a pixmap to a raw image file, which can then be mapped.
+        /// @details The file is overwritten if it exists. Rows are written tightly packed.
+        /// @param[in] path the path to the file
+        /// @param[in] source the pixmap to write
+        /// @throw resource_write_error if the file cannot be written
+        static void write(const std::filesystem::path &path, const pixmap &source);
+
+        [[nodiscard]] uint32 get_width() const override { return width; }
+
+        [[nodiscard]] uint32 get_height() const override { return height; }
+
+        [[nodiscard]] const byte *data() const override { return pixels; }
+
+        [[nodiscard]] pixmap_format get_format() const override { return format; }
+
+        [[nodiscard]] std::size_t get_stride() const override { return stride; }
+
+        /// @brief Retrieves a mutable pointer to this pixmap's data.
+        /// @details Unlike @ref buffer_pixmap, this is not an overload of @ref data(),
+        /// so that reading from a non-const, read-only mapping does not throw.
+        /// @return a mutable pointer to the mapped pixel data
+        /// @throw illegal_state_error if this is a read-only mapping
+        [[nodiscard]] byte *mutable_data();
+
+        /// @details Retrieves the access mode of this mapping.
+        /// @return the access mode
+        [[nodiscard]] access_mode get_access_mode() const noexcept { return mode; }
+
+        /// @brief Hints that a range of rows will be accessed soon.
+        /// @details
+        /// The operating system may start reading the rows in the background, so that a subsequent
+        /// access (such as a tile upload) does not stall on page faults. This never blocks.
+        /// @param[in] firstRow the first row of the range
+        /// @param[in] rowCount the number of rows; clipped to the height of this pixmap
+        void prefetch_rows(uint32 firstRow, uint32 rowCount) const noexcept;
+
+        /// @brief Synchronously writes modifications of a read-write mapping back to the file.
+        /// @details Does nothing for read-only mappings.
+        /// @throw resource_write_error if the modifications cannot be written
+        void flush();
+
+    private:
+        mapped_pixmap() noexcept = default;
+
+        void unmap() noexcept;
+
+        byte *mapping{nullptr};
+        std::size_t mappingSize{0};
+        byte *pixels{nullptr};
+        uint32 width{0}, height{0};
+        std::size_t stride{0};
+        pixmap_format format{pixmap_format::r8};
+        access_mode mode{access_mode::read_only};
+    };
+}
+
+#endif //MUSUBI_MAPPED_PIXMAP_H
@@ -0,0 +1,91 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#ifndef MUSUBI_MIPMAP_H
+#define MUSUBI_MIPMAP_H
+
+#include "musubi/common.h"
+#include "musubi/pixmap.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace musubi {
+    /// @brief The resampling filter used to downscale pixmaps.
+    enum class downscale_filter : uint8 {
+        box, ///< Averages 2x2 blocks of pixels; fast, and sufficient for most textures
+        lanczos3 ///< Windowed sinc filter with 3 lobes; sharper, at a higher cost
+    };
+
+    /// @brief Retrieves the number of levels in a full mip chain of an image, including the base level.
+    /// @param[in] width, height the size of the base level
+    /// @return the number of mip levels
+    constexpr uint32 get_mip_level_count(uint32 width, uint32 height) noexcept {
+        uint32 count = 1;
+        for (auto size = std::max(width, height); size > 1; size /= 2) ++count;
+        return count;
+    }
+
+    namespace detail {
+        /// @brief Downscales a view to half its size (rounded down, at least 1) into a destination buffer.
+        void downscale_pixels(const pixmap_view &source, byte *dst, std::size_t dstStride,
+                              downscale_filter filter, thread_pool *pool);
+    }
+
+    /// @brief Creates a copy of a pixmap downscaled to half its size.
+    /// @details
+    /// Each dimension is halved and rounded down, but is at least 1.
+    /// If a thread pool is specified, rows are split across its workers.
+    /// @tparam Format the format of the source and the result
+    /// @param[in] source the pixmap to downscale
+    /// @param[in] filter the resampling filter to use
+    /// @param[in] pool the thread pool to split rows across, or null to downscale on the calling thread
+    /// @return the downscaled pixmap
+    /// @throw std::invalid_argument if the source format differs from `Format`
+    template<pixmap_format Format>
+    [[nodiscard]] buffer_pixmap<Format> downscale_half(const pixmap_view &source,
+                                                       downscale_filter filter = downscale_filter::box,
+                                                       thread_pool *pool = nullptr) {
+        if (source.get_format() != Format) {
+            throw std::invalid_argument("Cannot downscale pixmap; source and destination formats differ");
+        }
+        buffer_pixmap<Format> result(std::max<uint32>(source.get_width() / 2, 1),
+                                     std::max<uint32>(source.get_height() / 2, 1));
+        if (source.data()) {
+            result.ensure_buffer();
+            detail::downscale_pixels(source, result.data(), result.get_stride(), filter, pool);
+        }
+        return result;
+    }
+
+    /// @brief Builds the mip chain of a pixmap.
+    /// @details
+    /// The returned levels exclude the base level; level `i` of the result is mip level `i + 1`,
+    /// and the last level is 1x1 pixels. Each level is downscaled from the previous one.
+    /// If a thread pool is specified, the rows of each level are split across its workers.
+    /// @tparam Format the format of the source and the result
+    /// @param[in] base the base level
+    /// @param[in] filter the resampling filter to use
+    /// @param[in] pool the thread pool to split rows across, or null to build the chain on the calling thread
+    /// @return mip levels 1 and onward
+    /// @throw std::invalid_argument if the source format differs from `Format`
+    /// @see get_mip_level_count()
+    template<pixmap_format Format>
+    [[nodiscard]] std::vector<buffer_pixmap<Format>> build_mip_chain(const pixmap_view &base,
+                                                                     downscale_filter filter = downscale_filter::box,
+                                                                     thread_pool *pool = nullptr) {
+        std::vector<buffer_pixmap<Format>> levels;
+        levels.reserve(get_mip_level_count(base.get_width(), base.get_height()) - 1);
+
+        // Views refer to pixel data, which remains in place when levels are moved
+        auto previous = base;
+        while (previous.get_width() > 1 || previous.get_height() > 1) {
+            previous = levels.emplace_back(downscale_half<Format>(previous, filter, pool));
+        }
+        return levels;
+    }
+}
+
+#endif //MUSUBI_MIPMAP_H
@@ -7,16 +7,27 @@
 
 #include "musubi/common.h"
 #include "musubi/exception.h"
+#include "musubi/pixmap_pool.h"
+#include "musubi/span.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <exception>
+#include <functional>
 #include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
 #include <vector>
 #include <type_traits>
 
 namespace musubi {
     using std::byte;
 
+    class thread_pool;
+
     namespace detail {
         template<std::size_t bytes>
         using smallest_integral_t = std::conditional_t<
@@ -31,11 +42,41 @@ namespace musubi {
                 >
         >;
 
+        /// Traits for formats storing their components bytewise; values are stored most-significant byte first.
         template<std::size_t bytes>
         struct fundamental_pixmap_traits {
             static_assert(bytes <= 8u, "bytes must be within the bounds of fundamental integral types");
             using element_type = smallest_integral_t<bytes>;
             static constexpr std::size_t bytes_per_pixel = bytes;
+
+            static element_type load(const std::byte *ptr) noexcept {
+                element_type result{0u};
+                for (std::size_t i = 0; i < bytes; ++i) {
+                    result |= static_cast<element_type>(static_cast<element_type>(ptr[i]) << ((bytes - i - 1) * 8));
+                }
+                return result;
+            }
+
+            static void store(std::byte *ptr, element_type value) noexcept {
+                for (std::size_t i = 0; i < bytes; ++i) {
+                    ptr[i] = static_cast<std::byte>((value >> ((bytes - i - 1) * 8)) & 0xFFu);
+                }
+            }
+        };
+
+        /// Traits for formats packing their components into a single integer, stored in native byte order.
+        template<typename Element>
+        struct packed_pixmap_traits {
+            using element_type = Element;
+            static constexpr std::size_t bytes_per_pixel = sizeof(Element);
+
+            static element_type load(const std::byte *ptr) noexcept {
+                element_type result;
+                std::memcpy(&result, ptr, sizeof(result));
+                return result;
+            }
+
+            static void store(std::byte *ptr, element_type value) noexcept { std::memcpy(ptr, &value, sizeof(value)); }
         };
     }
 
@@ -44,13 +85,212 @@ namespace musubi {
     enum class pixmap_format : uint8 {
         r8, ///< 8 bits, single-channel
         rgb8, ///< 24 bits, 3 channels
-        rgba8 ///< 32 bits, 4 channels
+        rgba8, ///< 32 bits, 4 channels
+        rgb565, ///< 16 bits, 3 channels packed into a native-endian integer (5 bits red, 6 green, 5 blue)
+        rgba4444, ///< 16 bits, 4 channels packed into a native-endian integer (4 bits each)
+        rgba5551, ///< 16 bits, 4 channels packed into a native-endian integer (5 bits per color, 1 bit alpha)
+        la8 ///< 16 bits, 2 channels (luminance and alpha)
+    };
+
+    /// @brief Checks if a format packs its components into a native-endian integer.
+    /// @details Packed pixels cannot be processed bytewise; see @ref detail::packed_pixmap_traits.
+    /// @param[in] format the pixmap format
+    /// @return whether the format is packed
+    constexpr bool is_packed_format(pixmap_format format) noexcept {
+        return format == pixmap_format::rgb565 || format == pixmap_format::rgba4444 || format == pixmap_format::rgba5551;
+    }
+
+    /// @brief A single @ref pixmap_format::r8 pixel, as stored in memory.
+    struct r8_pixel {
+        std::uint8_t r;
+
+        /// @details Creates a pixel from its value, as accepted by @ref buffer_pixmap::set_pixel().
+        static constexpr r8_pixel from_value(uint32 value) noexcept {
+            return {static_cast<std::uint8_t>(value & 0xFFu)};
+        }
+
+        /// @details Retrieves the value of this pixel, as returned by @ref buffer_pixmap::get_pixel().
+        [[nodiscard]] constexpr uint32 to_value() const noexcept { return r; }
+    };
+
+    /// @brief A single @ref pixmap_format::rgb8 pixel, as stored in memory.
+    struct rgb8_pixel {
+        std::uint8_t r, g, b;
+
+        /// @copydoc r8_pixel::from_value()
+        static constexpr rgb8_pixel from_value(uint32 value) noexcept {
+            return {static_cast<std::uint8_t>((value >> 16u) & 0xFFu),
+                    static_cast<std::uint8_t>((value >> 8u) & 0xFFu),
+                    static_cast<std::uint8_t>(value & 0xFFu)};
+        }
+
+        /// @copydoc r8_pixel::to_value()
+        [[nodiscard]] constexpr uint32 to_value() const noexcept { return rgb8(r, g, b); }
+    };
+
+    /// @brief A single @ref pixmap_format::rgba8 pixel, as stored in memory.
+    struct rgba8_pixel {
+        std::uint8_t r, g, b, a;
+
+        /// @copydoc r8_pixel::from_value()
+        static constexpr rgba8_pixel from_value(uint32 value) noexcept {
+            return {static_cast<std::uint8_t>((value >> 24u) & 0xFFu),
+                    static_cast<std::uint8_t>((value >> 16u) & 0xFFu),
+                    static_cast<std::uint8_t>((value >> 8u) & 0xFFu),
+                    static_cast<std::uint8_t>(value & 0xFFu)};
+        }
+
+        /// @copydoc r8_pixel::to_value()
+        [[nodiscard]] constexpr uint32 to_value() const noexcept { return rgba8(r, g, b, a); }
+    };
+
+    /// @brief A single @ref pixmap_format::rgb565 pixel, as stored in memory.
+    struct rgb565_pixel {
+        std::uint16_t value;
+
+        /// @copydoc r8_pixel::from_value()
+        static constexpr rgb565_pixel from_value(uint32 value) noexcept {
+            return {static_cast<std::uint16_t>(value & 0xFFFFu)};
+        }
+
+        /// @copydoc r8_pixel::to_value()
+        [[nodiscard]] constexpr uint32 to_value() const noexcept { return value; }
+    };
+
+    /// @brief A single @ref pixmap_format::rgba4444 pixel, as stored in memory.
+    struct rgba4444_pixel {
+        std::uint16_t value;
+
+        /// @copydoc r8_pixel::from_value()
+        static constexpr rgba4444_pixel from_value(uint32 value) noexcept {
+            return {static_cast<std::uint16_t>(value & 0xFFFFu)};
+        }
+
+        /// @copydoc r8_pixel::to_value()
+        [[nodiscard]] constexpr uint32 to_value() const noexcept { return value; }
+    };
+
+    /// @brief A single @ref pixmap_format::rgba5551 pixel, as stored in memory.
+    struct rgba5551_pixel {
+        std::uint16_t value;
+
+        /// @copydoc r8_pixel::from_value()
+        static constexpr rgba5551_pixel from_value(uint32 value) noexcept {
+            return {static_cast<std::uint16_t>(value & 0xFFFFu)};
+        }
+
+        /// @copydoc r8_pixel::to_value()
+        [[nodiscard]] constexpr uint32 to_value() const noexcept { return value; }
+    };
+
+    /// @brief A single @ref pixmap_format::la8 pixel, as stored in memory.
+    struct la8_pixel {
+        std::uint8_t l, a;
+
+        /// @copydoc r8_pixel::from_value()
+        static constexpr la8_pixel from_value(uint32 value) noexcept {
+            return {static_cast<std::uint8_t>((value >> 8u) & 0xFFu), static_cast<std::uint8_t>(value & 0xFFu)};
+        }
+
+        /// @copydoc r8_pixel::to_value()
+        [[nodiscard]] constexpr uint32 to_value() const noexcept { return (uint32{l} << 8u) | a; }
+    };
+
+    /// @brief Creates a 16-bit packed RGB565 color from 8-bit red, green, and blue values.
+    /// @details Components are truncated to their packed bit depth.
+    /// @param r, g, b the 8-bit RGB values
+    /// @return the packed color, as accepted by `buffer_pixmap<pixmap_format::rgb565>::set_pixel()`
+    constexpr uint32 rgb565(uint8 r, uint8 g, uint8 b) {
+        return ((r & 0xF8u) << 8u) | ((g & 0xFCu) << 3u) | ((b & 0xF8u) >> 3u);
+    }
+
+    /// @brief Creates a 16-bit packed RGBA4444 color from 8-bit red, green, blue, and alpha values.
+    /// @details Components are truncated to their packed bit depth.
+    /// @param r, g, b, a the 8-bit RGBA values
+    /// @return the packed color, as accepted by `buffer_pixmap<pixmap_format::rgba4444>::set_pixel()`
+    constexpr uint32 rgba4444(uint8 r, uint8 g, uint8 b, uint8 a = 255u) {
+        return ((r & 0xF0u) << 8u) | ((g & 0xF0u) << 4u) | (b & 0xF0u) | ((a & 0xF0u) >> 4u);
+    }
+
+    /// @brief Creates a 16-bit packed RGBA5551 color from 8-bit red, green, blue, and alpha values.
+    /// @details Components are truncated to their packed bit depth.
+    /// @param r, g, b, a the 8-bit RGBA values
+    /// @return the packed color, as accepted by `buffer_pixmap<pixmap_format::rgba5551>::set_pixel()`
+    constexpr uint32 rgba5551(uint8 r, uint8 g, uint8 b, uint8 a = 255u) {
+        return ((r & 0xF8u) << 8u) | ((g & 0xF8u) << 3u) | ((b & 0xF8u) >> 2u) | ((a & 0x80u) >> 7u);
+    }
+
+    /// @brief Retrieves the number of bytes used to store each pixel of the specified format.
+    /// @param[in] format the pixmap format
+    /// @return the number of bytes per pixel
+    /// @see pixmap_traits
+    constexpr std::size_t get_bytes_per_pixel(pixmap_format format) {
+        switch (format) {
+            case pixmap_format::r8:
+                return 1u;
+            case pixmap_format::rgb8:
+                return 3u;
+            case pixmap_format::rgba8:
+                return 4u;
+            case pixmap_format::rgb565:
+            case pixmap_format::rgba4444:
+            case pixmap_format::rgba5551:
+            case pixmap_format::la8:
+                return 2u;
+            default:
+                throw assertion_error(
+                        "Cannot determine pixel size of unknown pixmap_format "s +
+                        std::to_string(static_cast<std::underlying_type_t<pixmap_format>>(format))
+                );
+        }
+    }
+
+    /// @brief An axis-aligned rectangle of pixels.
+    struct pixmap_rect final {
+        uint32 x{0}, y{0}; ///< @brief The position of the top-left pixel.
+        uint32 width{0}, height{0}; ///< @brief The size of the rectangle.
+
+        /// @details Checks if this rectangle contains no pixels.
+        /// @return whether this rectangle is empty
+        [[nodiscard]] constexpr bool empty() const noexcept { return width == 0 || height == 0; }
+
+        /// @brief Computes the bounding rectangle of this rectangle and another.
+        /// @details Empty rectangles do not contribute to the result.
+        /// @param[in] other the other rectangle
+        /// @return the smallest rectangle containing both rectangles
+        [[nodiscard]] constexpr pixmap_rect united(const pixmap_rect &other) const noexcept {
+            if (empty()) return other;
+            if (other.empty()) return *this;
+            const auto left = std::min(x, other.x), top = std::min(y, other.y);
+            const auto right = std::max(x + width, other.x + other.width);
+            const auto bottom = std::max(y + height, other.y + other.height);
+            return {left, top, right - left, bottom - top};
+        }
+
+        /// @brief Computes the intersection of this rectangle and another.
+        /// @param[in] other the other rectangle
+        /// @return the largest rectangle contained in both rectangles, which may be empty
+        [[nodiscard]] constexpr pixmap_rect intersected(const pixmap_rect &other) const noexcept {
+            const auto left = std::max(x, other.x), top = std::max(y, other.y);
+            const auto right = std::min(x + width, other.x + other.width);
+            const auto bottom = std::min(y + height, other.y + other.height);
+            if (left >= right || top >= bottom) return {};
+            return {left, top, right - left, bottom - top};
+        }
+
+        [[nodiscard]] constexpr bool operator==(const pixmap_rect &other) const noexcept {
+            return x == other.x && y == other.y && width == other.width && height == other.height;
+        }
+
+        [[nodiscard]] constexpr bool operator!=(const pixmap_rect &other) const noexcept { return !(*this == other); }
     };
 
     /// @brief A common interface for pixmap images.
     /// @details
-    /// Implementations are required to use contiguous, uniform storage;
-    /// @ref data() should return a contiguous array of uniform element size.
+    /// Implementations are required to use uniform row-major storage;
+    /// @ref data() should return a pointer to the first row, and each row must be stored contiguously.
+    /// Consecutive rows are @ref get_stride() bytes apart, which may be larger than
+    /// the size of a row's pixel data (e.g. for padded rows, or for a @ref pixmap_view of a larger pixmap).
     ///
     /// Pixmaps have a specified @ref pixmap_format and support retrieval of pixel data by position.
     class pixmap {
@@ -73,8 +313,133 @@ namespace musubi {
         /// @details Retrieves this pixmap's @ref pixmap_format "data format".
         /// @return this pixmap's data format
         [[nodiscard]] virtual pixmap_format get_format() const = 0;
+
+        /// @brief Retrieves the distance between the starts of two consecutive rows, in bytes.
+        /// @details The default implementation returns the size of a tightly-packed row.
+        /// @return this pixmap's row stride in bytes
+        [[nodiscard]] virtual std::size_t get_stride() const;
+    };
+
+    /// @brief A non-owning, read-only @ref pixmap referring to a rectangular region of pixel data.
+    /// @details
+    /// Views carry an explicit row stride, and can therefore describe sub-rectangles of
+    /// any other pixmap without copying its data.
+    /// A view must not outlive the data it refers to.
+    class pixmap_view final : public pixmap {
+    public:
+        /// @brief Constructs a view of the specified pixel data.
+        /// @param[in] data a pointer to the first pixel of the first row
+        /// @param[in] format the format of the pixel data
+        /// @param[in] width, height the size of the view
+        /// @param[in] stride the distance between the starts of two consecutive rows in bytes,
+        /// or 0 for tightly-packed rows
+        pixmap_view(const byte *data, pixmap_format format, uint32 width, uint32 height, std::size_t stride = 0)
+                : ptr(data), width(width), height(height),
+                  stride(stride == 0 ? width * get_bytes_per_pixel(format) : stride), format(format) {}
+
+        /// @brief Constructs a view of an entire pixmap.
+        /// @param[in] source the pixmap to view
+        pixmap_view(const pixmap &source) // NOLINT(google-explicit-constructor,hicpp-explicit-conversions)
+                : ptr(source.data()), width(source.get_width()), height(source.get_height()),
+                  stride(source.get_stride()), format(source.get_format()) {}
+
+        /// @brief Constructs a view of a rectangular region of a pixmap.
+        /// @param[in] source the pixmap to view
+        /// @param[in] x, y the position of the region
+        /// @param[in] width, height the size of the region
+        /// @throw std::out_of_range if the region is not fully contained in the source pixmap
+        pixmap_view(const pixmap &source, uint32 x, uint32 y, uint32 width, uint32 height)
+                : pixmap_view(pixmap_view(source).sub_view(x, y, width, height)) {}
+
+        /// @details Copy constructor.
+        /// @param[in] other the view to copy from
+        pixmap_view(const pixmap_view &other) = default;
+
+        /// @details Copy assignment operator.
+        /// @param[in] other the view to copy from
+        /// @return this
+        pixmap_view &operator=(const pixmap_view &other) = default;
+
+        /// @copydoc pixmap::~pixmap()
+        ~pixmap_view() override = default;
+
+        [[nodiscard]] uint32 get_width() const override { return width; }
+
+        [[nodiscard]] uint32 get_height() const override { return height; }
+
+        [[nodiscard]] const byte *data() const override { return ptr; }
+
+        [[nodiscard]] pixmap_format get_format() const override { return format; }
+
+        [[nodiscard]] std::size_t get_stride() const override { return stride; }
+
+        /// @brief Constructs a view of a rectangular region of a pixmap.
+        /// @param[in] source the pixmap to view
+        /// @param[in] region the region to view
+        /// @throw std::out_of_range if the region is not fully contained in the source pixmap
+        pixmap_view(const pixmap &source, const pixmap_rect &region)
+                : pixmap_view(source, region.x, region.y, region.width, region.height) {}
+
+        /// @brief Creates a view of a rectangular region of this view.
+        /// @param[in] x, y the position of the region, relative to this view
+        /// @param[in] width, height the size of the region
+        /// @return a view of the specified region
+        /// @throw std::out_of_range if the region is not fully contained in this view
+        [[nodiscard]] pixmap_view sub_view(uint32 x, uint32 y, uint32 width, uint32 height) const {
+            if (x > this->width || width > this->width - x) {
+                throw std::out_of_range(
+                        "view x range out of pixmap range: "s + std::to_string(x) + " + "s + std::to_string(width)
+                        + " > "s + std::to_string(this->width)
+                );
+            } else if (y > this->height || height > this->height - y) {
+                throw std::out_of_range(
+                        "view y range out of pixmap range: "s + std::to_string(y) + " + "s + std::to_string(height)
+                        + " > "s + std::to_string(this->height)
+                );
+            }
+            // Views of unallocated pixmaps remain empty
+            const auto offset = ptr ? ptr + y * stride + x * get_bytes_per_pixel(format) : nullptr;
+            return pixmap_view(offset, format, width, height, stride);
+        }
+
+        /// @details Retrieves a const pointer to the first pixel of the specified row.
+        /// @param[in] y the row index; this is not bounds-checked
+        /// @return a const pointer to the specified row
+        [[nodiscard]] const byte *row_data(uint32 y) const noexcept { return ptr + y * stride; }
+
+    private:
+        const byte *ptr;
+        uint32 width, height;
+        std::size_t stride;
+        pixmap_format format;
+    };
+
+    /// @brief The way in which source pixels are combined with destination pixels when blitting.
+    /// @see buffer_pixmap::blit()
+    enum class blend_mode : uint8 {
+        copy, ///< Source pixels replace destination pixels, converting between formats if necessary
+        /// Non-premultiplied source-over (Porter-Duff _over_) alpha blending, which takes the destination's alpha
+        /// into account; requires @ref pixmap_format::rgba8 on both sides
+        source_over
     };
 
+    namespace detail {
+        /// @brief Fills a rectangle of pixels with a single pixel value.
+        /// @details `pixel` points to the bytes of one pixel, in memory order.
+        void fill_pixels(byte *dst, std::size_t stride, pixmap_format format,
+                         uint32 width, uint32 height, const byte *pixel);
+
+        /// @brief Copies or blends a view into a destination rectangle of the same size.
+        /// @throw std::invalid_argument if the formats are not supported by the specified blend mode
+        void copy_pixels(byte *dst, std::size_t stride, pixmap_format format,
+                         const pixmap_view &source, blend_mode mode);
+
+        /// @brief Splits the rows `[0, rows)` into consecutive ranges, visited across a thread pool's workers.
+        /// @details `visitRows` is invoked as `visitRows(first, last)`; see @ref thread_pool::parallel_for().
+        void parallel_rows(thread_pool &pool, uint32 rows,
+                           const std::function<void(std::size_t, std::size_t)> &visitRows);
+    }
+
     /// @brief A template providing compile-time storage traits for @ref pixmap_format "pixmap_formats".
     /// @details
     /// Implementations should define the following symbols:
@@ -94,19 +459,63 @@ namespace musubi {
     ///     <td>`bytes_per_pixel`</td>
     ///     <td>The number of bytes used to store each pixel.</td>
     /// </tr>
+    /// <tr>
+    ///     <td>`typedef`</td>
+    ///     <td>`pixel_type`</td>
+    ///     <td>
+    ///         A trivial type with the exact size and layout of a single pixel in memory.
+    ///         Used for unchecked row access (see @ref buffer_pixmap::row()).
+    ///     </td>
+    /// </tr>
+    /// <tr>
+    ///     <td>`static element_type`</td>
+    ///     <td>`load(const byte *)`</td>
+    ///     <td>Reads the value of a single pixel from memory.</td>
+    /// </tr>
+    /// <tr>
+    ///     <td>`static void`</td>
+    ///     <td>`store(byte *, element_type)`</td>
+    ///     <td>Writes the value of a single pixel to memory.</td>
+    /// </tr>
     /// </table>
     /// @tparam format the @ref pixmap_format that this trait represents
     template<pixmap_format format /**< the @ref pixmap_format that this trait represents */>
     struct pixmap_traits;
 
     /// A @ref pixmap_traits implementation for the @ref pixmap_format::r8 format.
-    template<> struct pixmap_traits<pixmap_format::r8> : public detail::fundamental_pixmap_traits<1> {};
+    template<> struct pixmap_traits<pixmap_format::r8> : public detail::fundamental_pixmap_traits<1> {
+        using pixel_type = r8_pixel;
+    };
 
     /// A @ref pixmap_traits implementation for the @ref pixmap_format::rgb8 format.
-    template<> struct pixmap_traits<pixmap_format::rgb8> : public detail::fundamental_pixmap_traits<3> {};
+    template<> struct pixmap_traits<pixmap_format::rgb8> : public detail::fundamental_pixmap_traits<3> {
+        using pixel_type = rgb8_pixel;
+    };
 
     /// A @ref pixmap_traits implementation for the @ref pixmap_format::rgba8 format.
-    template<> struct pixmap_traits<pixmap_format::rgba8> : public detail::fundamental_pixmap_traits<4> {};
+    template<> struct pixmap_traits<pixmap_format::rgba8> : public detail::fundamental_pixmap_traits<4> {
+        using pixel_type = rgba8_pixel;
+    };
+
+    /// A @ref pixmap_traits implementation for the @ref pixmap_format::rgb565 format.
+    template<> struct pixmap_traits<pixmap_format::rgb565> : public detail::packed_pixmap_traits<std::uint16_t> {
+        using pixel_type = rgb565_pixel;
+    };
+
+    /// A @ref pixmap_traits implementation for the @ref pixmap_format::rgba4444 format.
+    template<> struct pixmap_traits<pixmap_format::rgba4444> : public detail::packed_pixmap_traits<std::uint16_t> {
+        using pixel_type = rgba4444_pixel;
+    };
+
+    /// A @ref pixmap_traits implementation for the @ref pixmap_format::rgba5551 format.
+    template<> struct pixmap_traits<pixmap_format::rgba5551> : public detail::packed_pixmap_traits<std::uint16_t> {
+        using pixel_type = rgba5551_pixel;
+    };
+
+    /// A @ref pixmap_traits implementation for the @ref pixmap_format::la8 format.
+    template<> struct pixmap_traits<pixmap_format::la8> : public detail::fundamental_pixmap_traits<2> {
+        using pixel_type = la8_pixel;
+    };
 
     /// @brief A memory-backed @ref pixmap.
     /// @tparam Format this pixmap's data format
@@ -114,40 +523,106 @@ namespace musubi {
     /// @details
     /// A backing buffer for a new, empty pixmap is not allocated until an attempt is made
     /// to actually modify the underlying buffer.
+    ///
+    /// Rows are tightly packed by default. A _row alignment_ can be specified on construction,
+    /// in which case the buffer and the start of each row are aligned to that many bytes
+    /// (e.g. 16 to 64 bytes for SIMD processing), and rows are padded accordingly.
+    ///
+    /// Transient pixmaps of recurring sizes can obtain their buffers from a @ref pixmap_pool.
+    ///
+    /// Buffer pixmaps track the bounding rectangle of all pixels modified since the last call to
+    /// @ref clear_dirty() (see @ref get_dirty_rect()), so that dynamic textures can re-upload only
+    /// the modified region (see gl::texture::update()). Writes through the mutable @ref data() pointer
+    /// cannot be tracked; retrieving it marks the entire pixmap as dirty.
     template<pixmap_format Format, typename Traits = pixmap_traits<Format>>
     class buffer_pixmap final : public pixmap {
     public:
+        /// @brief The type of a single pixel, as stored in memory.
+        using pixel_type = typename Traits::pixel_type;
+
+        static_assert(sizeof(pixel_type) == Traits::bytes_per_pixel && alignof(pixel_type) <= sizeof(pixel_type),
+                      "pixel_type must match the in-memory layout of a pixel");
+
+        /// @brief The largest supported row alignment, in bytes.
+        static constexpr std::size_t MAX_ROW_ALIGNMENT = 4096u;
+
         /// @brief Constructs a buffer_pixmap with the specified size.
         /// @details This does not allocate any memory.
         /// @param[in] width, height the pixmap size
         buffer_pixmap(uint32 width, uint32 height) noexcept
-                : width(width), height(height), buffer(nullptr) {}
+                : buffer(nullptr), width(width), height(height),
+                  rowAlignment(1), stride(width * Traits::bytes_per_pixel) {}
+
+        /// @brief Constructs a buffer_pixmap with the specified size and row alignment.
+        /// @details This does not allocate any memory.
+        /// @param[in] width, height the pixmap size
+        /// @param[in] rowAlignment the alignment of each row in bytes; must be a power of two
+        /// @throw std::invalid_argument if the row alignment is not a power of two,
+        /// or exceeds @ref MAX_ROW_ALIGNMENT
+        buffer_pixmap(uint32 width, uint32 height, std::size_t rowAlignment)
+                : buffer(nullptr), width(width), height(height),
+                  rowAlignment(check_alignment(rowAlignment)),
+                  stride(detail::align_up(width * Traits::bytes_per_pixel, rowAlignment)) {}
+
+        /// @brief Constructs a buffer_pixmap with the specified size, whose buffer is obtained from a pool.
+        /// @details
+        /// This does not allocate any memory. Once allocated, the buffer is returned to the pool
+        /// when this pixmap is destroyed.
+        /// @param[in] width, height the pixmap size
+        /// @param[in] pool the pool to obtain the backing buffer from
+        /// @param[in] rowAlignment the alignment of each row in bytes; must be a power of two
+        /// @throw std::invalid_argument if the row alignment is not a power of two,
+        /// or exceeds @ref MAX_ROW_ALIGNMENT
+        buffer_pixmap(uint32 width, uint32 height, const pixmap_pool &pool, std::size_t rowAlignment = 1)
+                : buffer_pixmap(width, height, rowAlignment) {
+            this->pool = pool.state;
+        }
 
         /// @brief Constructs a buffer_pixmap with the specified size, copying the specified buffer.
         /// @param[in] width, height the pixmap size
-        /// @param[in] buffer the source buffer to load
+        /// @param[in] buffer the source buffer to load, containing tightly-packed rows
         buffer_pixmap(uint32 width, uint32 height, const byte *buffer)
-                : width(width), height(height) {
+                : buffer_pixmap(width, height) {
             ensure_buffer();
-            std::copy(buffer, buffer + get_buffer_size(width, height), this->buffer.get());
+            std::copy(buffer, buffer + get_buffer_size(), this->buffer.get());
         }
 
         /// @brief Constructs a buffer_pixmap with the specified size, copying the specified range.
         /// @tparam InputIterator the range iterator type
         /// @param[in] width, height the pixmap size
-        /// @param[in] first, last the data range to copy from
+        /// @param[in] first, last the data range to copy from, containing tightly-packed rows
         template<typename InputIterator>
         buffer_pixmap(uint32 width, uint32 height, InputIterator first, InputIterator last)
-                : width(width), height(height) {
+                : buffer_pixmap(width, height) {
             ensure_buffer();
             std::copy(first, last, buffer.get());
         }
 
+        /// @brief Constructs a buffer_pixmap by copying the contents of another pixmap or pixmap view.
+        /// @details Rows are copied as a whole, so this is suitable for extracting sub-regions of a pixmap.
+        /// @param[in] source the pixmap to copy
+        /// @param[in] rowAlignment the alignment of each row in bytes; must be a power of two
+        /// @throw std::invalid_argument if the source format differs from this pixmap's format,
+        /// or if the row alignment is invalid
+        explicit buffer_pixmap(const pixmap_view &source, std::size_t rowAlignment = 1)
+                : buffer_pixmap(source.get_width(), source.get_height(), rowAlignment) {
+            if (source.get_format() != Format) {
+                throw std::invalid_argument("Cannot copy pixmap; source and destination formats differ");
+            }
+            if (!source.data()) return;
+            ensure_buffer();
+            const auto rowSize = width * Traits::bytes_per_pixel;
+            for (uint32 y = 0; y < height; ++y) {
+                std::memcpy(buffer.get() + y * stride, source.row_data(y), rowSize);
+            }
+        }
+
         /// @details Move constructor; `other` becomes an empty but valid pixmap.
         /// @param[in,out] other the pixmap to move from
         buffer_pixmap(buffer_pixmap &&other) noexcept
-                : width(other.width), height(other.height),
-                  buffer(std::move(other.buffer)) {}
+                : buffer(std::move(other.buffer)), width(other.width), height(other.height),
+                  rowAlignment(other.rowAlignment), stride(other.stride), pool(std::move(other.pool)),
+                  dirty(std::exchange(other.dirty, {})) {}
 
         /// @details Move assignment operator; `other` becomes an empty but valid pixmap.
         /// @param[in,out] other the pixmap to move from
@@ -155,7 +630,11 @@ namespace musubi {
         buffer_pixmap &operator=(buffer_pixmap &&other) noexcept {
             width = other.width;
             height = other.height;
+            rowAlignment = other.rowAlignment;
+            stride = other.stride;
             buffer = std::move(other.buffer);
+            pool = std::move(other.pool);
+            dirty = std::exchange(other.dirty, {});
             return *this;
         }
 
@@ -170,6 +649,12 @@ namespace musubi {
 
         [[nodiscard]] pixmap_format get_format() const override { return Format; }
 
+        [[nodiscard]] std::size_t get_stride() const override { return stride; }
+
+        /// @details Retrieves the alignment of each row of this pixmap, in bytes.
+        /// @return this pixmap's row alignment
+        [[nodiscard]] std::size_t get_row_alignment() const noexcept { return rowAlignment; }
+
         /// @details Checks if this pixmap has allocated a backing buffer.
         /// @return whether this pixmap has allocated a backing buffer
         [[nodiscard]] bool is_allocated() const noexcept { return buffer.operator bool(); }
@@ -179,13 +664,38 @@ namespace musubi {
         /// @see is_allocated()
         void ensure_buffer() {
             if (!is_allocated()) {
-                buffer = std::make_unique<byte[]>(get_buffer_size(width, height));
+                buffer = pool ? detail::allocate_pooled_buffer(pool, get_buffer_size(), rowAlignment)
+                              : detail::allocate_pixmap_buffer(get_buffer_size(), rowAlignment);
             }
         }
 
-        /// @details Retrieves a mutable pointer to this pixmap's data.
+        /// @details Retrieves a mutable pointer to this pixmap's data, and marks the entire pixmap as dirty.
         /// @return a mutable pointer to this pixmap's data
-        [[nodiscard]] byte *data() { return buffer.get(); }
+        [[nodiscard]] byte *data() {
+            mark_dirty();
+            return buffer.get();
+        }
+
+        /// @brief Retrieves the bounding rectangle of all pixels modified since the last @ref clear_dirty().
+        /// @return the dirty rectangle, which is empty if no pixels were modified
+        [[nodiscard]] const pixmap_rect &get_dirty_rect() const noexcept { return dirty; }
+
+        /// @details Checks if any pixels were modified since the last @ref clear_dirty().
+        /// @return whether this pixmap has a non-empty dirty rectangle
+        [[nodiscard]] bool is_dirty() const noexcept { return !dirty.empty(); }
+
+        /// @brief Marks a region of this pixmap as modified.
+        /// @details This is only necessary after writing through the mutable @ref data() pointer.
+        /// @param[in] region the modified region; clipped to the bounds of this pixmap
+        void mark_dirty(const pixmap_rect &region) noexcept {
+            dirty = dirty.united(region.intersected({0, 0, width, height}));
+        }
+
+        /// @details Marks the entire pixmap as modified.
+        void mark_dirty() noexcept { dirty = {0, 0, width, height}; }
+
+        /// @details Resets the dirty rectangle; typically called after uploading the dirty region.
+        void clear_dirty() noexcept { dirty = {}; }
 
         /// @brief Retrieves the data of a specified pixel.
         /// @param[in] x, y the position of the pixel
@@ -200,22 +710,13 @@ namespace musubi {
                         "y out of pixmap range: "s + std::to_string(y) + " >= "s + std::to_string(height)
                 );
             }
-            // Combine bytes_per_pixel bytes into a single element_type
-            typename Traits::element_type result{0u};
-            if (!is_allocated()) return result;
-            const auto ptr = get_ptr(x, y);
-            const auto max{Traits::get_bytes_per_pixel()};
-            for (auto i = 0u; i < max; ++i) {
-                result |= (static_cast<typename Traits::element_type>(ptr[i]) << ((max - i - 1) * 8));
-            }
-            return result;
+            if (!is_allocated()) return typename Traits::element_type{0u};
+            return Traits::load(get_ptr(x, y));
         }
-
         /// @brief Sets the value of a specified pixel.
         /// @param[in] x, y the position of the pixel
         /// @param[in] value the new value of the pixel
         void set_pixel(uint32 x, uint32 y, typename Traits::element_type value) {
-            // Decompose a element_type into bytes_per_pixel bytes
             if (x >= width) {
                 throw std::out_of_range(
                         "x out of pixmap range: "s + std::to_string(x) + " >= "s + std::to_string(width)
@@ -226,31 +727,176 @@ namespace musubi {
                 );
             }
             ensure_buffer();
-            const auto ptr = get_ptr(x, y);
-            const auto max{Traits::bytes_per_pixel};
-            for (auto i = 0u; i < max; ++i) {
-                ptr[i] = static_cast<byte>((value >> ((max - i - 1) * 8)) & 0xFFu);
-            }
+            Traits::store(get_ptr(x, y), value);
+            mark_dirty({x, y, 1, 1});
+        }
+
+        /// @brief Retrieves the pixels of a row.
+        /// @details
+        /// Unlike @ref get_pixel() and @ref set_pixel(), row access is unchecked and operates on whole rows;
+        /// iterating over rows in order accesses memory sequentially.
+        /// This allocates the backing buffer if necessary, and marks the row as dirty.
+        /// @param[in] y the row index; this is not bounds-checked
+        /// @return a span of the row's pixels
+        [[nodiscard]] span<pixel_type> row(uint32 y) {
+            ensure_buffer();
+            mark_dirty({0, y, width, 1});
+            return {reinterpret_cast<pixel_type *>(buffer.get() + y * stride), width};
+        }
+
+        /// @brief Retrieves the pixels of a row.
+        /// @details Rows of an unallocated pixmap are empty.
+        /// @param[in] y the row index; this is not bounds-checked
+        /// @return a span of the row's pixels
+        [[nodiscard]] span<const pixel_type> row(uint32 y) const {
+            if (!is_allocated()) return {};
+            return {reinterpret_cast<const pixel_type *>(buffer.get() + y * stride), width};
+        }
+
+        /// @brief Sets every pixel of this pixmap to the value returned by a generator function.
+        /// @details
+        /// The generator is invoked as `generator(x, y)` and must return a @ref pixel_type.
+        /// Pixels are generated in row-major order; if a thread pool is specified, rows are split across its
+        /// workers, and the generator must be safe to call concurrently.
+        /// @tparam Generator the generator type
+        /// @param[in] generator the generator function
+        /// @param[in] pool the thread pool to split rows across, or null to generate on the calling thread
+        template<typename Generator>
+        void generate(Generator &&generator, thread_pool *pool = nullptr) {
+            for_each_row([&](uint32 y, pixel_type *row) {
+                for (uint32 x = 0; x < width; ++x) row[x] = generator(x, y);
+            }, pool);
+        }
+
+        /// @brief Invokes a function for every pixel of this pixmap.
+        /// @details
+        /// The function is invoked as `function(pixel, x, y)`, where `pixel` is a mutable @ref pixel_type reference.
+        /// Pixels are visited in row-major order; if a thread pool is specified, rows are split across its
+        /// workers, and the function must be safe to call concurrently.
+        /// @tparam Function the function type
+        /// @param[in] function the function to invoke
+        /// @param[in] pool the thread pool to split rows across, or null to visit pixels on the calling thread
+        template<typename Function>
+        void for_each_pixel(Function &&function, thread_pool *pool = nullptr) {
+            for_each_row([&](uint32 y, pixel_type *row) {
+                for (uint32 x = 0; x < width; ++x) function(row[x], x, y);
+            }, pool);
+        }
+
+        /// @brief Sets every pixel of this pixmap to the specified value.
+        /// @details This is considerably faster than calling @ref set_pixel() for each pixel.
+        /// @param[in] value the new value of each pixel, as accepted by @ref set_pixel()
+        void fill(typename Traits::element_type value) { fill_rect(0, 0, width, height, value); }
+
+        /// @brief Sets every pixel in a rectangle to the specified value.
+        /// @details The rectangle is clipped to the bounds of this pixmap.
+        /// @param[in] x, y the position of the rectangle
+        /// @param[in] width, height the size of the rectangle
+        /// @param[in] value the new value of each pixel, as accepted by @ref set_pixel()
+        void fill_rect(uint32 x, uint32 y, uint32 width, uint32 height, typename Traits::element_type value) {
+            if (x >= this->width || y >= this->height) return;
+            width = std::min(width, this->width - x);
+            height = std::min(height, this->height - y);
+            if (width == 0 || height == 0) return;
+
+            byte pixel[Traits::bytes_per_pixel];
+            Traits::store(pixel, value);
+            ensure_buffer();
+            detail::fill_pixels(get_ptr(x, y), stride, Format, width, height, pixel);
+            mark_dirty({x, y, width, height});
+        }
+
+        /// @brief Copies a pixmap, or a region of one, into this pixmap.
+        /// @details
+        /// The source is clipped to the bounds of this pixmap; positions may be negative.
+        /// With @ref blend_mode::copy, the source is converted to this pixmap's format if necessary.
+        /// @param[in] source the pixmap to copy from
+        /// @param[in] x, y the destination position of the source's top-left pixel
+        /// @param[in] mode the blend mode to use
+        /// @throw std::invalid_argument if the formats are not supported by the blend mode
+        void blit(const pixmap_view &source, int32 x, int32 y, blend_mode mode = blend_mode::copy) {
+            const auto left = std::max<int64>(x, 0), top = std::max<int64>(y, 0);
+            const auto right = std::min<int64>(int64{x} + source.get_width(), width);
+            const auto bottom = std::min<int64>(int64{y} + source.get_height(), height);
+            if (left >= right || top >= bottom) return;
+
+            const auto clipped = source.sub_view(
+                    static_cast<uint32>(left - x), static_cast<uint32>(top - y),
+                    static_cast<uint32>(right - left), static_cast<uint32>(bottom - top)
+            );
+            ensure_buffer();
+            detail::copy_pixels(get_ptr(static_cast<uint32>(left), static_cast<uint32>(top)),
+                                stride, Format, clipped, mode);
+            mark_dirty({static_cast<uint32>(left), static_cast<uint32>(top),
+                        clipped.get_width(), clipped.get_height()});
         }
 
     private:
-        [[nodiscard]] static constexpr std::size_t get_buffer_size(uint32 width, uint32 height) noexcept {
-            return width * height * Traits::bytes_per_pixel;
+        template<typename RowFunction>
+        void for_each_row(RowFunction &&rowFunction, thread_pool *pool) {
+            if (width == 0 || height == 0) return;
+            ensure_buffer();
+            mark_dirty();
+            const auto visitRows = [&](std::size_t first, std::size_t last) {
+                for (auto y = static_cast<uint32>(first); y < last; ++y) {
+                    rowFunction(y, reinterpret_cast<pixel_type *>(buffer.get() + y * stride));
+                }
+            };
+            if (pool) {
+                detail::parallel_rows(*pool, height, visitRows);
+            } else {
+                visitRows(0, height);
+            }
+        }
+
+        [[nodiscard]] static std::size_t check_alignment(std::size_t alignment) {
+            if (alignment == 0 || (alignment & (alignment - 1)) != 0 || alignment > MAX_ROW_ALIGNMENT) {
+                throw std::invalid_argument("Pixmap row alignment must be a power of two <= "s
+                                            + std::to_string(MAX_ROW_ALIGNMENT) + ", was: "s
+                                            + std::to_string(alignment));
+            }
+            return alignment;
         }
 
+        [[nodiscard]] std::size_t get_buffer_size() const noexcept { return height * stride; }
+
         [[nodiscard]] inline const byte *get_ptr(uint32 x, uint32 y) const {
             if (!is_allocated())
                 throw assertion_error("const buffer_pixmap requested byte*, but it has no allocated buffer");
-            return &buffer[y * width * Traits::bytes_per_pixel + x * Traits::bytes_per_pixel];
+            return &buffer[y * stride + x * Traits::bytes_per_pixel];
         }
 
         [[nodiscard]] inline byte *get_ptr(uint32 x, uint32 y) {
             return const_cast<byte *>((const_cast<const buffer_pixmap *>(this)->get_ptr(x, y)));
         }
 
-        std::unique_ptr<byte[]> buffer;
+        detail::pixmap_buffer_ptr buffer;
         uint32 width, height;
+        std::size_t rowAlignment, stride;
+        std::shared_ptr<detail::pixmap_pool_state> pool{};
+        pixmap_rect dirty{};
     };
+
+    /// @brief Creates a copy of a pixmap in a different format.
+    /// @details
+    /// Conversions to formats with more channels fill the missing color channels with 0,
+    /// and the alpha channel with 255; conversions to formats with fewer channels discard the extra channels.
+    /// Conversions to packed formats truncate each component to its packed bit depth,
+    /// conversions to @ref pixmap_format::la8 compute luminance with Rec. 601 weights,
+    /// and conversions between two formats other than @ref pixmap_format::rgba8 convert through rgba8.
+    /// @tparam To the format of the new pixmap
+    /// @param[in] source the pixmap to convert
+    /// @param[in] rowAlignment the row alignment of the new pixmap
+    /// @return the converted pixmap
+    template<pixmap_format To>
+    [[nodiscard]] buffer_pixmap<To> convert_pixmap(const pixmap_view &source, std::size_t rowAlignment = 1) {
+        buffer_pixmap<To> result(source.get_width(), source.get_height(), rowAlignment);
+        if (source.data() && source.get_width() != 0 && source.get_height() != 0) {
+            result.ensure_buffer();
+            detail::copy_pixels(result.data(), result.get_stride(), To, source, blend_mode::copy);
+        }
+        return result;
+    }
 }
 
 #endif //MUSUBI_GL_PIXMAP_H
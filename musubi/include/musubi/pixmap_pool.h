@@ -0,0 +1,136 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#ifndef MUSUBI_PIXMAP_POOL_H
+#define MUSUBI_PIXMAP_POOL_H
+
+#include "musubi/common.h"
+
+#include <cstddef>
+#include <memory>
+#include <new>
+
+namespace musubi {
+    using std::byte;
+
+    enum class pixmap_format : uint8;
+
+    namespace detail {
+        struct pixmap_pool_state;
+
+        /// @brief Returns a pooled buffer to its pool, or frees it if the pool is full or has been destroyed.
+        void release_pooled_buffer(pixmap_pool_state &pool, byte *buffer,
+                                   std::size_t capacity, std::size_t alignment) noexcept;
+
+        /// @brief Frees a buffer allocated with the specified alignment.
+        inline void free_pixmap_buffer(byte *buffer, std::size_t alignment) noexcept {
+            if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+                ::operator delete[](buffer, std::align_val_t(alignment));
+            } else {
+                delete[] buffer;
+            }
+        }
+
+        /// @brief Deleter for pixmap buffers allocated by @ref allocate_pixmap_buffer() or a @ref pixmap_pool.
+        struct pixmap_buffer_deleter {
+            std::size_t alignment{1};
+            /// The pool that owns the buffer, if any.
+            std::shared_ptr<pixmap_pool_state> pool{};
+            /// The size class of a pooled buffer.
+            std::size_t capacity{0};
+
+            void operator()(byte *buffer) const noexcept {
+                if (pool) {
+                    release_pooled_buffer(*pool, buffer, capacity, alignment);
+                } else {
+                    free_pixmap_buffer(buffer, alignment);
+                }
+            }
+        };
+
+        using pixmap_buffer_ptr = std::unique_ptr<byte[], pixmap_buffer_deleter>;
+
+        /// @brief Allocates a zero-initialized pixmap buffer with the specified alignment.
+        inline pixmap_buffer_ptr allocate_pixmap_buffer(std::size_t size, std::size_t alignment) {
+            if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+                return pixmap_buffer_ptr(new(std::align_val_t(alignment)) byte[size](), {alignment});
+            } else {
+                return pixmap_buffer_ptr(new byte[size](), {alignment});
+            }
+        }
+
+        /// @brief Allocates a zero-initialized pixmap buffer from a pool, reusing a cached buffer if possible.
+        pixmap_buffer_ptr allocate_pooled_buffer(const std::shared_ptr<pixmap_pool_state> &pool,
+                                                 std::size_t size, std::size_t alignment);
+
+        constexpr std::size_t align_up(std::size_t value, std::size_t alignment) noexcept {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+    }
+
+    /// @brief Allocation statistics of a @ref pixmap_pool.
+    struct pixmap_pool_stats final {
+        uint64 allocations{0}; ///< @brief The number of buffers allocated from the system.
+        uint64 reuses{0}; ///< @brief The number of requests satisfied by a cached buffer.
+        uint64 releases{0}; ///< @brief The number of buffers returned to the pool.
+        uint64 evictions{0}; ///< @brief The number of returned buffers freed because the pool was full.
+
+        std::size_t cachedBuffers{0}; ///< @brief The number of buffers currently cached for reuse.
+        std::size_t cachedBytes{0}; ///< @brief The total size of all cached buffers.
+        std::size_t outstandingBuffers{0}; ///< @brief The number of buffers currently owned by pixmaps.
+        std::size_t outstandingBytes{0}; ///< @brief The total size of all buffers currently owned by pixmaps.
+    };
+
+    /// @brief A pool of recycled pixmap buffers.
+    /// @details
+    /// Pixmaps constructed with a pool (see @ref buffer_pixmap) obtain their backing buffers from it,
+    /// and return them to it on destruction instead of freeing them.
+    /// This avoids an allocation per pixmap for transient pixmaps of recurring sizes,
+    /// such as glyphs, thumbnails, or render captures.
+    ///
+    /// Requests are rounded up to a _size class_, so that pixmaps of similar sizes can share buffers;
+    /// size classes are at most 25% larger than the requested size (see @ref get_size_class()).
+    /// Reused buffers are zeroed, so pooled pixmaps behave exactly like non-pooled pixmaps.
+    ///
+    /// Buffers returned while the pool caches more than its byte limit are freed.
+    /// Pixmaps may outlive their pool; their buffers are then freed on destruction.
+    /// Pools are thread-safe.
+    class pixmap_pool final {
+    private:
+        std::shared_ptr<detail::pixmap_pool_state> state;
+
+        template<pixmap_format, typename> friend class buffer_pixmap;
+
+    public:
+        LIBMUSUBI_DELCP(pixmap_pool)
+
+        /// @brief The smallest size class, in bytes.
+        static constexpr std::size_t MIN_SIZE_CLASS = 256u;
+
+        /// @brief Constructs an empty pool.
+        /// @param[in] maxCachedBytes the maximum total size of cached buffers
+        explicit pixmap_pool(std::size_t maxCachedBytes = 64u * 1024u * 1024u);
+
+        /// @brief Frees all cached buffers.
+        /// @details Buffers that are still owned by pixmaps are freed when those pixmaps are destroyed.
+        ~pixmap_pool() noexcept;
+
+        /// @details Retrieves the allocation statistics of this pool.
+        /// @return a snapshot of this pool's statistics
+        [[nodiscard]] pixmap_pool_stats get_stats() const;
+
+        /// @details Resets the counters of this pool's statistics; current cache and ownership totals are kept.
+        void reset_stats();
+
+        /// @details Frees all cached buffers.
+        void trim();
+
+        /// @brief Retrieves the size class that a request of the specified size is rounded up to.
+        /// @param[in] size the requested size in bytes
+        /// @return the size class in bytes
+        [[nodiscard]] static std::size_t get_size_class(std::size_t size) noexcept;
+    };
+}
+
+#endif //MUSUBI_PIXMAP_POOL_H
@@ -0,0 +1,105 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#ifndef MUSUBI_SDL_SDL_GL_LOADER_H
+#define MUSUBI_SDL_SDL_GL_LOADER_H
+
+#include "musubi/common.h"
+#include "musubi/pixmap.h"
+#include "musubi/thread_pool.h"
+#include "musubi/gl/shaders.h"
+#include "musubi/gl/textures.h"
+
+#include <SDL2/SDL.h>
+#include <epoxy/gl.h>
+
+#include <future>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace musubi::sdl {
+    /// @brief A background OpenGL loader with its own context, shared with a window's context.
+    /// @details
+    /// The loader owns a dedicated upload thread, on which its context is current.
+    /// Functions submitted to it may create and fill shareable OpenGL objects
+    /// (such as @ref gl::texture "textures" and @ref gl::shader_program "shader programs")
+    /// without stalling the window's thread on driver work.
+    ///
+    /// After a submitted function returns, the upload thread inserts a fence and waits for it,
+    /// and only then publishes the result through the returned future. Objects received through
+    /// a future are therefore complete, and can be used on the window's thread after (re-)binding them.
+    ///
+    /// Container objects, such as vertex arrays and framebuffers, are not shared between contexts;
+    /// they must still be created on the window's thread.
+    ///
+    /// Loaders are typically created through @ref sdl_window::enable_loader().
+    class sdl_gl_loader final {
+    public:
+        LIBMUSUBI_DELCP(sdl_gl_loader)
+
+        /// @brief Creates a loader context shared with the specified context, and starts the upload thread.
+        /// @details The shared context must be current on the calling thread, and remains current afterwards.
+        /// @param[in] window the window whose context to share with
+        /// @param[in] shareWith the context to share with
+        /// @throw sdl_error if the loader context could not be created
+        sdl_gl_loader(SDL_Window *window, SDL_GLContext shareWith);
+
+        /// @brief Stops the upload thread and deletes the loader context.
+        /// @details This waits for all pending loads to finish.
+        ~sdl_gl_loader() noexcept;
+
+        /// @brief Enqueues a function for execution on the upload thread.
+        /// @details This function is thread-safe.
+        /// @tparam Function the callable type
+        /// @param[in] function the callable to execute with the loader context current
+        /// @return a future that receives the result of the callable once its OpenGL commands have completed,
+        /// or the exception it threw
+        template<typename Function>
+        auto submit(Function &&function) -> std::future<std::invoke_result_t<std::decay_t<Function>>> {
+            using result_type = std::invoke_result_t<std::decay_t<Function>>;
+            return uploader.submit([function = std::forward<Function>(function)]() mutable -> result_type {
+                if constexpr (std::is_void_v<result_type>) {
+                    function();
+                    await_completion();
+                } else {
+                    auto result = function();
+                    await_completion();
+                    return result;
+                }
+            });
+        }
+
+        /// @brief Loads a texture from a @ref pixmap on the upload thread.
+        /// @details This function is thread-safe.
+        /// @param[in] source the source pixmap; it is kept alive until the texture has been loaded
+        /// @param[in] shouldFlip whether the texture should be vertically flipped prior to rendering
+        /// @param[in] internalFormat the OpenGL internal image format for the loaded texture
+        /// @return a future that receives the loaded texture
+        /// @see gl::texture::load()
+        std::future<std::shared_ptr<gl::texture>> load_texture(std::shared_ptr<const pixmap> source,
+                                                               bool shouldFlip = false,
+                                                               GLenum internalFormat = GL_RGBA8);
+
+        /// @brief Compiles and links a shader program on the upload thread.
+        /// @details This function is thread-safe.
+        /// @param[in] vertexSource the vertex shader source
+        /// @param[in] fragmentSource the fragment shader source
+        /// @return a future that receives the linked program, or the @ref gl::shader_error thrown while linking
+        /// @see gl::shader_program::link()
+        std::future<std::shared_ptr<gl::shader_program>> link_program(std::string vertexSource,
+                                                                      std::string fragmentSource);
+
+    private:
+        /// Waits on the upload thread until all previously issued OpenGL commands have completed.
+        static void await_completion();
+
+        SDL_Window *window;
+        SDL_GLContext context;
+        thread_pool uploader;
+    };
+}
+
+#endif //MUSUBI_SDL_SDL_GL_LOADER_H
@@ -5,6 +5,7 @@
 #ifndef MUSUBI_SDL_SDL_WINDOW_H
 #define MUSUBI_SDL_SDL_WINDOW_H
 
+#include "musubi/sdl/sdl_gl_loader.h"
 #include "musubi/sdl/sdl_input_poller.h"
 #include "musubi/application.h"
 #include "musubi/common.h"
@@ -69,6 +70,26 @@ namespace musubi::sdl {
 
         [[nodiscard]] id_type get_id() const override;
 
+        [[nodiscard]] frame_task_queue &get_task_queue() override;
+
+        /// @brief Sets the maximum amount of time spent executing queued tasks on every tick.
+        /// @details The default budget is 4 milliseconds.
+        /// @param budget the per-tick time budget for the @ref get_task_queue() "task queue"
+        void set_task_budget(frame_task_queue::clock_type::duration budget) noexcept;
+
+        /// @brief Creates a background loader whose OpenGL context is shared with this window's context.
+        /// @details
+        /// Does nothing if this window already has a loader. The loader is destroyed along with this window,
+        /// before its context is deleted.
+        /// @return this window's loader
+        /// @throw sdl_error if the loader context could not be created
+        /// @see sdl_gl_loader
+        sdl_gl_loader &enable_loader();
+
+        /// @details Retrieves this window's background loader.
+        /// @return this window's loader, or `nullptr` if @ref enable_loader() has not been called
+        [[nodiscard]] sdl_gl_loader *get_loader() const noexcept;
+
         /// @brief Makes this window's OpenGL context current.
         void make_current() const;
 
@@ -83,6 +104,9 @@ namespace musubi::sdl {
         SDL_GLContext context;
         std::shared_ptr<screen> currentScreen;
         std::chrono::time_point<clock_type> lastTime;
+        frame_task_queue taskQueue;
+        frame_task_queue::clock_type::duration taskBudget{std::chrono::milliseconds(4)};
+        std::unique_ptr<sdl_gl_loader> loader{};
     };
 }
 
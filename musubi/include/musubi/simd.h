@@ -0,0 +1,46 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#ifndef MUSUBI_SIMD_H
+#define MUSUBI_SIMD_H
+
+#include "musubi/common.h"
+
+namespace musubi {
+    /// @brief An instruction set level used by musubi's vectorized kernels.
+    /// @details
+    /// Bulk operations (such as @ref buffer_pixmap::fill() or @ref convert_pixmap())
+    /// are implemented once per level and dispatched at runtime,
+    /// based on the level returned by @ref get_simd_level().
+    /// The @ref simd_level::scalar "scalar" kernels serve as the reference implementation;
+    /// all other levels produce bit-identical results.
+    enum class simd_level : uint8 {
+        scalar, ///< Portable scalar code
+        sse2, ///< x86 SSE2
+        avx2, ///< x86 AVX2 (including SSSE3)
+        neon ///< ARM NEON
+    };
+
+    /// @brief Retrieves the highest instruction set level supported by the current CPU and build.
+    /// @return the highest supported instruction set level
+    [[nodiscard]] simd_level get_supported_simd_level() noexcept;
+
+    /// @brief Retrieves the instruction set level currently used by vectorized kernels.
+    /// @details This is @ref get_supported_simd_level() unless overridden via @ref set_simd_level().
+    /// @return the active instruction set level
+    [[nodiscard]] simd_level get_simd_level() noexcept;
+
+    /// @brief Overrides the instruction set level used by vectorized kernels.
+    /// @details This is mostly useful for benchmarking, or for comparing results against the scalar reference.
+    /// @param[in] level the instruction set level to use
+    /// @throw std::invalid_argument if the specified level is not supported by the current CPU and build
+    void set_simd_level(simd_level level);
+
+    /// @brief Retrieves a human-readable name for an instruction set level.
+    /// @param[in] level the instruction set level
+    /// @return the name of the level
+    [[nodiscard]] const char *get_simd_level_name(simd_level level) noexcept;
+}
+
+#endif //MUSUBI_SIMD_H
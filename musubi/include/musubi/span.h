@@ -0,0 +1,121 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#ifndef MUSUBI_SPAN_H
+#define MUSUBI_SPAN_H
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace musubi {
+    /// @brief A non-owning view of a contiguous sequence of objects.
+    /// @details
+    /// This is a minimal subset of C++20's `std::span` with a dynamic extent,
+    /// and will be replaced by it once musubi moves to C++20.
+    /// A span must not outlive the sequence it refers to.
+    /// @tparam T the element type; may be const-qualified for read-only spans
+    template<typename T>
+    class span final {
+    public:
+        using element_type = T;
+        using value_type = std::remove_cv_t<T>;
+        using size_type = std::size_t;
+        using pointer = T *;
+        using reference = T &;
+        using iterator = T *;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+
+        /// @details Constructs an empty span.
+        constexpr span() noexcept = default;
+
+        /// @details Constructs a span of `size` objects starting at `data`.
+        /// @param[in] data a pointer to the first object
+        /// @param[in] size the number of objects
+        constexpr span(pointer data, size_type size) noexcept : ptr(data), count(size) {}
+
+        /// @details Constructs a span of the objects in [first, last).
+        /// @param[in] first, last the range of objects
+        constexpr span(pointer first, pointer last) noexcept
+                : ptr(first), count(static_cast<size_type>(last - first)) {}
+
+        /// @details Constructs a span of a built-in array.
+        /// @param[in] array the array
+        template<std::size_t N>
+        constexpr span(element_type (&array)[N]) noexcept : ptr(array), count(N) {} // NOLINT(google-explicit-constructor)
+
+        /// @details Constructs a span of a contiguous container, such as `std::vector` or `std::array`.
+        /// @param[in] container the container
+        template<typename Container, typename = std::enable_if_t<
+                !std::is_same_v<std::remove_cv_t<std::remove_reference_t<Container>>, span> &&
+                std::is_convertible_v<decltype(std::data(std::declval<Container &>())), pointer>
+        >>
+        constexpr span(Container &container) noexcept // NOLINT(google-explicit-constructor)
+                : ptr(std::data(container)), count(std::size(container)) {}
+
+        /// @details Converts a span of mutable objects into a span of const objects.
+        /// @param[in] other the span to convert
+        template<typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+        constexpr span(const span<U> &other) noexcept // NOLINT(google-explicit-constructor)
+                : ptr(other.data()), count(other.size()) {}
+
+        constexpr span(const span &other) noexcept = default;
+
+        constexpr span &operator=(const span &other) noexcept = default;
+
+        [[nodiscard]] constexpr pointer data() const noexcept { return ptr; }
+
+        [[nodiscard]] constexpr size_type size() const noexcept { return count; }
+
+        [[nodiscard]] constexpr size_type size_bytes() const noexcept { return count * sizeof(T); }
+
+        [[nodiscard]] constexpr bool empty() const noexcept { return count == 0; }
+
+        /// @details Accesses an object of this span; the index is not bounds-checked.
+        /// @param[in] index the index of the object
+        /// @return a reference to the object
+        [[nodiscard]] constexpr reference operator[](size_type index) const noexcept { return ptr[index]; }
+
+        [[nodiscard]] constexpr reference front() const noexcept { return ptr[0]; }
+
+        [[nodiscard]] constexpr reference back() const noexcept { return ptr[count - 1]; }
+
+        [[nodiscard]] constexpr iterator begin() const noexcept { return ptr; }
+
+        [[nodiscard]] constexpr iterator end() const noexcept { return ptr + count; }
+
+        [[nodiscard]] constexpr reverse_iterator rbegin() const noexcept { return reverse_iterator(end()); }
+
+        [[nodiscard]] constexpr reverse_iterator rend() const noexcept { return reverse_iterator(begin()); }
+
+        /// @details Creates a span of a subsequence of this span; the range is not bounds-checked.
+        /// @param[in] offset the index of the first object of the subsequence
+        /// @param[in] size the number of objects in the subsequence
+        /// @return a span of the subsequence
+        [[nodiscard]] constexpr span subspan(size_type offset, size_type size) const noexcept {
+            return span(ptr + offset, size);
+        }
+
+        [[nodiscard]] constexpr span first(size_type size) const noexcept { return span(ptr, size); }
+
+        [[nodiscard]] constexpr span last(size_type size) const noexcept { return span(ptr + count - size, size); }
+
+    private:
+        pointer ptr{nullptr};
+        size_type count{0};
+    };
+
+    template<typename T, std::size_t N> span(T (&)[N]) -> span<T>;
+
+    template<typename T, std::size_t N> span(std::array<T, N> &) -> span<T>;
+
+    template<typename T, std::size_t N> span(const std::array<T, N> &) -> span<const T>;
+
+    template<typename Container> span(Container &) -> span<typename Container::value_type>;
+
+    template<typename Container> span(const Container &) -> span<const typename Container::value_type>;
+}
+
+#endif //MUSUBI_SPAN_H
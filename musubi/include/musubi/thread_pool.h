@@ -0,0 +1,126 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#ifndef MUSUBI_THREAD_POOL_H
+#define MUSUBI_THREAD_POOL_H
+
+#include "musubi/common.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+namespace musubi {
+    /// @brief A fixed-size pool of worker threads executing tasks in submission order.
+    /// @details
+    /// Tasks are executed on the first available worker thread.
+    /// Thread pools are suited for CPU-bound work that does not need to be performed on a specific thread,
+    /// such as decoding assets; work that must run on a thread with a graphics context
+    /// should instead be queued to the owning @ref window (see @ref window::get_task_queue()).
+    ///
+    /// Destroying a pool waits for all currently executing tasks to finish;
+    /// tasks that have not started yet are discarded, and their futures report a broken promise.
+    class thread_pool final {
+    private:
+        LIBMUSUBI_PIMPL
+
+    public:
+        LIBMUSUBI_DELCP(thread_pool)
+
+        /// @brief Constructs a thread pool and starts the specified number of worker threads.
+        /// @param[in] threadCount the number of worker threads;
+        /// if 0, the number of hardware threads is used (at least 1)
+        explicit thread_pool(uint32 threadCount = 0);
+
+        /// @brief Stops and joins all worker threads.
+        /// @see thread_pool
+        ~thread_pool() noexcept;
+
+        /// @brief Enqueues a task for execution on a worker thread.
+        /// @details Exceptions thrown by the task are logged and discarded;
+        /// use @ref submit() to observe a task's result.
+        /// @param[in] task the task to execute
+        void post(std::function<void()> task);
+
+        /// @brief Enqueues a callable for execution on a worker thread, returning a future for its result.
+        /// @tparam Function the callable type
+        /// @param[in] function the callable to execute
+        /// @return a future that receives the result of the callable, or the exception it threw
+        template<typename Function>
+        auto submit(Function &&function) -> std::future<std::invoke_result_t<std::decay_t<Function>>> {
+            using result_type = std::invoke_result_t<std::decay_t<Function>>;
+            auto task = std::make_shared<std::packaged_task<result_type()>>(std::forward<Function>(function));
+            auto future = task->get_future();
+            post([task]() { (*task)(); });
+            return future;
+        }
+
+        /// @brief Executes a function over a range of indices, split into chunks across this pool's workers.
+        /// @details
+        /// The body is invoked as `body(begin, end)` for disjoint, consecutive index ranges covering `[0, count)`.
+        /// The calling thread processes chunks as well, and this function returns once all chunks are complete;
+        /// it is therefore safe to call from within a task running on this pool.
+        ///
+        /// If any invocation of the body throws, the remaining chunks still run,
+        /// and the first exception is rethrown on the calling thread.
+        /// @tparam Function the body type
+        /// @param[in] count the number of indices
+        /// @param[in] body the function to execute for each chunk
+        /// @param[in] grain the minimum number of indices per chunk
+        template<typename Function>
+        void parallel_for(std::size_t count, Function &&body, std::size_t grain = 1) {
+            if (count == 0) return;
+
+            // Oversubscribe slightly, so uneven chunks balance out
+            const std::size_t workers = get_thread_count() + 1u;
+            const auto chunkSize = std::max({grain, std::size_t{1}, (count + workers * 4u - 1u) / (workers * 4u)});
+            const auto chunkCount = (count + chunkSize - 1u) / chunkSize;
+
+            struct shared_state {
+                std::atomic<std::size_t> next{0}, done{0};
+                std::mutex mutex{};
+                std::condition_variable finished{};
+                std::exception_ptr error{};
+            };
+            const auto state = std::make_shared<shared_state>();
+
+            // Helpers that start after all chunks were claimed return without touching the body
+            const auto runChunks = [state, chunkSize, chunkCount, count, &body]() {
+                for (std::size_t i; (i = state->next.fetch_add(1u)) < chunkCount;) {
+                    try {
+                        body(i * chunkSize, std::min(count, (i + 1u) * chunkSize));
+                    } catch (...) {
+                        std::lock_guard lock(state->mutex);
+                        if (!state->error) state->error = std::current_exception();
+                    }
+                    if (state->done.fetch_add(1u) + 1u == chunkCount) {
+                        std::lock_guard lock(state->mutex);
+                        state->finished.notify_all();
+                    }
+                }
+            };
+
+            const auto helpers = std::min<std::size_t>(get_thread_count(), chunkCount - 1u);
+            for (std::size_t i = 0; i < helpers; ++i) post(runChunks);
+            runChunks();
+
+            std::unique_lock lock(state->mutex);
+            state->finished.wait(lock, [&]() { return state->done.load() == chunkCount; });
+            if (state->error) std::rethrow_exception(state->error);
+        }
+
+        /// @details Retrieves the number of worker threads in this pool.
+        /// @return the number of worker threads
+        [[nodiscard]] uint32 get_thread_count() const noexcept;
+    };
+}
+
+#endif //MUSUBI_THREAD_POOL_H
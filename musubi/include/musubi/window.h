@@ -6,6 +6,7 @@
 #define MUSUBI_WINDOW_H
 
 #include "musubi/common.h"
+#include "musubi/frame_task_queue.h"
 #include "musubi/screen.h"
 
 #include <memory>
@@ -84,6 +85,16 @@ namespace musubi {
         /// @details Retrieves this window's internal identifier.
         /// @return this window's ID
         [[nodiscard]] virtual id_type get_id() const = 0;
+
+        /// @brief Retrieves the task queue executed on this window's thread.
+        /// @details
+        /// Window implementations should run this queue once per tick, before updating the current screen,
+        /// with any graphics context owned by the window current.
+        /// Tasks that create or modify objects belonging to that context (such as textures)
+        /// can be posted to it from any thread.
+        /// @return this window's task queue
+        /// @see load_pipeline
+        [[nodiscard]] virtual frame_task_queue &get_task_queue() = 0;
     };
 }
 
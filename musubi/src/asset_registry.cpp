@@ -88,6 +88,29 @@ namespace {
 
         return result;
     }
+
+    void read_items(const path &archivePath, std::map<path, std::string> &toLoad,
+                    const std::function<void(const std::string &, std::vector<byte> &&)> &callback) {
+        archive_wrapper archive(archivePath.c_str());
+        archive.read([&](const auto entry) -> bool {
+            const auto pathname = path(archive_entry_pathname(entry)).lexically_normal();
+            const auto toLoadIt = toLoad.find(pathname);
+            if (toLoadIt != toLoad.end()) {
+                std::int64_t size = archive_entry_size(entry);
+                std::vector<byte> buffer;
+                buffer.resize(size);
+
+                archive_read_data(archive, buffer.data(), size);
+
+                callback(toLoadIt->second, std::move(buffer));
+                toLoad.erase(toLoadIt);
+            } else {
+                archive_read_data_skip(archive);
+            }
+            // Stop decompressing once every requested entry has been read
+            return !toLoad.empty();
+        });
+    }
 }
 
 namespace musubi {
@@ -118,11 +141,36 @@ namespace musubi {
     std::optional<std::reference_wrapper<const asset_registry::mpack::pack_item>>
     asset_registry::mpack::operator[](std::string_view name) const { return get_item(name); }
 
+    const std::string &asset_registry::mpack::get_name() const { return packName; }
+
+    std::optional<std::string_view> asset_registry::mpack::get_origin(std::string_view name) const {
+        if (const auto it = origins.find(name); it != origins.end()) return it->second.packName;
+        else return nullopt;
+    }
+
     struct asset_registry::pack_data {
+        std::string packName;
         path packPath;
         json packMeta;
+        std::optional<std::string> base;
+        int64 priority;
+        uint64 sequence;
+
+        pack_data(std::string packName, path packPath, json packMeta, uint64 sequence)
+                : packName(std::move(packName)), packPath(std::move(packPath)), packMeta(std::move(packMeta)),
+                  base(nullopt), priority(0), sequence(sequence) {
+            if (const auto baseIt = this->packMeta.find("base"); baseIt != this->packMeta.end()) {
+                base = baseIt->get<std::string>();
+            }
+            if (const auto priorityIt = this->packMeta.find("priority"); priorityIt != this->packMeta.end()) {
+                priority = priorityIt->get<int64>();
+            }
+        }
+    };
 
-        pack_data(path packPath, json packMeta) : packPath(std::move(packPath)), packMeta(std::move(packMeta)) {}
+    struct asset_registry::item_source {
+        const pack_data *layer;
+        path archivePath;
     };
 
     asset_registry::asset_registry() noexcept = default;
@@ -131,35 +179,17 @@ namespace musubi {
         auto registry = std::unique_ptr<asset_registry>(new asset_registry());
         for (const auto &packPath : paths) {
             if (is_directory(packPath)) {
+                // Directory iteration order is unspecified; registration order decides between equal-priority patches
+                std::vector<path> children;
                 for (const auto &child : directory_iterator(packPath)) {
-                    const auto &childPath = child.path();
-                    if (childPath.extension() == ".mpack") {
-                        const auto childPathString = childPath.string();
-                        // This could be a pack, try to load it
-                        auto packInfo = process_single(childPath);
-                        if (packInfo) {
-                            registry->packs.emplace(
-                                    packInfo->first, std::make_unique<pack_data>(childPath, std::move(packInfo->second))
-                            );
-                            log_i("asset_registry") << "Registered mpack " << packInfo.value().first
-                                                    << " (" << childPath << ")\n";
-                        } else {
-                            log_e("asset_registry") << "Could not register mpack " << childPath << '\n';
-                        }
-                    }
+                    if (child.path().extension() == ".mpack") children.push_back(child.path());
                 }
+                std::sort(children.begin(), children.end());
+                // Each of these could be a pack, try to load them
+                for (const auto &childPath : children) registry->register_pack(childPath);
                 log_i("asset_registry") << "Processed asset load path " << packPath << '\n';
             } else if (is_regular_file(packPath)) {
-                auto packInfo = process_single(packPath);
-                if (packInfo) {
-                    registry->packs.emplace(
-                            packInfo->first, std::make_unique<pack_data>(packPath, std::move(packInfo->second))
-                    );
-                    log_i("asset_registry") << "Registered mpack " << packInfo.value().first
-                                            << " (" << packPath << ")\n";
-                } else {
-                    log_e("asset_registry") << "Could not register mpack " << packPath << '\n';
-                }
+                registry->register_pack(packPath);
             } else {
                 log_e("asset_registry") << "Could not resolve asset load path " << packPath << '\n';
             }
@@ -168,80 +198,154 @@ namespace musubi {
         return registry;
     }
 
+    bool asset_registry::register_pack(const path &packPath) {
+        auto packInfo = process_single(packPath);
+        if (!packInfo) {
+            log_e("asset_registry") << "Could not register mpack " << packPath << '\n';
+            return false;
+        }
+
+        auto data = std::make_unique<pack_data>(packInfo->first, packPath, std::move(packInfo->second), registered);
+        if (data->base && *data->base == data->packName) {
+            log_e("asset_registry") << "Could not register mpack " << packPath
+                                    << ": patch pack " << data->packName << " names itself as its base\n";
+            return false;
+        }
+
+        const auto base = data->base;
+        auto &entry = packs[packInfo->first];
+        if (entry) {
+            log_i("asset_registry") << "Replacing mpack " << packInfo->first << " (" << entry->packPath << ")\n";
+        }
+        entry = std::move(data);
+        ++registered;
+
+        if (base) {
+            log_i("asset_registry") << "Registered patch mpack " << packInfo->first << " for " << *base
+                                    << " (" << packPath << ")\n";
+        } else {
+            log_i("asset_registry") << "Registered mpack " << packInfo->first << " (" << packPath << ")\n";
+        }
+        return true;
+    }
+
     asset_registry::asset_registry(asset_registry &&other) noexcept
-            : packs(std::move(other.packs)) {}
+            : packs(std::move(other.packs)), registered(other.registered) {}
 
     asset_registry &asset_registry::operator=(asset_registry &&other) noexcept {
         packs = std::move(other.packs);
+        registered = other.registered;
         return *this;
     }
 
-    std::unique_ptr<asset_registry::mpack> asset_registry::load_pack(const std::string &packName) {
+    std::vector<const asset_registry::pack_data *> asset_registry::get_layers(const std::string &packName) const {
         const auto packIt = packs.find(packName);
         if (packIt == packs.end()) {
             throw resource_read_error("Could not load mpack "s + packName +
                                       ": no pack with that name was registered");
         }
 
-        const auto &data = packIt->second;
-        auto pack = std::make_unique<asset_registry::mpack>();
+        std::vector<const pack_data *> layers{packIt->second.get()};
+        if (packIt->second->base) return layers;
 
-        const auto contentsIt = data->packMeta.find("contents");
-        if (contentsIt == data->packMeta.end()) {
-            log_w("asset_registry") << "mpack " << packName << " has no contents array; loading an empty pack\n";
-            return pack;
-        }
-
-        // Map real normalized paths to filenames specified in pack.json
-        std::map<std::filesystem::path, std::string> toLoad;
-        for (auto it = contentsIt->begin(); it != contentsIt->end(); ++it) {
-            const auto asset = it.value();
-            if (asset.is_string()) {
-                // Load file
-                const auto assetString = asset.get<std::string>();
-                toLoad.emplace(path(assetString).lexically_normal(), assetString);
-            } else if (asset.is_object()) {
-                // TODO
-                log_e("asset_registry") << "loading complex (i.e. non-file) assets is not yet supported\n";
+        for (const auto &[name, data] : packs) {
+            if (data->base == packName) layers.push_back(data.get());
+        }
+        // Lowest priority first, so that later layers override earlier ones;
+        // the path breaks any remaining tie, as the iteration order of packs is unspecified
+        std::sort(layers.begin() + 1, layers.end(), [](const pack_data *a, const pack_data *b) {
+            if (a->priority != b->priority) return a->priority < b->priority;
+            if (a->sequence != b->sequence) return a->sequence < b->sequence;
+            return a->packPath < b->packPath;
+        });
+        return layers;
+    }
+
+    std::map<std::string, asset_registry::item_source>
+    asset_registry::resolve_index(const std::string &packName) const {
+        std::map<std::string, item_source> index;
+        for (const auto layer : get_layers(packName)) {
+            const auto contentsIt = layer->packMeta.find("contents");
+            if (contentsIt == layer->packMeta.end()) {
+                log_w("asset_registry") << "mpack " << layer->packName << " has no contents array\n";
+                continue;
+            }
+
+            for (auto it = contentsIt->begin(); it != contentsIt->end(); ++it) {
+                const auto asset = it.value();
+                if (asset.is_string()) {
+                    // Higher layers replace the source of any item they also contain
+                    const auto assetString = asset.get<std::string>();
+                    index.insert_or_assign(assetString, item_source{layer, path(assetString).lexically_normal()});
+                } else if (asset.is_object()) {
+                    // TODO
+                    log_e("asset_registry") << "loading complex (i.e. non-file) assets is not yet supported\n";
+                }
             }
         }
+        return index;
+    }
 
-        // Read contents into buffers
-        archive_wrapper archive(data->packPath.c_str());
-        archive.read([&](const auto entry) -> bool {
-            const auto pathname = path(archive_entry_pathname(entry)).lexically_normal();
-            const auto toLoadIt = toLoad.find(pathname);
-            if (toLoadIt != toLoad.end()) {
-                std::int64_t size = archive_entry_size(entry);
-                std::vector<byte> buffer;
-                buffer.resize(size);
 
-                archive_read_data(archive, buffer.data(), size);
+    std::unique_ptr<asset_registry::mpack> asset_registry::load_pack(const std::string &packName) {
+        auto pack = std::make_unique<asset_registry::mpack>();
+        pack->packName = packName;
+        refresh_pack(*pack);
+        return pack;
+    }
 
-                pack->contents.emplace(
-                        toLoadIt->second,
-                        mpack::pack_item(toLoadIt->second, std::move(buffer), {})
-                );
-                toLoad.erase(toLoadIt);
-            } else {
-                archive_read_data_skip(archive);
+    std::size_t asset_registry::refresh_pack(mpack &pack) {
+        const auto index = resolve_index(pack.packName);
+
+        // Group changed items by the layer they are read from, mapping real normalized paths
+        // to filenames specified in pack.json
+        std::map<const pack_data *, std::map<path, std::string>> toLoad;
+        for (const auto &[name, source] : index) {
+            const auto originIt = pack.origins.find(name);
+            if (originIt == pack.origins.end()
+                || originIt->second.packName != source.layer->packName
+                || originIt->second.sequence != source.layer->sequence) {
+                toLoad[source.layer].emplace(source.archivePath, name);
             }
-            return true;
-        });
+        }
+
+        // Read all changed items before modifying the pack, so that it is left untouched if any read fails
+        std::map<std::string, std::pair<std::vector<byte>, const pack_data *>> staged;
+        std::vector<path> missing;
+        for (auto &[layer, layerItems] : toLoad) {
+            const auto source = layer;
+            read_items(layer->packPath, layerItems, [&](const std::string &name, std::vector<byte> &&buffer) {
+                staged.insert_or_assign(name, std::make_pair(std::move(buffer), source));
+            });
+            for (const auto &item : layerItems) missing.push_back(item.first);
+        }
 
-        if (!toLoad.empty()) {
+        if (!missing.empty()) {
             std::ostringstream error;
             error << "Could not load all required files in mpack, missing ";
             bool sep = false;
-            for (const auto &item : toLoad) {
+            for (const auto &item : missing) {
                 if (sep) error << ", ";
                 sep = true;
-                error << item.first;
+                error << item;
             }
             throw resource_read_error(error.str());
         }
 
-        return pack;
+        // Drop items that are no longer provided by any layer
+        for (auto it = pack.origins.begin(); it != pack.origins.end();) {
+            if (index.find(it->first) == index.end()) {
+                pack.contents.erase(it->first);
+                it = pack.origins.erase(it);
+            } else ++it;
+        }
+
+        for (auto &[name, item] : staged) {
+            auto &[buffer, layer] = item;
+            pack.contents.insert_or_assign(name, mpack::pack_item(name, std::move(buffer), {}));
+            pack.origins.insert_or_assign(name, mpack::item_origin{layer->packName, layer->sequence});
+        }
+        return staged.size();
     }
 
     asset_registry::~asset_registry() = default;
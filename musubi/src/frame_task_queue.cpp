@@ -0,0 +1,60 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#include <musubi/frame_task_queue.h>
+
+#include <exception>
+
+namespace musubi {
+    using namespace musubi::detail;
+
+    frame_task_queue::frame_task_queue() noexcept = default;
+
+    frame_task_queue::~frame_task_queue() noexcept = default;
+
+    void frame_task_queue::post(std::function<void()> task) {
+        std::lock_guard lock(mutex);
+        tasks.push_back(std::move(task));
+    }
+
+    std::size_t frame_task_queue::run(clock_type::duration budget) {
+        return run_until(size(), clock_type::now() + budget);
+    }
+
+    std::size_t frame_task_queue::run_all() {
+        return run_until(size(), clock_type::time_point::max());
+    }
+
+    std::size_t frame_task_queue::size() const {
+        std::lock_guard lock(mutex);
+        return tasks.size();
+    }
+
+    bool frame_task_queue::empty() const { return size() == 0; }
+
+    std::size_t frame_task_queue::run_until(std::size_t limit, clock_type::time_point deadline) {
+        std::size_t executed = 0;
+        while (executed < limit) {
+            std::function<void()> task;
+            {
+                std::lock_guard lock(mutex);
+                if (tasks.empty()) break;
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+
+            try {
+                task();
+            } catch (const std::exception &e) {
+                log_e("frame_task_queue") << "Uncaught exception in queued task: " << e.what() << '\n';
+            } catch (...) {
+                log_e("frame_task_queue") << "Uncaught exception in queued task\n";
+            }
+            ++executed;
+
+            if (clock_type::now() >= deadline) break;
+        }
+        return executed;
+    }
+}
@@ -0,0 +1,366 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#include <musubi/gl/dynamic_atlas.h>
+
+#include <musubi/common.h>
+#include <musubi/exception.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace musubi::gl {
+    using namespace musubi::detail;
+
+    struct dynamic_atlas::impl {
+        /// A horizontal run of free pixels in a shelf.
+        struct span {
+            uint32 x, width;
+        };
+
+        /// A row of entries with a common height.
+        struct shelf {
+            uint32 y, height;
+            std::vector<span> free;
+        };
+
+        struct page {
+            std::shared_ptr<gl::texture> texture{};
+            std::vector<byte> shadow{};
+            std::vector<shelf> shelves{};
+            uint32 top{0};
+            std::size_t entries{0};
+        };
+
+        struct entry {
+            std::size_t page;
+            std::size_t shelf;
+            pixmap_rect rect; // Including padding
+            uint64 lastUsed;
+        };
+
+        struct allocation {
+            std::size_t page, shelf;
+            uint32 x;
+        };
+
+        const uint32 pageSize;
+        const std::size_t maxPages;
+        const pixmap_format format;
+        const uint32 padding;
+        const GLenum internalFormat;
+
+        std::vector<page> pages{};
+        std::unordered_map<entry_id, entry> entries{};
+        entry_id nextId{1};
+        uint64 frame{1};
+        uint64 generation{0};
+        dynamic_atlas_stats stats{};
+
+        LIBMUSUBI_DELCP(impl)
+
+        impl(uint32 pageSize, std::size_t maxPages, pixmap_format format, uint32 padding, GLenum internalFormat)
+                : pageSize(pageSize), maxPages(maxPages), format(format),
+                  padding(padding), internalFormat(internalFormat) {}
+
+        [[nodiscard]] std::size_t get_stride() const noexcept { return pageSize * get_bytes_per_pixel(format); }
+
+        [[nodiscard]] pixmap_view get_shadow_view(const page &page) const {
+            return pixmap_view(page.shadow.data(), format, pageSize, pageSize, get_stride());
+        }
+
+        page &add_page() {
+            auto &result = pages.emplace_back();
+            result.shadow.assign(get_stride() * pageSize, byte{0});
+            result.texture = std::make_shared<texture>(get_shadow_view(result), false, internalFormat);
+            result.texture->set_category(texture_category::dynamic);
+            return result;
+        }
+
+        /// Takes a run of the specified width from a shelf, returning its x position.
+        static std::optional<uint32> take_span(shelf &shelf, uint32 width) {
+            for (auto it = shelf.free.begin(); it != shelf.free.end(); ++it) {
+                if (it->width < width) continue;
+                const auto x = it->x;
+                it->x += width;
+                it->width -= width;
+                if (it->width == 0) shelf.free.erase(it);
+                return x;
+            }
+            return std::nullopt;
+        }
+
+        /// Returns a run to a shelf, merging it with adjacent free runs.
+        static void return_span(shelf &shelf, uint32 x, uint32 width) {
+            auto it = std::lower_bound(shelf.free.begin(), shelf.free.end(), x,
+                                       [](const span &span, uint32 value) { return span.x < value; });
+            it = shelf.free.insert(it, span{x, width});
+            if (std::next(it) != shelf.free.end() && it->x + it->width == std::next(it)->x) {
+                it->width += std::next(it)->width;
+                shelf.free.erase(std::next(it));
+            }
+            if (it != shelf.free.begin() && std::prev(it)->x + std::prev(it)->width == it->x) {
+                std::prev(it)->width += it->width;
+                shelf.free.erase(it);
+            }
+        }
+
+        /// Allocates a rectangle in an existing page, opening a new shelf if no existing shelf fits well.
+        std::optional<allocation> allocate_in(std::size_t pageIndex, uint32 width, uint32 height) {
+            auto &page = pages[pageIndex];
+
+            // Best fit: the shelf with the least wasted height that has a wide enough run
+            std::optional<std::size_t> best{};
+            for (std::size_t i = 0; i < page.shelves.size(); ++i) {
+                const auto &shelf = page.shelves[i];
+                if (shelf.height < height) continue;
+                if (best && page.shelves[*best].height <= shelf.height) continue;
+                const auto hasRun = std::any_of(shelf.free.begin(), shelf.free.end(),
+                                                [width](const span &span) { return span.width >= width; });
+                if (hasRun) best = i;
+            }
+
+            // Prefer opening a new shelf over wasting more than half of an existing shelf's height
+            const auto canOpen = pageSize - page.top >= height;
+            if (canOpen && (!best || page.shelves[*best].height - height > height / 2)) {
+                page.shelves.push_back(shelf{page.top, height, {span{0, pageSize}}});
+                page.top += height;
+                best = page.shelves.size() - 1;
+            }
+            if (!best) return std::nullopt;
+
+            const auto x = take_span(page.shelves[*best], width);
+            return allocation{pageIndex, *best, *x};
+        }
+
+        std::optional<allocation> allocate(uint32 width, uint32 height) {
+            for (std::size_t i = 0; i < pages.size(); ++i) {
+                if (auto result = allocate_in(i, width, height)) return result;
+            }
+            if (pages.size() < maxPages) {
+                add_page();
+                return allocate_in(pages.size() - 1, width, height);
+            }
+            return std::nullopt;
+        }
+
+        void release(const entry &entry) {
+            auto &page = pages[entry.page];
+            auto &shelf = page.shelves[entry.shelf];
+            return_span(shelf, entry.rect.x, entry.rect.width);
+            --page.entries;
+            stats.usedArea -= uint64{entry.rect.width} * entry.rect.height;
+
+            // Reclaim the height of empty shelves at the top of the page
+            while (!page.shelves.empty()) {
+                const auto &last = page.shelves.back();
+                if (last.free.size() != 1 || last.free.front().width != pageSize) break;
+                page.top = last.y;
+                page.shelves.pop_back();
+            }
+        }
+
+        /// Copies a pixmap into the shadow copy of a page, clearing the padding around it.
+        void write_shadow(page &page, const pixmap_rect &rect, const pixmap_view &source) {
+            const auto stride = get_stride();
+            const auto bytesPerPixel = get_bytes_per_pixel(format);
+            for (uint32 y = 0; y < rect.height; ++y) {
+                std::memset(page.shadow.data() + (rect.y + y) * stride + rect.x * bytesPerPixel,
+                            0, rect.width * bytesPerPixel);
+            }
+            if (source.data()) {
+                copy_pixels(page.shadow.data() + rect.y * stride + rect.x * bytesPerPixel,
+                            stride, format, source, blend_mode::copy);
+            }
+        }
+
+        std::optional<entry_id> insert(const pixmap &source) {
+            if (source.get_format() != format) {
+                throw std::invalid_argument("Cannot insert pixmap into atlas; source format differs from atlas format");
+            }
+            if (source.get_width() == 0 || source.get_height() == 0) {
+                throw std::invalid_argument("Cannot insert pixmap into atlas; source is empty");
+            }
+            const auto width = source.get_width() + padding, height = source.get_height() + padding;
+            if (width > pageSize || height > pageSize) {
+                throw std::invalid_argument("Cannot insert pixmap into atlas; "s
+                                            + std::to_string(source.get_width()) + "x"s
+                                            + std::to_string(source.get_height())
+                                            + " does not fit into a page of size "s + std::to_string(pageSize));
+            }
+
+            auto slot = allocate(width, height);
+            if (!slot) slot = evict_until_fits(width, height);
+            if (!slot) return std::nullopt;
+
+            auto &page = pages[slot->page];
+            const auto &shelf = page.shelves[slot->shelf];
+            const pixmap_rect rect{slot->x, shelf.y, width, height};
+            write_shadow(page, rect, source);
+            page.texture->update(get_shadow_view(page), rect);
+
+            const auto id = nextId++;
+            entries.emplace(id, entry{slot->page, slot->shelf, rect, frame});
+            ++page.entries;
+            ++stats.insertions;
+            stats.usedArea += uint64{width} * height;
+            return id;
+        }
+
+        /// Evicts least recently used entries not used in the current frame, until a rectangle fits.
+        std::optional<allocation> evict_until_fits(uint32 width, uint32 height) {
+            std::vector<std::pair<uint64, entry_id>> candidates;
+            for (const auto &[id, entry] : entries) {
+                if (entry.lastUsed < frame) candidates.emplace_back(entry.lastUsed, id);
+            }
+            std::sort(candidates.begin(), candidates.end());
+
+            for (const auto &candidate : candidates) {
+                const auto it = entries.find(candidate.second);
+                const auto page = it->second.page;
+                release(it->second);
+                entries.erase(it);
+                ++stats.evictions;
+                ++generation;
+
+                if (auto result = allocate_in(page, width, height)) return result;
+            }
+            return std::nullopt;
+        }
+
+        void defragment() {
+            std::vector<std::pair<entry_id, entry *>> live;
+            live.reserve(entries.size());
+            for (auto &[id, entry] : entries) live.emplace_back(id, &entry);
+            // Tallest first packs shelves most tightly
+            std::sort(live.begin(), live.end(), [](const auto &a, const auto &b) {
+                if (a.second->rect.height != b.second->rect.height) {
+                    return a.second->rect.height > b.second->rect.height;
+                }
+                return a.second->rect.width > b.second->rect.width;
+            });
+
+            std::vector<std::vector<byte>> oldShadows;
+            oldShadows.reserve(pages.size());
+            for (auto &page : pages) {
+                oldShadows.push_back(std::move(page.shadow));
+                page.shadow.assign(get_stride() * pageSize, byte{0});
+                page.shelves.clear();
+                page.top = 0;
+                page.entries = 0;
+            }
+            stats.usedArea = 0;
+
+            const auto bytesPerPixel = get_bytes_per_pixel(format);
+            std::vector<entry_id> lost;
+            for (const auto &[id, entry] : live) {
+                std::optional<allocation> slot{};
+                for (std::size_t i = 0; i < pages.size() && !slot; ++i) {
+                    slot = allocate_in(i, entry->rect.width, entry->rect.height);
+                }
+                if (!slot) {
+                    lost.push_back(id);
+                    continue;
+                }
+
+                auto &page = pages[slot->page];
+                const pixmap_rect rect{slot->x, page.shelves[slot->shelf].y, entry->rect.width, entry->rect.height};
+                const pixmap_view source(
+                        oldShadows[entry->page].data() + entry->rect.y * get_stride() + entry->rect.x * bytesPerPixel,
+                        format, entry->rect.width, entry->rect.height, get_stride()
+                );
+                write_shadow(page, rect, source);
+
+                entry->page = slot->page;
+                entry->shelf = slot->shelf;
+                entry->rect = rect;
+                ++page.entries;
+                stats.usedArea += uint64{rect.width} * rect.height;
+            }
+            for (const auto id : lost) entries.erase(id);
+            stats.evictions += lost.size();
+
+            // Entries are packed into the first pages; release trailing empty pages
+            while (!pages.empty() && pages.back().entries == 0) pages.pop_back();
+            for (auto &page : pages) {
+                page.texture->update(get_shadow_view(page), {0, 0, pageSize, pageSize});
+            }
+
+            ++stats.defragmentations;
+            ++generation;
+        }
+    };
+
+    dynamic_atlas::dynamic_atlas(uint32 pageSize, std::size_t maxPages, pixmap_format format, uint32 padding,
+                                 GLenum internalFormat) {
+        if (pageSize == 0) throw std::invalid_argument("Cannot create atlas; page size is zero");
+        if (maxPages == 0) throw std::invalid_argument("Cannot create atlas; maximum number of pages is zero");
+        pImpl = std::make_unique<impl>(pageSize, maxPages, format, padding, internalFormat);
+    }
+
+    dynamic_atlas::~dynamic_atlas() noexcept = default;
+
+    std::optional<dynamic_atlas::entry_id> dynamic_atlas::insert(const pixmap &source) {
+        return pImpl->insert(source);
+    }
+
+    bool dynamic_atlas::contains(entry_id id) const { return pImpl->entries.count(id) != 0; }
+
+    texture_region dynamic_atlas::get_region(entry_id id) {
+        const auto it = pImpl->entries.find(id);
+        if (it == pImpl->entries.end()) {
+            throw std::out_of_range("Atlas does not contain entry "s + std::to_string(id));
+        }
+
+        auto &entry = it->second;
+        entry.lastUsed = pImpl->frame;
+        // The entry's pixels exclude the padding at its right and bottom edges
+        const auto size = static_cast<GLfloat>(pImpl->pageSize);
+        const auto &rect = entry.rect;
+        return texture_region(pImpl->pages[entry.page].texture,
+                              static_cast<GLfloat>(rect.x) / size, static_cast<GLfloat>(rect.y) / size,
+                              static_cast<GLfloat>(rect.x + rect.width - pImpl->padding) / size,
+                              static_cast<GLfloat>(rect.y + rect.height - pImpl->padding) / size);
+    }
+
+    bool dynamic_atlas::erase(entry_id id) {
+        const auto it = pImpl->entries.find(id);
+        if (it == pImpl->entries.end()) return false;
+        pImpl->release(it->second);
+        pImpl->entries.erase(it);
+        return true;
+    }
+
+    void dynamic_atlas::next_frame() noexcept { ++pImpl->frame; }
+
+    void dynamic_atlas::defragment() { pImpl->defragment(); }
+
+    uint64 dynamic_atlas::get_generation() const noexcept { return pImpl->generation; }
+
+    std::size_t dynamic_atlas::get_page_count() const noexcept { return pImpl->pages.size(); }
+
+    std::shared_ptr<texture> dynamic_atlas::get_page(std::size_t index) const {
+        if (index >= pImpl->pages.size()) {
+            throw std::out_of_range("Atlas page index out of range: "s + std::to_string(index)
+                                    + " >= "s + std::to_string(pImpl->pages.size()));
+        }
+        return pImpl->pages[index].texture;
+    }
+
+    uint32 dynamic_atlas::get_page_size() const noexcept { return pImpl->pageSize; }
+
+    pixmap_format dynamic_atlas::get_format() const noexcept { return pImpl->format; }
+
+    dynamic_atlas_stats dynamic_atlas::get_stats() const {
+        auto result = pImpl->stats;
+        result.pages = pImpl->pages.size();
+        result.entries = pImpl->entries.size();
+        result.capacity = uint64{pImpl->pageSize} * pImpl->pageSize * pImpl->pages.size();
+        return result;
+    }
+}
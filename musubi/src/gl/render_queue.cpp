@@ -0,0 +1,260 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#include <musubi/gl/render_queue.h>
+
+#include <musubi/common.h>
+#include <musubi/exception.h>
+
+#include <array>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+    using musubi::uint32, musubi::uint64;
+
+    // Sort key layout, from most to least significant bit: layer (8 bits), shader (2), blend (2), texture (20),
+    // depth (32). Shader and blend changes both end the current batch, so they are grouped first;
+    // texture changes within a batch only assign another sampler slot, and are the cheapest to split on.
+    constexpr uint32 LAYER_SHIFT = 56u;
+    constexpr uint32 SHADER_SHIFT = 54u;
+    constexpr uint32 BLEND_SHIFT = 52u;
+    constexpr uint32 TEXTURE_SHIFT = 32u;
+    constexpr uint64 TEXTURE_MASK = (uint64{1} << 20u) - 1;
+    constexpr uint64 BLEND_MASK = 0x3u;
+
+    /// The renderer drawing a command.
+    enum class shader_id : uint64 {
+        sprites,
+        lines
+    };
+
+    constexpr shader_id get_shader(uint64 key) noexcept {
+        return static_cast<shader_id>((key >> SHADER_SHIFT) & 0x3u);
+    }
+
+    constexpr musubi::gl::render_blend get_blend(uint64 key) noexcept {
+        return static_cast<musubi::gl::render_blend>((key >> BLEND_SHIFT) & BLEND_MASK);
+    }
+
+    void apply_blend(musubi::gl::render_blend blend) noexcept {
+        switch (blend) {
+            case musubi::gl::render_blend::opaque:
+                glDisable(GL_BLEND);
+                break;
+            case musubi::gl::render_blend::alpha:
+                glEnable(GL_BLEND);
+                glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+                break;
+            case musubi::gl::render_blend::additive:
+                glEnable(GL_BLEND);
+                glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+                break;
+        }
+    }
+}
+
+namespace musubi::gl {
+    using namespace musubi::detail;
+
+    struct render_queue::impl {
+        struct command {
+            // Textures: x, y, width, height; lines: x1, y1, x2, y2
+            GLfloat a, b, c, d;
+            GLfloat u1, v1, u2, v2;
+            glm::mat3 transform;
+            glm::vec4 color;
+            uint32 texture;
+        };
+
+        std::vector<command> commands{};
+        std::vector<uint64> keys{};
+        // Commands are referenced by index while sorting, so that only keys and indices are moved
+        std::vector<uint64> sortKeys{}, scratchKeys{};
+        std::vector<uint32> order{}, scratchOrder{};
+
+        // Distinct textures of the pending commands, in first-use order
+        std::vector<std::shared_ptr<texture>> textures{};
+        std::unordered_map<const texture *, uint32> textureIndices{};
+
+        LIBMUSUBI_DELCP(impl)
+
+        impl() = default;
+
+        ~impl() noexcept = default;
+
+        uint32 get_texture_index(const std::shared_ptr<texture> &texture) {
+            const auto [it, inserted] = textureIndices.try_emplace(texture.get(), static_cast<uint32>(textures.size()));
+            if (inserted) textures.push_back(texture);
+            return it->second;
+        }
+
+        void push(const render_state &state, shader_id shader, command &&entry) {
+            const auto key = (uint64{state.layer} << LAYER_SHIFT)
+                             | (static_cast<uint64>(shader) << SHADER_SHIFT)
+                             | ((static_cast<uint64>(state.blend) & BLEND_MASK) << BLEND_SHIFT)
+                             | ((uint64{entry.texture} & TEXTURE_MASK) << TEXTURE_SHIFT)
+                             | uint64{state.depth};
+            commands.push_back(std::move(entry));
+            keys.push_back(key);
+        }
+
+        /// Sorts the command indices by key through a least-significant-digit radix sort over bytes.
+        void sort() {
+            const auto n = keys.size();
+            sortKeys.assign(keys.begin(), keys.end());
+            scratchKeys.resize(n);
+            order.resize(n);
+            scratchOrder.resize(n);
+            for (uint32 i = 0; i < n; ++i) order[i] = i;
+
+            for (uint32 shift = 0; shift < 64; shift += 8) {
+                std::array<std::size_t, 256> offsets{};
+                for (const auto key : sortKeys) ++offsets[(key >> shift) & 0xFFu];
+                // Skip bytes that are equal for all keys, such as unused layers or depths
+                if (offsets[(sortKeys[0] >> shift) & 0xFFu] == n) continue;
+
+                std::size_t total = 0;
+                for (auto &offset : offsets) total += std::exchange(offset, total);
+                for (std::size_t i = 0; i < n; ++i) {
+                    const auto target = offsets[(sortKeys[i] >> shift) & 0xFFu]++;
+                    scratchKeys[target] = sortKeys[i];
+                    scratchOrder[target] = order[i];
+                }
+                sortKeys.swap(scratchKeys);
+                order.swap(scratchOrder);
+            }
+        }
+
+        void clear() noexcept {
+            commands.clear();
+            keys.clear();
+            textures.clear();
+            textureIndices.clear();
+        }
+    };
+
+    render_queue::render_queue() : pImpl(std::make_unique<impl>()) {}
+
+    render_queue::~render_queue() noexcept = default;
+
+    void render_queue::draw_texture(const render_state &state, const std::shared_ptr<texture> &texture,
+                                    GLfloat x, GLfloat y, GLfloat width, GLfloat height,
+                                    const glm::mat3 &transform, const glm::vec4 &tint) {
+        if (!texture) throw std::invalid_argument("Cannot record draw command; specified texture pointer is empty");
+        if (!*texture) throw std::invalid_argument("Cannot record draw command; specified texture is invalid");
+
+        pImpl->push(state, shader_id::sprites, {
+                x, y, width, height, 0, 0, 1, 1, transform, tint, pImpl->get_texture_index(texture)
+        });
+    }
+
+    void render_queue::draw_region(const render_state &state, const texture_region &region,
+                                   GLfloat x, GLfloat y, GLfloat width, GLfloat height,
+                                   const glm::mat3 &transform, const glm::vec4 &tint) {
+        const auto texture = region.texture.lock();
+        if (!texture) throw std::invalid_argument("Specified texture_region refers to a deleted texture");
+
+        pImpl->push(state, shader_id::sprites, {
+                x, y, width, height, region.u1, region.v1, region.u2, region.v2,
+                transform, tint, pImpl->get_texture_index(texture)
+        });
+    }
+
+    void render_queue::draw_line(const render_state &state, GLfloat x1, GLfloat y1, GLfloat x2, GLfloat y2,
+                                 const glm::vec4 &color, const glm::mat3 &transform) {
+        pImpl->push(state, shader_id::lines, {x1, y1, x2, y2, 0, 0, 0, 0, transform, color, 0});
+    }
+
+    std::size_t render_queue::size() const noexcept { return pImpl->commands.size(); }
+
+    void render_queue::clear() noexcept { pImpl->clear(); }
+
+    render_queue_stats render_queue::submit(gl_texture_renderer &textures, gl_shape_renderer &shapes) {
+        render_queue_stats stats{};
+        stats.commands = pImpl->commands.size();
+        stats.textures = pImpl->textures.size();
+        if (pImpl->commands.empty()) return stats;
+
+        pImpl->sort();
+
+        const auto textureTransform = textures.drawTransform, shapeTransform = shapes.drawTransform;
+        const auto textureTint = textures.tint, shapeColor = shapes.color;
+        const auto restore_state = [&]() noexcept {
+            glDisable(GL_BLEND);
+            textures.drawTransform = textureTransform;
+            textures.tint = textureTint;
+            shapes.drawTransform = shapeTransform;
+            shapes.color = shapeColor;
+            pImpl->clear();
+        };
+
+        std::optional<shader_id> activeShader{};
+        std::optional<render_blend> activeBlend{};
+        const auto end_active_batch = [&]() {
+            if (!activeShader) return;
+            // Reset first, so that a batch is never ended twice
+            const auto shader = *std::exchange(activeShader, std::nullopt);
+            if (shader == shader_id::sprites) {
+                textures.end_batch(false);
+            } else {
+                shapes.end_batch(false);
+            }
+        };
+
+        try {
+            for (std::size_t i = 0; i < pImpl->order.size(); ++i) {
+                const auto key = pImpl->sortKeys[i];
+                const auto shader = get_shader(key);
+                const auto blend = get_blend(key);
+
+                // Runs of commands with the same shader and blend state are merged into one batch
+                if (shader != activeShader || blend != activeBlend) {
+                    end_active_batch();
+                    if (blend != activeBlend) {
+                        apply_blend(blend);
+                        activeBlend = blend;
+                        ++stats.blendChanges;
+                    }
+                    if (shader == shader_id::sprites) {
+                        textures.begin_batch();
+                    } else {
+                        shapes.begin_batch();
+                    }
+                    activeShader = shader;
+                    ++stats.batches;
+                }
+
+                const auto &command = pImpl->commands[pImpl->order[i]];
+                if (shader == shader_id::sprites) {
+                    textures.drawTransform = command.transform;
+                    textures.tint = command.color;
+                    textures.batch_draw_texture(pImpl->textures[command.texture],
+                                                command.a, command.b, command.c, command.d,
+                                                command.u1, command.v1, command.u2, command.v2);
+                } else {
+                    shapes.drawTransform = command.transform;
+                    shapes.color = command.color;
+                    shapes.batch_draw_line(command.a, command.b, command.c, command.d);
+                }
+            }
+            end_active_batch();
+        } catch (...) {
+            // Leave the renderers usable: end the batch that was open when the draw failed, and restore their state
+            try {
+                end_active_batch();
+            } catch (...) {
+                log_e("render_queue") << "Could not end the active batch after a failed submission\n";
+            }
+            restore_state();
+            throw;
+        }
+
+        restore_state();
+        return stats;
+    }
+}
@@ -6,14 +6,27 @@
 
 #include <musubi/gl/common.h>
 #include <musubi/gl/shaders.h>
+#include <musubi/gl/static_batch.h>
+#include <musubi/gl/stream_buffer.h>
+
+#include "simd/vertex_kernels.h"
 
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
-#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <memory>
 
 namespace {
     constexpr glm::mat4 IDENTITY{glm::identity<glm::mat4>()};
+
+    /// The minimum number of vertices reserved from the stream buffer at once.
+    constexpr std::size_t MIN_RESERVED_VERTICES = 4096u;
+
+    static_assert(sizeof(musubi::gl::line) == sizeof(musubi::detail::line_source)
+                  && offsetof(musubi::gl::line, color) == offsetof(musubi::detail::line_source, color),
+                  "line must match the layout of the vertex kernels' line_source");
 }
 
 namespace musubi::gl {
@@ -22,11 +35,27 @@ namespace musubi::gl {
         // Cached locations
         GLint modelMatrixUniform{-1}, viewMatrixUniform{-1}, projectionMatrixUniform{-1};
 
+        struct vertex {
+            GLfloat x, y, z;
+            GLfloat r, g, b, a;
+        };
+
+        static_assert(sizeof(vertex) == sizeof(::musubi::detail::line_vertex)
+                      && offsetof(vertex, r) == offsetof(::musubi::detail::line_vertex, r),
+                      "vertex must match the layout of the vertex kernels' line_vertex");
+
         GLuint vao{0};
+        std::unique_ptr<stream_buffer> vertexBuffer{};
 
+        // Vertices are written directly into the reserved stream buffer memory
         GLuint count{0};
-        std::vector<GLfloat> vertices{};
-        std::vector<GLfloat> colors{};
+        vertex *vertices{nullptr};
+        std::size_t capacity{0};
+
+        uint32 maxBatchSize{DEFAULT_MAX_BATCH_SIZE};
+        batch_stats stats{};
+        // Rebuilt on the first culled draw of a batch, and whenever the camera or transformation changes
+        view_culler_cache culler{};
 
         bool drawing{false};
 
@@ -66,87 +95,187 @@ namespace musubi::gl {
             projectionMatrixUniform = glGetUniformLocation(shader, "mP");
 
             glGenVertexArrays(1, &vao);
+            vertexBuffer = std::make_unique<stream_buffer>();
         }
 
         ~impl() { glDeleteVertexArrays(1, &vao); }
 
         void begin_batch() {
             if (drawing) throw illegal_state_error("Cannot call begin_batch twice, renderer is already drawing");
+            culler.invalidate();
             drawing = true;
         }
 
         void end_batch(const gl_shape_renderer &parent) {
             if (!drawing) throw illegal_state_error("Cannot end shape batch, begin has not yet been called");
-            flush(parent);
+            flush(parent, flush_reason::explicit_flush);
             drawing = false;
         }
 
-        void flush(const gl_shape_renderer &parent) {
-            GLuint vbo{0};
-            glBindVertexArray(vao);
-            glGenBuffers(1, &vbo);
-            glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        void flush(const gl_shape_renderer &parent, flush_reason reason) {
+            if (!vertexBuffer->is_reserved()) return;
 
-            glBufferData(GL_ARRAY_BUFFER, count * 7 * sizeof(GLfloat), nullptr, GL_STREAM_DRAW);
-            glBufferSubData(GL_ARRAY_BUFFER, 0, count * 3 * sizeof(GLfloat), vertices.data());
-            glBufferSubData(GL_ARRAY_BUFFER, count * 3 * sizeof(GLfloat), count * 4 * sizeof(GLfloat), colors.data());
+            const auto offset = vertexBuffer->commit(count * sizeof(vertex));
+            vertices = nullptr;
+            capacity = 0;
+            if (count == 0) return;
+
+            glBindVertexArray(vao);
+            glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer->get_buffer());
 
             glEnableVertexAttribArray(0);
             glEnableVertexAttribArray(1);
-            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
-            glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, 0, get_buffer_offset(count * 3 * sizeof(GLfloat)));
-
-            glUseProgram(shader);
+            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(vertex),
+                                  get_buffer_offset(static_cast<GLuint>(offset + offsetof(vertex, x))));
+            glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(vertex),
+                                  get_buffer_offset(static_cast<GLuint>(offset + offsetof(vertex, r))));
 
-            glUniformMatrix4fv(modelMatrixUniform, 1, GL_FALSE, glm::value_ptr(parent.transform));
-            glUniformMatrix4fv(viewMatrixUniform, 1, GL_FALSE, glm::value_ptr(parent.camera.view));
-            glUniformMatrix4fv(projectionMatrixUniform, 1, GL_FALSE, glm::value_ptr(parent.camera.projection));
+            use_shader(parent);
 
             glDrawArrays(GL_LINES, 0, count);
+            stats.record(reason, count / 2, count);
 
             glDisableVertexAttribArray(0);
             glDisableVertexAttribArray(1);
 
-            glDeleteBuffers(1, &vbo);
-
             glUseProgram(0);
             glBindVertexArray(0);
 
             count = 0;
-            vertices.clear();
-            colors.clear();
         }
 
-        void draw_line_impl(GLfloat x1, GLfloat y1, GLfloat x2, GLfloat y2, const glm::vec4 &lineColor) {
-            vertices.push_back(x1);
-            vertices.push_back(y1);
-            vertices.push_back(0.0f);
-            vertices.push_back(x2);
-            vertices.push_back(y2);
-            vertices.push_back(0.0f);
-            colors.push_back(lineColor.r);
-            colors.push_back(lineColor.g);
-            colors.push_back(lineColor.b);
-            colors.push_back(lineColor.a);
-            colors.push_back(lineColor.r);
-            colors.push_back(lineColor.g);
-            colors.push_back(lineColor.b);
-            colors.push_back(lineColor.a);
-            count += 2;
+        /// Binds the shader program and sets its matrices from the renderer.
+        void use_shader(const gl_shape_renderer &parent) const {
+            glUseProgram(shader);
+            glUniformMatrix4fv(modelMatrixUniform, 1, GL_FALSE, glm::value_ptr(parent.transform));
+            glUniformMatrix4fv(viewMatrixUniform, 1, GL_FALSE, glm::value_ptr(parent.camera.view));
+            glUniformMatrix4fv(projectionMatrixUniform, 1, GL_FALSE, glm::value_ptr(parent.camera.projection));
+        }
+
+        void draw_static(const static_batch &batch, const gl_shape_renderer &parent) {
+            if (!batch.is_uploaded()) throw illegal_state_error("Cannot draw static batch; it has not been uploaded");
+            const auto lines = batch.get_line_count();
+            if (lines == 0) return;
+            // Pending lines were issued before the static batch, so they are drawn first
+            if (drawing) flush(parent, flush_reason::retained);
+
+            if (parent.culling && !view_culler(parent.camera, parent.transform).is_visible(batch.get_line_bounds())) {
+                stats.culled += lines;
+                return;
+            }
+
+            glBindVertexArray(batch.get_line_vertex_array());
+            use_shader(parent);
+            glDrawArrays(GL_LINES, 0, static_cast<GLsizei>(lines * 2));
+            stats.record(flush_reason::retained, lines, lines * 2);
+            glUseProgram(0);
+            glBindVertexArray(0);
+        }
+
+        /// Ensures that `n` more vertices can be written,
+        /// flushing the pending draw if the reserved memory is full or the batch size limit is reached.
+        void reserve(const gl_shape_renderer &parent, std::size_t n) {
+            if (count + n <= capacity) return;
+            flush(parent, flush_reason::capacity);
+
+            const auto memory = vertexBuffer->reserve(std::max(n, MIN_RESERVED_VERTICES) * sizeof(vertex));
+            vertices = reinterpret_cast<vertex *>(memory.data());
+            capacity = std::min<std::size_t>(memory.size() / sizeof(vertex), maxBatchSize * std::size_t{2});
+        }
+
+        void draw_line_impl(const gl_shape_renderer &parent,
+                            GLfloat x1, GLfloat y1, GLfloat x2, GLfloat y2, const glm::vec4 &lineColor) {
+            const auto &m = parent.drawTransform;
+            const glm::vec2 p1{m * glm::vec3{x1, y1, 1}}, p2{m * glm::vec3{x2, y2, 1}};
+            if (parent.culling && !culler.update(parent.camera, parent.transform).is_visible(
+                    std::min(p1.x, p2.x), std::min(p1.y, p2.y), std::max(p1.x, p2.x), std::max(p1.y, p2.y))) {
+                ++stats.culled;
+                return;
+            }
+
+            reserve(parent, 2);
+            vertices[count++] = {p1.x, p1.y, 0.0f, lineColor.r, lineColor.g, lineColor.b, lineColor.a};
+            vertices[count++] = {p2.x, p2.y, 0.0f, lineColor.r, lineColor.g, lineColor.b, lineColor.a};
+        }
+
+        /// Tests the bounding box of a shape, given in draw coordinates, and counts its lines as culled if it is
+        /// not visible. This allows skipping whole shapes before generating their lines.
+        bool cull_shape(const gl_shape_renderer &parent, GLfloat minX, GLfloat minY, GLfloat maxX, GLfloat maxY,
+                        uint32 lines) {
+            if (!parent.culling) return false;
+
+            const auto &m = parent.drawTransform;
+            const glm::vec2 origin{m * glm::vec3{minX, minY, 1}};
+            const glm::vec2 right{m[0] * (maxX - minX)}, up{m[1] * (maxY - minY)};
+            const auto opposite = origin + right + up;
+            const auto &visibility = culler.update(parent.camera, parent.transform);
+            if (visibility.is_visible(std::min({origin.x, origin.x + right.x, origin.x + up.x, opposite.x}),
+                                      std::min({origin.y, origin.y + right.y, origin.y + up.y, opposite.y}),
+                                      std::max({origin.x, origin.x + right.x, origin.x + up.x, opposite.x}),
+                                      std::max({origin.y, origin.y + right.y, origin.y + up.y, opposite.y}))) {
+                return false;
+            }
+            stats.culled += lines;
+            return true;
         }
 
         void batch_draw_line(const gl_shape_renderer &parent, GLfloat x1, GLfloat y1, GLfloat x2, GLfloat y2) {
             if (!drawing) throw illegal_state_error("Cannot add draw operation; batch has not been begun");
-            draw_line_impl(x1, y1, x2, y2, parent.color);
+            draw_line_impl(parent, x1, y1, x2, y2, parent.color);
+        }
+
+        [[nodiscard]] bool is_line_visible(const line &line, const glm::mat3 &m) const noexcept {
+            const glm::vec2 p1{m * glm::vec3{line.x1, line.y1, 1}}, p2{m * glm::vec3{line.x2, line.y2, 1}};
+            return culler.get().is_visible(std::min(p1.x, p2.x), std::min(p1.y, p2.y),
+                                           std::max(p1.x, p2.x), std::max(p1.y, p2.y));
+        }
+
+        void batch_draw_lines(const gl_shape_renderer &parent, span<const line> lines) {
+            if (!drawing) throw illegal_state_error("Cannot add draw operation; batch has not been begun");
+
+            const auto &kernels = ::musubi::detail::get_vertex_kernels();
+            const auto transform = ::musubi::detail::to_affine_transform(glm::value_ptr(parent.drawTransform));
+            if (parent.culling) culler.update(parent.camera, parent.transform);
+
+            std::size_t next = 0;
+            while (next < lines.size()) {
+                if (parent.culling) {
+                    while (next < lines.size() && !is_line_visible(lines[next], parent.drawTransform)) {
+                        ++stats.culled;
+                        ++next;
+                    }
+                    if (next == lines.size()) break;
+                }
+
+                if (count + 2 > capacity) {
+                    reserve(parent, std::min((lines.size() - next) * 2, maxBatchSize * std::size_t{2}));
+                }
+                auto n = std::min<std::size_t>(lines.size() - next, (capacity - count) / 2);
+                if (parent.culling) {
+                    // Generate the run of visible lines; the first one has already been tested
+                    std::size_t visible = 1;
+                    while (visible < n && is_line_visible(lines[next + visible], parent.drawTransform)) ++visible;
+                    n = visible;
+                }
+
+                kernels.generate_lines(reinterpret_cast<::musubi::detail::line_vertex *>(vertices + count),
+                                       reinterpret_cast<const ::musubi::detail::line_source *>(&lines[next]),
+                                       n, transform);
+                count += static_cast<GLuint>(n * 2);
+                next += n;
+            }
         }
 
         void batch_draw_rectangle(const gl_shape_renderer &parent, GLfloat x, GLfloat y, GLfloat w, GLfloat h) {
             if (!drawing) throw illegal_state_error("Cannot add draw operation; batch has not been begun");
+            if (cull_shape(parent, std::min(x, x + w), std::min(y, y + h), std::max(x, x + w), std::max(y, y + h), 4)) {
+                return;
+            }
 
-            draw_line_impl(x, y, x + w, y, parent.color);
-            draw_line_impl(x + w, y, x + w, y + h, parent.color);
-            draw_line_impl(x + w, y + h, x, y + h, parent.color);
-            draw_line_impl(x, y + h, x, y, parent.color);
+            draw_line_impl(parent, x, y, x + w, y, parent.color);
+            draw_line_impl(parent, x + w, y, x + w, y + h, parent.color);
+            draw_line_impl(parent, x + w, y + h, x, y + h, parent.color);
+            draw_line_impl(parent, x, y + h, x, y, parent.color);
         }
 
         void batch_draw_circle(const gl_shape_renderer &parent, GLfloat x, GLfloat y, GLfloat r, uint32 segments) {
@@ -155,6 +284,7 @@ namespace musubi::gl {
             if (segments < 3u) {
                 throw std::invalid_argument("Circle segment count must be >= 3, was: "s + std::to_string(segments));
             }
+            if (cull_shape(parent, x - r, y - r, x + r, y + r, segments)) return;
 
             GLfloat angle = 0;
             GLfloat step = 2 * pi<GLfloat> / segments;
@@ -162,7 +292,7 @@ namespace musubi::gl {
             for (GLuint i = 0; i < segments; angle += step, ++i) {
                 float currentX = r * std::cos(angle) + x;
                 float currentY = r * std::sin(angle) + y;
-                draw_line_impl(lastX, lastY, currentX, currentY, parent.color);
+                draw_line_impl(parent, lastX, lastY, currentX, currentY, parent.color);
                 lastX = currentX;
                 lastY = currentY;
             }
@@ -179,13 +309,33 @@ namespace musubi::gl {
 
     void gl_shape_renderer::end_batch(bool resetTransform) {
         pImpl->end_batch(*this);
-        if (resetTransform) transform = IDENTITY;
+        if (resetTransform) {
+            transform = IDENTITY;
+            drawTransform = glm::mat3{1.0f};
+        }
     }
 
+    uint32 gl_shape_renderer::get_max_batch_size() const noexcept { return pImpl->maxBatchSize; }
+
+    void gl_shape_renderer::set_max_batch_size(uint32 lines) {
+        if (lines == 0) throw std::invalid_argument("Maximum batch size must be positive");
+        pImpl->maxBatchSize = lines;
+        // Takes effect for the pending draw at its next line
+        pImpl->capacity = std::min<std::size_t>(pImpl->capacity, lines * std::size_t{2});
+    }
+
+    batch_stats gl_shape_renderer::get_stats() const noexcept { return pImpl->stats; }
+
+    void gl_shape_renderer::reset_stats() noexcept { pImpl->stats = {}; }
+
     void gl_shape_renderer::batch_draw_line(GLfloat x1, GLfloat y1, GLfloat x2, GLfloat y2) {
         pImpl->batch_draw_line(*this, x1, y1, x2, y2);
     }
 
+    void gl_shape_renderer::batch_draw_lines(span<const line> lines) { pImpl->batch_draw_lines(*this, lines); }
+
+    void gl_shape_renderer::draw_static(const static_batch &batch) { pImpl->draw_static(batch, *this); }
+
     void gl_shape_renderer::batch_draw_rectangle(GLfloat x, GLfloat y, GLfloat w, GLfloat h) {
         pImpl->batch_draw_rectangle(*this, x, y, w, h);
     }
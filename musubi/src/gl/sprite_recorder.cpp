@@ -0,0 +1,87 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#include <musubi/gl/sprite_recorder.h>
+
+#include "simd/vertex_kernels.h"
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+namespace musubi::gl {
+    struct sprite_recorder::impl {
+        std::vector<detail::sprite_vertex> vertices{};
+        std::vector<recorded_run> runs{};
+
+        LIBMUSUBI_DELCP(impl)
+
+        explicit impl(std::size_t reservedSprites) { vertices.reserve(reservedSprites * 4); }
+
+        ~impl() noexcept = default;
+
+        void record(const std::shared_ptr<texture> &texture, const sprite_recorder &parent,
+                    GLfloat x, GLfloat y, GLfloat width, GLfloat height,
+                    GLfloat u1, GLfloat v1, GLfloat u2, GLfloat v2) {
+            if (runs.empty() || runs.back().texture != texture) runs.push_back({texture, 0});
+            ++runs.back().sprites;
+
+            ::musubi::detail::quad_source sprite{x, y, width, height, u1, v1, u2, v2, {}};
+            ::musubi::detail::pack_color(sprite.tint, glm::value_ptr(parent.tint));
+
+            // Vertices are generated exactly like gl_texture_renderer generates them; sampler slots are assigned
+            // when the recorder is drawn
+            const auto first = vertices.size();
+            vertices.resize(first + 4);
+            ::musubi::detail::get_vertex_kernels().generate_quads(
+                    reinterpret_cast<::musubi::detail::quad_vertex *>(vertices.data() + first), &sprite, 1,
+                    ::musubi::detail::to_affine_transform(glm::value_ptr(parent.drawTransform)), 0,
+                    texture->should_flip()
+            );
+        }
+    };
+
+    sprite_recorder::sprite_recorder(std::size_t reservedSprites)
+            : pImpl(std::make_unique<impl>(reservedSprites)) {}
+
+    sprite_recorder::~sprite_recorder() noexcept = default;
+
+    void sprite_recorder::draw_texture(const std::shared_ptr<texture> &texture,
+                                       GLfloat x, GLfloat y, GLfloat width, GLfloat height) {
+        draw_texture(texture, x, y, width, height, 0, 0, 1, 1);
+    }
+
+    void sprite_recorder::draw_texture(const std::shared_ptr<texture> &texture,
+                                       GLfloat x, GLfloat y, GLfloat width, GLfloat height,
+                                       GLfloat u1, GLfloat v1, GLfloat u2, GLfloat v2) {
+        if (!texture) throw std::invalid_argument("Cannot record draw operation; specified texture pointer is empty");
+        if (!*texture) throw std::invalid_argument("Cannot record draw operation; specified texture is invalid");
+        pImpl->record(texture, *this, x, y, width, height, u1, v1, u2, v2);
+    }
+
+    void sprite_recorder::draw_region(const texture_region &region,
+                                      GLfloat x, GLfloat y, GLfloat width, GLfloat height) {
+        const auto texture = region.texture.lock();
+        if (!texture) throw std::invalid_argument("Specified texture_region refers to a deleted texture");
+        pImpl->record(texture, *this, x, y, width, height, region.u1, region.v1, region.u2, region.v2);
+    }
+
+    std::size_t sprite_recorder::size() const noexcept { return pImpl->vertices.size() / 4; }
+
+    bool sprite_recorder::empty() const noexcept { return pImpl->vertices.empty(); }
+
+    void sprite_recorder::clear() noexcept {
+        pImpl->vertices.clear();
+        pImpl->runs.clear();
+    }
+
+    span<const detail::sprite_vertex> sprite_recorder::get_vertices() const noexcept {
+        return {pImpl->vertices.data(), pImpl->vertices.size()};
+    }
+
+    span<const recorded_run> sprite_recorder::get_runs() const noexcept {
+        return {pImpl->runs.data(), pImpl->runs.size()};
+    }
+}
@@ -0,0 +1,253 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#include <musubi/gl/static_batch.h>
+
+#include <musubi/exception.h>
+#include <musubi/gl/common.h>
+#include <musubi/gl/sprite_recorder.h>
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+
+namespace musubi::gl {
+    struct static_batch::impl {
+        /// The vertex layout of lines, matching gl_shape_renderer.
+        struct line_vertex {
+            GLfloat x, y, z;
+            GLfloat r, g, b, a;
+        };
+
+        /// The largest number of quads in a segment; limited by the range of 16-bit indices.
+        static constexpr std::size_t MAX_QUADS = 65536u / 4u;
+
+        // Recorded geometry; released once uploaded
+        std::unique_ptr<sprite_recorder> sprites{};
+        std::vector<line_vertex> lines{};
+        bounding_box lineBounds{};
+        std::size_t spriteCount{0}, lineCount{0};
+
+        bool uploaded{false};
+        std::vector<static_batch_segment> segments{};
+        GLuint spriteVao{0}, lineVao{0};
+        GLuint spriteBuffer{0}, indexBuffer{0}, lineBuffer{0};
+
+        LIBMUSUBI_DELCP(impl)
+
+        impl() = default;
+
+        ~impl() noexcept { release(); }
+
+        void check_recording() const {
+            if (uploaded) throw illegal_state_error("Cannot record into static batch; it has already been uploaded");
+        }
+
+        sprite_recorder &get_recorder(const static_batch &parent) {
+            check_recording();
+            if (!sprites) sprites = std::make_unique<sprite_recorder>();
+            sprites->tint = parent.tint;
+            sprites->drawTransform = parent.drawTransform;
+            return *sprites;
+        }
+
+        void draw_line(const static_batch &parent, GLfloat x1, GLfloat y1, GLfloat x2, GLfloat y2) {
+            check_recording();
+            const auto &m = parent.drawTransform;
+            const auto &c = parent.color;
+            const glm::vec2 p1{m * glm::vec3{x1, y1, 1}}, p2{m * glm::vec3{x2, y2, 1}};
+            lines.push_back({p1.x, p1.y, 0.0f, c.r, c.g, c.b, c.a});
+            lines.push_back({p2.x, p2.y, 0.0f, c.r, c.g, c.b, c.a});
+            lineBounds.extend(p1.x, p1.y);
+            lineBounds.extend(p2.x, p2.y);
+            ++lineCount;
+        }
+
+        /// Assigns sampler slots to the recorded quads, splitting them into segments.
+        std::vector<detail::sprite_vertex> build_segments(uint32 maxSlots) {
+            std::vector<detail::sprite_vertex> result;
+            if (!sprites) return result;
+            result.reserve(sprites->get_vertices().size());
+
+            const auto *source = sprites->get_vertices().data();
+            for (const auto &run : sprites->get_runs()) {
+                for (std::size_t quad = 0; quad < run.sprites; ++quad, source += 4) {
+                    // Start a new segment once the current one is full, or uses all slots for other textures
+                    auto needsSegment = segments.empty()
+                                        || static_cast<std::size_t>(segments.back().quads) == MAX_QUADS;
+                    std::size_t slot = 0;
+                    if (!needsSegment) {
+                        const auto &textures = segments.back().textures;
+                        slot = static_cast<std::size_t>(
+                                std::find(textures.cbegin(), textures.cend(), run.texture) - textures.cbegin()
+                        );
+                        needsSegment = slot == textures.size() && textures.size() == maxSlots;
+                    }
+                    if (needsSegment) {
+                        segments.emplace_back().baseVertex = static_cast<GLint>(result.size());
+                        slot = 0;
+                    }
+
+                    auto &segment = segments.back();
+                    if (slot == segment.textures.size()) segment.textures.push_back(run.texture);
+                    for (std::size_t i = 0; i < 4; ++i) {
+                        auto vertex = source[i];
+                        vertex.slot = static_cast<GLubyte>(slot);
+                        result.push_back(vertex);
+                        segment.bounds.extend(vertex.x, vertex.y);
+                    }
+                    ++segment.quads;
+                }
+            }
+            return result;
+        }
+
+        void upload() {
+            if (uploaded) throw illegal_state_error("Cannot upload static batch; it has already been uploaded");
+
+            GLint maxUnits{0};
+            glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &maxUnits);
+            const auto maxSlots = std::clamp<uint32>(static_cast<uint32>(maxUnits), 1,
+                                                     gl_texture_renderer::MAX_TEXTURE_SLOTS);
+            const auto vertices = build_segments(maxSlots);
+
+            if (!vertices.empty()) {
+                std::size_t maxQuads = 0;
+                for (const auto &segment : segments) maxQuads = std::max<std::size_t>(maxQuads, segment.quads);
+                std::vector<GLushort> indices(maxQuads * 6);
+                for (std::size_t quad = 0; quad < maxQuads; ++quad) {
+                    const auto first = static_cast<GLushort>(quad * 4);
+                    const auto index = quad * 6;
+                    indices[index] = first;
+                    indices[index + 1] = first + 1;
+                    indices[index + 2] = first + 2;
+                    indices[index + 3] = first + 3;
+                    indices[index + 4] = first + 2;
+                    indices[index + 5] = first + 1;
+                }
+
+                glGenVertexArrays(1, &spriteVao);
+                glGenBuffers(1, &spriteBuffer);
+                glGenBuffers(1, &indexBuffer);
+                glBindVertexArray(spriteVao);
+                glBindBuffer(GL_ARRAY_BUFFER, spriteBuffer);
+                glBufferData(GL_ARRAY_BUFFER,
+                             static_cast<GLsizeiptr>(vertices.size() * sizeof(detail::sprite_vertex)),
+                             vertices.data(), GL_STATIC_DRAW);
+                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+                glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indices.size() * sizeof(GLushort)),
+                             indices.data(), GL_STATIC_DRAW);
+
+                // Matches the quad attributes of gl_texture_renderer
+                constexpr auto stride = static_cast<GLsizei>(sizeof(detail::sprite_vertex));
+                for (GLuint attribute = 0; attribute < 4; ++attribute) glEnableVertexAttribArray(attribute);
+                glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, stride,
+                                      get_buffer_offset(offsetof(detail::sprite_vertex, x)));
+                glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride,
+                                      get_buffer_offset(offsetof(detail::sprite_vertex, u)));
+                glVertexAttribIPointer(2, 1, GL_UNSIGNED_BYTE, stride,
+                                       get_buffer_offset(offsetof(detail::sprite_vertex, slot)));
+                glVertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride,
+                                      get_buffer_offset(offsetof(detail::sprite_vertex, tint)));
+            }
+
+            if (!lines.empty()) {
+                glGenVertexArrays(1, &lineVao);
+                glGenBuffers(1, &lineBuffer);
+                glBindVertexArray(lineVao);
+                glBindBuffer(GL_ARRAY_BUFFER, lineBuffer);
+                glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(lines.size() * sizeof(line_vertex)),
+                             lines.data(), GL_STATIC_DRAW);
+
+                // Matches the attributes of gl_shape_renderer
+                constexpr auto stride = static_cast<GLsizei>(sizeof(line_vertex));
+                glEnableVertexAttribArray(0);
+                glEnableVertexAttribArray(1);
+                glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, get_buffer_offset(offsetof(line_vertex, x)));
+                glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, get_buffer_offset(offsetof(line_vertex, r)));
+            }
+
+            glBindVertexArray(0);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+            sprites.reset();
+            std::vector<line_vertex>().swap(lines);
+            uploaded = true;
+        }
+
+        void release() noexcept {
+            if (uploaded) {
+                glDeleteVertexArrays(1, &spriteVao);
+                glDeleteVertexArrays(1, &lineVao);
+                glDeleteBuffers(1, &spriteBuffer);
+                glDeleteBuffers(1, &indexBuffer);
+                glDeleteBuffers(1, &lineBuffer);
+            }
+            spriteVao = lineVao = spriteBuffer = indexBuffer = lineBuffer = 0;
+            uploaded = false;
+        }
+    };
+
+    static_batch::static_batch() : pImpl(std::make_unique<impl>()) {}
+
+    static_batch::~static_batch() noexcept = default;
+
+    void static_batch::draw_texture(const std::shared_ptr<texture> &texture,
+                                    GLfloat x, GLfloat y, GLfloat width, GLfloat height) {
+        draw_texture(texture, x, y, width, height, 0, 0, 1, 1);
+    }
+
+    void static_batch::draw_texture(const std::shared_ptr<texture> &texture,
+                                    GLfloat x, GLfloat y, GLfloat width, GLfloat height,
+                                    GLfloat u1, GLfloat v1, GLfloat u2, GLfloat v2) {
+        pImpl->get_recorder(*this).draw_texture(texture, x, y, width, height, u1, v1, u2, v2);
+        ++pImpl->spriteCount;
+    }
+
+    void static_batch::draw_region(const texture_region &region,
+                                   GLfloat x, GLfloat y, GLfloat width, GLfloat height) {
+        pImpl->get_recorder(*this).draw_region(region, x, y, width, height);
+        ++pImpl->spriteCount;
+    }
+
+    void static_batch::draw_line(GLfloat x1, GLfloat y1, GLfloat x2, GLfloat y2) {
+        pImpl->draw_line(*this, x1, y1, x2, y2);
+    }
+
+    void static_batch::draw_rectangle(GLfloat x, GLfloat y, GLfloat w, GLfloat h) {
+        pImpl->draw_line(*this, x, y, x + w, y);
+        pImpl->draw_line(*this, x + w, y, x + w, y + h);
+        pImpl->draw_line(*this, x + w, y + h, x, y + h);
+        pImpl->draw_line(*this, x, y + h, x, y);
+    }
+
+    void static_batch::upload() { pImpl->upload(); }
+
+    bool static_batch::is_uploaded() const noexcept { return pImpl->uploaded; }
+
+    void static_batch::clear() noexcept {
+        pImpl->release();
+        pImpl->sprites.reset();
+        pImpl->lines.clear();
+        pImpl->segments.clear();
+        pImpl->lineBounds = {};
+        pImpl->spriteCount = pImpl->lineCount = 0;
+    }
+
+    std::size_t static_batch::get_sprite_count() const noexcept { return pImpl->spriteCount; }
+
+    std::size_t static_batch::get_line_count() const noexcept { return pImpl->lineCount; }
+
+    span<const static_batch_segment> static_batch::get_segments() const noexcept {
+        return {pImpl->segments.data(), pImpl->segments.size()};
+    }
+
+    GLuint static_batch::get_sprite_vertex_array() const noexcept { return pImpl->spriteVao; }
+
+    GLuint static_batch::get_line_vertex_array() const noexcept { return pImpl->lineVao; }
+
+    bounding_box static_batch::get_line_bounds() const noexcept { return pImpl->lineBounds; }
+}
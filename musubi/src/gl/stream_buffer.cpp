@@ -0,0 +1,198 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#include <musubi/gl/stream_buffer.h>
+
+#include <musubi/common.h>
+#include <musubi/exception.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+    /// Alignment of reservations within a region.
+    constexpr std::size_t RESERVE_ALIGNMENT = 16u;
+
+    /// Timeout of a single wait for a region fence, in nanoseconds.
+    constexpr GLuint64 FENCE_TIMEOUT = 1'000'000u;
+
+    bool has_buffer_storage() {
+        return epoxy_gl_version() >= 44 || epoxy_has_gl_extension("GL_ARB_buffer_storage");
+    }
+
+    constexpr std::size_t align_up(std::size_t value) noexcept {
+        return (value + RESERVE_ALIGNMENT - 1) & ~(RESERVE_ALIGNMENT - 1);
+    }
+}
+
+namespace musubi::gl {
+    using namespace musubi::detail;
+    using namespace std::string_literals;
+
+    struct stream_buffer::impl {
+        const GLenum target;
+        const bool persistent;
+
+        GLuint buffer{0};
+        std::byte *persistentPtr{nullptr};
+        std::size_t regionSize;
+        std::vector<GLsync> fences;
+
+        std::size_t region{0};
+        std::size_t offset{0};
+        // Reserved range, relative to the start of the buffer
+        std::size_t reservedOffset{0}, reservedSize{0};
+        bool reserved{false};
+
+        stream_buffer_stats stats{};
+
+        LIBMUSUBI_DELCP(impl)
+
+        impl(std::size_t regionSize, std::size_t regionCount, GLenum target)
+                : target(target), persistent(has_buffer_storage()),
+                  regionSize(align_up(regionSize)), fences(regionCount, nullptr) {
+            stats.regionCount = regionCount;
+            stats.persistent = persistent;
+            allocate();
+        }
+
+        ~impl() noexcept { release(); }
+
+        [[nodiscard]] std::size_t get_capacity() const noexcept { return regionSize * fences.size(); }
+
+        void allocate() {
+            glGenBuffers(1, &buffer);
+            glBindBuffer(target, buffer);
+            const auto capacity = static_cast<GLsizeiptr>(get_capacity());
+            if (persistent) {
+                constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+                glBufferStorage(target, capacity, nullptr, flags);
+                persistentPtr = static_cast<std::byte *>(glMapBufferRange(target, 0, capacity, flags));
+                if (!persistentPtr) throw illegal_state_error("Failed to persistently map stream buffer");
+            } else {
+                glBufferData(target, capacity, nullptr, GL_STREAM_DRAW);
+            }
+            region = 0;
+            offset = 0;
+            stats.regionSize = regionSize;
+
+            log_i("stream_buffer") << "Allocated " << fences.size() << " regions of " << regionSize << " bytes ("
+                                   << (persistent ? "persistently mapped" : "unsynchronized mapping") << ")\n";
+        }
+
+        void release() noexcept {
+            for (auto &fence : fences) {
+                if (fence) glDeleteSync(std::exchange(fence, nullptr));
+            }
+            if (persistentPtr) {
+                glBindBuffer(target, buffer);
+                glUnmapBuffer(target);
+                persistentPtr = nullptr;
+            }
+            // Deletion is deferred by OpenGL until pending draws have completed
+            if (buffer != 0) glDeleteBuffers(1, &buffer);
+            buffer = 0;
+        }
+
+        /// Fences the current region behind all issued commands, and moves on to the next region.
+        void advance() {
+            auto &current = fences[region];
+            if (current) glDeleteSync(current);
+            current = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+            region = (region + 1) % fences.size();
+            offset = 0;
+            ++stats.wraps;
+
+            auto &next = fences[region];
+            if (!next) return;
+
+            auto status = glClientWaitSync(next, 0, 0);
+            if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+                ++stats.stalls;
+                do {
+                    status = glClientWaitSync(next, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT);
+                } while (status == GL_TIMEOUT_EXPIRED);
+                if (status == GL_WAIT_FAILED) log_w("stream_buffer") << "Failed to wait for stream buffer region\n";
+            }
+            glDeleteSync(std::exchange(next, nullptr));
+        }
+
+        span<std::byte> reserve(std::size_t minSize) {
+            if (reserved) throw illegal_state_error("Cannot reserve stream buffer memory; memory is already reserved");
+
+            minSize = align_up(std::max<std::size_t>(minSize, 1));
+            if (minSize > regionSize) {
+                // Old regions may still be read by the GPU, so replace the buffer object rather than resizing it
+                release();
+                while (regionSize < minSize) regionSize *= 2;
+                ++stats.reallocations;
+                allocate();
+            } else if (regionSize - offset < minSize) {
+                advance();
+            }
+
+            reservedOffset = region * regionSize + offset;
+            reservedSize = regionSize - offset;
+
+            std::byte *ptr;
+            glBindBuffer(target, buffer);
+            if (persistent) {
+                ptr = persistentPtr + reservedOffset;
+            } else {
+                ptr = static_cast<std::byte *>(glMapBufferRange(
+                        target, static_cast<GLintptr>(reservedOffset), static_cast<GLsizeiptr>(reservedSize),
+                        GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT
+                        | GL_MAP_FLUSH_EXPLICIT_BIT
+                ));
+                if (!ptr) throw illegal_state_error("Failed to map stream buffer region");
+            }
+
+            reserved = true;
+            return {ptr, reservedSize};
+        }
+
+        std::size_t commit(std::size_t size) {
+            if (!reserved) throw illegal_state_error("Cannot commit stream buffer memory; no memory is reserved");
+            if (size > reservedSize) {
+                throw std::out_of_range("Cannot commit "s + std::to_string(size) + " bytes; only "
+                                        + std::to_string(reservedSize) + " bytes are reserved");
+            }
+
+            glBindBuffer(target, buffer);
+            if (!persistent) {
+                if (size > 0) glFlushMappedBufferRange(target, 0, static_cast<GLsizeiptr>(size));
+                if (glUnmapBuffer(target) == GL_FALSE) {
+                    log_w("stream_buffer") << "Stream buffer contents were corrupted while mapped\n";
+                }
+            }
+
+            reserved = false;
+            offset += align_up(size);
+            stats.committedBytes += size;
+            return reservedOffset;
+        }
+    };
+
+    stream_buffer::stream_buffer(std::size_t regionSize, std::size_t regionCount, GLenum target) {
+        if (regionSize == 0) throw std::invalid_argument("Cannot create stream buffer; region size is zero");
+        if (regionCount < 2) throw std::invalid_argument("Cannot create stream buffer; at least 2 regions are required");
+        pImpl = std::make_unique<impl>(regionSize, regionCount, target);
+    }
+
+    stream_buffer::~stream_buffer() noexcept = default;
+
+    span<std::byte> stream_buffer::reserve(std::size_t minSize) { return pImpl->reserve(minSize); }
+
+    std::size_t stream_buffer::commit(std::size_t size) { return pImpl->commit(size); }
+
+    bool stream_buffer::is_reserved() const noexcept { return pImpl->reserved; }
+
+    GLuint stream_buffer::get_buffer() const noexcept { return pImpl->buffer; }
+
+    stream_buffer_stats stream_buffer::get_stats() const noexcept { return pImpl->stats; }
+}
@@ -0,0 +1,103 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#include <musubi/gl/texture_memory.h>
+
+#include <algorithm>
+#include <atomic>
+
+namespace {
+    struct category_usage {
+        std::atomic<std::size_t> bytes{0};
+        std::atomic<std::size_t> textures{0};
+        std::atomic<std::size_t> budget{0};
+    };
+
+    category_usage usage[musubi::gl::TEXTURE_CATEGORY_COUNT]{};
+
+    std::size_t get_bytes_per_texel(GLenum internalFormat) noexcept {
+        switch (internalFormat) {
+            case GL_R8:
+                return 1;
+            case GL_RG8:
+            case GL_RGB565:
+            case GL_RGB5:
+            case GL_RGBA4:
+            case GL_RGB5_A1:
+            case GL_R16F:
+                return 2;
+            case GL_RGBA16F:
+            case GL_RGB16F:
+                return 8;
+            case GL_RGBA32F:
+            case GL_RGB32F:
+                return 16;
+            default:
+                // GL_RGBA8, and GL_RGB8 padded to four bytes
+                return 4;
+        }
+    }
+}
+
+namespace musubi::gl {
+    const char *get_texture_category_name(texture_category category) noexcept {
+        switch (category) {
+            case texture_category::general:
+                return "general";
+            case texture_category::world:
+                return "world";
+            case texture_category::interface:
+                return "interface";
+            case texture_category::glyphs:
+                return "glyphs";
+            case texture_category::dynamic:
+                return "dynamic";
+            default:
+                return "unknown";
+        }
+    }
+
+    std::size_t get_texture_memory_size(GLenum internalFormat, uint32 width, uint32 height, uint32 levels) noexcept {
+        const auto bytesPerTexel = get_bytes_per_texel(internalFormat);
+        std::size_t result = 0;
+        for (uint32 level = 0; level < levels; ++level) {
+            result += std::size_t{width} * height * bytesPerTexel;
+            width = std::max<uint32>(width / 2, 1);
+            height = std::max<uint32>(height / 2, 1);
+        }
+        return result;
+    }
+
+    texture_memory_stats get_texture_memory_stats() noexcept {
+        texture_memory_stats result{};
+        for (std::size_t i = 0; i < TEXTURE_CATEGORY_COUNT; ++i) {
+            result.categories[i] = get_texture_memory_usage(static_cast<texture_category>(i));
+            result.totalBytes += result.categories[i].bytes;
+            result.totalTextures += result.categories[i].textures;
+        }
+        return result;
+    }
+
+    texture_memory_usage get_texture_memory_usage(texture_category category) noexcept {
+        const auto &entry = usage[static_cast<std::size_t>(category)];
+        return {entry.bytes, entry.textures, entry.budget};
+    }
+
+    void set_texture_memory_budget(texture_category category, std::size_t bytes) noexcept {
+        usage[static_cast<std::size_t>(category)].budget = bytes;
+    }
+
+    namespace detail {
+        void track_texture_memory(texture_category category, std::size_t bytes, int count) noexcept {
+            auto &entry = usage[static_cast<std::size_t>(category)];
+            if (count >= 0) {
+                entry.bytes += bytes;
+                entry.textures += static_cast<std::size_t>(count);
+            } else {
+                entry.bytes -= bytes;
+                entry.textures -= static_cast<std::size_t>(-count);
+            }
+        }
+    }
+}
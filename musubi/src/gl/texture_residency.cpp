@@ -0,0 +1,154 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#include <musubi/gl/texture_residency.h>
+
+#include <musubi/common.h>
+#include <musubi/exception.h>
+
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace musubi::gl {
+    using namespace musubi::detail;
+    using namespace std::string_literals;
+
+    struct texture_residency::impl {
+        struct entry {
+            source_function source;
+            std::shared_ptr<gl::texture> texture;
+            bool flip;
+            GLenum internalFormat;
+            uint64 lastUsed{0};
+        };
+
+        uint32 idleFrames;
+        std::unordered_map<texture_id, entry> entries{};
+        texture_id nextId{1};
+        uint64 frame{1};
+        texture_residency_stats stats{};
+
+        LIBMUSUBI_DELCP(impl)
+
+        explicit impl(uint32 idleFrames) noexcept : idleFrames(idleFrames) {}
+
+        ~impl() noexcept = default;
+
+        [[nodiscard]] bool is_idle(const entry &entry) const noexcept {
+            return entry.texture->is_valid() && frame - entry.lastUsed >= idleFrames;
+        }
+
+        void evict_entry(entry &entry) noexcept {
+            entry.texture->unload();
+            ++stats.evictions;
+        }
+
+        /// Evicts idle textures in least recently used order, until `category` is within its budget
+        /// or, if `category` is empty, until no idle textures are left.
+        std::size_t evict(std::optional<texture_category> category) noexcept {
+            std::vector<entry *> candidates{};
+            for (auto &[id, entry] : entries) {
+                if (!is_idle(entry)) continue;
+                if (category && entry.texture->get_category() != *category) continue;
+                candidates.push_back(&entry);
+            }
+            std::sort(candidates.begin(), candidates.end(),
+                      [](const entry *a, const entry *b) { return a->lastUsed < b->lastUsed; });
+
+            std::size_t result = 0;
+            for (auto *entry : candidates) {
+                if (category && !get_texture_memory_usage(*category).over_budget()) break;
+                evict_entry(*entry);
+                ++result;
+            }
+            return result;
+        }
+    };
+
+    texture_residency::texture_residency(uint32 idleFrames) : pImpl(std::make_unique<impl>(idleFrames)) {}
+
+    texture_residency::~texture_residency() noexcept {
+        // Textures still referenced elsewhere outlive the manager, and stay loaded
+    }
+
+    texture_residency::texture_id texture_residency::add(source_function source, texture_category category,
+                                                         bool shouldFlip, GLenum internalFormat) {
+        if (!source) throw std::invalid_argument("Cannot add texture with an empty source");
+
+        auto texture = std::make_shared<gl::texture>();
+        texture->set_category(category);
+
+        const auto id = pImpl->nextId++;
+        pImpl->entries.emplace(id, impl::entry{std::move(source), std::move(texture), shouldFlip, internalFormat});
+        return id;
+    }
+
+    bool texture_residency::remove(texture_id id) {
+        const auto it = pImpl->entries.find(id);
+        if (it == pImpl->entries.end()) return false;
+
+        it->second.texture->unload();
+        pImpl->entries.erase(it);
+        return true;
+    }
+
+    std::shared_ptr<texture> texture_residency::acquire(texture_id id) {
+        const auto it = pImpl->entries.find(id);
+        if (it == pImpl->entries.end()) {
+            throw std::out_of_range("Texture "s + std::to_string(id) + " is not managed by this residency manager");
+        }
+
+        auto &entry = it->second;
+        if (!entry.texture->is_valid()) {
+            const auto source = entry.source();
+            if (!source) {
+                throw std::invalid_argument("Source of texture "s + std::to_string(id) + " returned null");
+            }
+
+            entry.texture->load(*source, entry.flip, entry.internalFormat);
+            if (entry.lastUsed != 0) ++pImpl->stats.reloads;
+            ++pImpl->stats.loads;
+        }
+        entry.lastUsed = pImpl->frame;
+        return entry.texture;
+    }
+
+    bool texture_residency::is_resident(texture_id id) const {
+        const auto it = pImpl->entries.find(id);
+        if (it == pImpl->entries.end()) {
+            throw std::out_of_range("Texture "s + std::to_string(id) + " is not managed by this residency manager");
+        }
+        return it->second.texture->is_valid();
+    }
+
+    void texture_residency::next_frame() noexcept {
+        ++pImpl->frame;
+        for (std::size_t i = 0; i < TEXTURE_CATEGORY_COUNT; ++i) {
+            const auto category = static_cast<texture_category>(i);
+            if (get_texture_memory_usage(category).over_budget()) pImpl->evict(category);
+        }
+    }
+
+    std::size_t texture_residency::evict_idle() noexcept { return pImpl->evict(std::nullopt); }
+
+    uint32 texture_residency::get_idle_frames() const noexcept { return pImpl->idleFrames; }
+
+    void texture_residency::set_idle_frames(uint32 idleFrames) noexcept { pImpl->idleFrames = idleFrames; }
+
+    texture_residency_stats texture_residency::get_stats() const {
+        auto result = pImpl->stats;
+        result.textures = pImpl->entries.size();
+        for (const auto &[id, entry] : pImpl->entries) {
+            if (!entry.texture->is_valid()) continue;
+            ++result.resident;
+            result.residentBytes += entry.texture->get_memory_size();
+        }
+        return result;
+    }
+}
@@ -0,0 +1,385 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#include <musubi/gl/texture_streamer.h>
+
+#include <musubi/common.h>
+#include <musubi/exception.h>
+
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+    /// Offset alignment of uploads within a staging segment.
+    constexpr std::size_t UPLOAD_ALIGNMENT = 64u;
+
+    bool has_buffer_storage() {
+        return epoxy_gl_version() >= 44 || epoxy_has_gl_extension("GL_ARB_buffer_storage");
+    }
+}
+
+namespace musubi::gl {
+    using namespace musubi::detail;
+
+    struct texture_streamer::impl {
+        enum class segment_state {
+            /// Orphaned and unmapped; must be mapped by process() before it can be used.
+            unmapped,
+            /// Mapped and empty.
+            available,
+            /// Currently handing out staging memory.
+            open,
+            /// Full; its uploads are issued once all of its staging buffers have been committed.
+            closed,
+            /// Unmapped; its uploads are being issued over one or more frames.
+            issuing,
+            /// All uploads issued; waiting for the fence.
+            in_flight
+        };
+
+        struct upload {
+            std::weak_ptr<texture> target;
+            pixmap_rect region;
+            pixmap_format format;
+            std::size_t offset, size;
+            std::promise<void> promise;
+        };
+
+        struct segment {
+            GLuint buffer{0};
+            byte *ptr{nullptr};
+            segment_state state{segment_state::unmapped};
+            std::size_t used{0};
+            std::size_t writers{0};
+            std::deque<upload> uploads{};
+            std::vector<std::promise<void>> issued{};
+            GLsync fence{nullptr};
+        };
+
+        const std::size_t segmentSize;
+        const bool persistent;
+
+        mutable std::mutex mutex{};
+        std::vector<segment> segments;
+        std::size_t current{0}, issueIndex{0};
+        std::size_t frameBudget;
+        texture_streamer_stats stats{};
+
+        LIBMUSUBI_DELCP(impl)
+
+        impl(std::size_t segmentSize, std::size_t segmentCount, std::size_t frameBudget)
+                : segmentSize(segmentSize), persistent(has_buffer_storage()),
+                  segments(segmentCount), frameBudget(frameBudget) {
+            stats.persistent = persistent;
+
+            for (auto &segment : segments) {
+                glGenBuffers(1, &segment.buffer);
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, segment.buffer);
+                if (persistent) {
+                    constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+                    glBufferStorage(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(segmentSize), nullptr, flags);
+                    segment.ptr = static_cast<byte *>(glMapBufferRange(
+                            GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(segmentSize), flags
+                    ));
+                    if (!segment.ptr) throw illegal_state_error("Failed to persistently map texture staging buffer");
+                    segment.state = segment_state::available;
+                } else {
+                    map(segment);
+                }
+            }
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+            log_i("texture_streamer") << "Allocated " << segmentCount << " staging segments of "
+                                      << segmentSize << " bytes ("
+                                      << (persistent ? "persistently mapped" : "orphaned") << ")\n";
+        }
+
+        ~impl() noexcept {
+            for (auto &segment : segments) {
+                if (segment.fence) glDeleteSync(segment.fence);
+                if (segment.ptr) {
+                    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, segment.buffer);
+                    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+                }
+                glDeleteBuffers(1, &segment.buffer);
+            }
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        }
+
+        /// Orphans and maps a segment, leaving its buffer bound.
+        void map(segment &segment) {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, segment.buffer);
+            glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(segmentSize), nullptr, GL_STREAM_DRAW);
+            segment.ptr = static_cast<byte *>(glMapBufferRange(
+                    GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(segmentSize),
+                    GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT
+            ));
+            if (segment.ptr) {
+                segment.state = segment_state::available;
+            } else {
+                log_e("texture_streamer") << "Failed to map texture staging buffer " << segment.buffer << '\n';
+            }
+        }
+
+        std::optional<staging_buffer> try_acquire(const std::weak_ptr<texture> &target, const pixmap_rect &region) {
+            const auto texture = target.lock();
+            if (!texture || !texture->is_valid()) {
+                throw std::invalid_argument("Cannot stage texture upload; target texture is not valid");
+            }
+            if (region.empty()) throw std::invalid_argument("Cannot stage texture upload; region is empty");
+            if (region.x > texture->get_width() || region.width > texture->get_width() - region.x
+                || region.y > texture->get_height() || region.height > texture->get_height() - region.y) {
+                throw std::out_of_range("Cannot stage texture upload; region exceeds texture bounds");
+            }
+            const auto format = texture->get_format();
+            const auto size = std::size_t{region.width} * region.height * get_bytes_per_pixel(format);
+            if (size > segmentSize) {
+                throw std::invalid_argument("Cannot stage texture upload; upload size "s + std::to_string(size)
+                                            + " exceeds segment size "s + std::to_string(segmentSize));
+            }
+
+            std::lock_guard lock(mutex);
+            for (int attempt = 0; attempt < 2; ++attempt) {
+                auto &segment = segments[current];
+                if (segment.state == segment_state::available) {
+                    segment.state = segment_state::open;
+                    segment.used = 0;
+                }
+                if (segment.state != segment_state::open) break;
+
+                const auto offset = align_up(segment.used, UPLOAD_ALIGNMENT);
+                if (offset + size <= segmentSize) {
+                    segment.used = offset + size;
+                    ++segment.writers;
+                    return staging_buffer(this, current, offset, segment.ptr + offset, target, region, format);
+                }
+
+                // The current segment is full; continue with the next one
+                segment.state = segment_state::closed;
+                current = (current + 1) % segments.size();
+            }
+
+            ++stats.stalls;
+            return std::nullopt;
+        }
+
+        std::future<void> commit(staging_buffer &buffer) {
+            std::lock_guard lock(mutex);
+            auto &segment = segments[buffer.segment];
+            auto &upload = segment.uploads.emplace_back(impl::upload{
+                    std::move(buffer.target), buffer.region, buffer.format, buffer.offset, buffer.size(), {}
+            });
+            --segment.writers;
+            buffer.owner = nullptr;
+            return upload.promise.get_future();
+        }
+
+        void cancel(const staging_buffer &buffer) noexcept {
+            std::lock_guard lock(mutex);
+            --segments[buffer.segment].writers;
+        }
+
+        void retire() {
+            for (auto &segment : segments) {
+                if (segment.state != segment_state::in_flight) continue;
+
+                const auto status = glClientWaitSync(segment.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+                if (status == GL_TIMEOUT_EXPIRED) continue;
+                if (status == GL_WAIT_FAILED) {
+                    log_e("texture_streamer") << "Failed to wait for upload fence; assuming completion\n";
+                }
+
+                glDeleteSync(segment.fence);
+                segment.fence = nullptr;
+                for (auto &promise : segment.issued) promise.set_value();
+                stats.completedUploads += segment.issued.size();
+                segment.issued.clear();
+                segment.used = 0;
+                segment.state = persistent ? segment_state::available : segment_state::unmapped;
+            }
+
+            if (!persistent) {
+                for (auto &segment : segments) {
+                    if (segment.state == segment_state::unmapped) map(segment);
+                }
+            }
+        }
+
+        void issue() {
+            // Hand out the next segment from now on, so that partially-filled segments are uploaded promptly
+            auto &open = segments[current];
+            if (open.state == segment_state::open && open.used > 0) {
+                open.state = segment_state::closed;
+                current = (current + 1) % segments.size();
+            }
+
+            std::size_t issuedBytes = 0;
+            bool issuedAny = false;
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+            // Segments are issued in ring order, so that uploads are applied in commit order
+            while (true) {
+                auto &segment = segments[issueIndex];
+                if (segment.state == segment_state::closed && segment.writers == 0) {
+                    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, segment.buffer);
+                    if (!persistent) {
+                        if (glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_FALSE) {
+                            log_w("texture_streamer") << "Staging buffer contents were lost; uploads may be corrupt\n";
+                        }
+                        segment.ptr = nullptr;
+                    }
+                    segment.state = segment_state::issuing;
+                }
+                if (segment.state != segment_state::issuing) break;
+
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, segment.buffer);
+                while (!segment.uploads.empty()) {
+                    auto &upload = segment.uploads.front();
+                    if (issuedAny && issuedBytes + upload.size > frameBudget) break;
+
+                    const auto texture = upload.target.lock();
+                    if (texture && texture->is_valid() && texture->get_format() == upload.format) {
+                        glBindTexture(GL_TEXTURE_2D, texture->get_name());
+                        glTexSubImage2D(GL_TEXTURE_2D, 0,
+                                        static_cast<GLint>(upload.region.x), static_cast<GLint>(upload.region.y),
+                                        static_cast<GLsizei>(upload.region.width),
+                                        static_cast<GLsizei>(upload.region.height),
+                                        get_pixel_format(upload.format), get_pixel_type(upload.format),
+                                        reinterpret_cast<const void *>(upload.offset));
+                        issuedBytes += upload.size;
+                        issuedAny = true;
+                        ++stats.uploads;
+                        stats.uploadedBytes += upload.size;
+                        segment.issued.push_back(std::move(upload.promise));
+                    } else {
+                        upload.promise.set_exception(std::make_exception_ptr(illegal_state_error(
+                                "Cannot upload texture; target texture was destroyed or reloaded"
+                        )));
+                    }
+                    segment.uploads.pop_front();
+                }
+                if (!segment.uploads.empty()) break;
+
+                segment.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+                segment.state = segment_state::in_flight;
+                issueIndex = (issueIndex + 1) % segments.size();
+            }
+
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            stats.lastFrameBytes = issuedBytes;
+        }
+    };
+
+    texture_streamer::staging_buffer::staging_buffer(impl *owner, std::size_t segment, std::size_t offset, byte *ptr,
+                                                     std::weak_ptr<texture> target, const pixmap_rect &region,
+                                                     pixmap_format format) noexcept
+            : owner(owner), segment(segment), offset(offset), ptr(ptr),
+              target(std::move(target)), region(region), format(format) {}
+
+    texture_streamer::staging_buffer::staging_buffer(staging_buffer &&other) noexcept
+            : owner(std::exchange(other.owner, nullptr)), segment(other.segment), offset(other.offset),
+              ptr(std::exchange(other.ptr, nullptr)), target(std::move(other.target)),
+              region(other.region), format(other.format) {}
+
+    texture_streamer::staging_buffer &texture_streamer::staging_buffer::operator=(staging_buffer &&other) noexcept {
+        if (this == &other) return *this;
+        if (owner) owner->cancel(*this);
+        owner = std::exchange(other.owner, nullptr);
+        segment = other.segment;
+        offset = other.offset;
+        ptr = std::exchange(other.ptr, nullptr);
+        target = std::move(other.target);
+        region = other.region;
+        format = other.format;
+        return *this;
+    }
+
+    texture_streamer::staging_buffer::~staging_buffer() noexcept {
+        if (owner) owner->cancel(*this);
+    }
+
+    void texture_streamer::staging_buffer::copy_from(const pixmap &source) {
+        if (source.get_format() != format) {
+            throw std::invalid_argument("Cannot copy pixmap to staging buffer; formats differ");
+        }
+        if (source.get_width() != region.width || source.get_height() != region.height) {
+            throw std::invalid_argument("Cannot copy pixmap to staging buffer; sizes differ");
+        }
+
+        const auto rowSize = get_stride();
+        if (!source.data()) {
+            std::memset(ptr, 0, size());
+        } else if (source.get_stride() == rowSize) {
+            std::memcpy(ptr, source.data(), size());
+        } else {
+            for (uint32 y = 0; y < region.height; ++y) {
+                std::memcpy(row_data(y), source.data() + y * source.get_stride(), rowSize);
+            }
+        }
+    }
+
+    texture_streamer::texture_streamer(std::size_t segmentSize, std::size_t segmentCount, std::size_t frameBudget) {
+        if (segmentSize == 0) throw std::invalid_argument("Cannot create texture streamer; segment size is zero");
+        if (segmentCount < 2) {
+            throw std::invalid_argument("Cannot create texture streamer; at least 2 segments are required");
+        }
+        pImpl = std::make_unique<impl>(segmentSize, segmentCount, frameBudget);
+    }
+
+    texture_streamer::~texture_streamer() noexcept = default;
+
+    std::optional<texture_streamer::staging_buffer>
+    texture_streamer::try_acquire(const std::weak_ptr<texture> &target, const pixmap_rect &region) {
+        return pImpl->try_acquire(target, region);
+    }
+
+    std::future<void> texture_streamer::commit(staging_buffer &&buffer) {
+        if (!buffer || buffer.owner != pImpl.get()) {
+            throw std::invalid_argument("Cannot commit staging buffer; it is empty or belongs to another streamer");
+        }
+        return pImpl->commit(buffer);
+    }
+
+    std::optional<std::future<void>> texture_streamer::try_stream(const std::weak_ptr<texture> &target,
+                                                                  const pixmap &source, uint32 x, uint32 y) {
+        auto buffer = try_acquire(target, {x, y, source.get_width(), source.get_height()});
+        if (!buffer) return std::nullopt;
+        buffer->copy_from(source);
+        return commit(std::move(*buffer));
+    }
+
+    void texture_streamer::process() {
+        std::lock_guard lock(pImpl->mutex);
+        pImpl->retire();
+        pImpl->issue();
+    }
+
+    std::size_t texture_streamer::get_frame_budget() const {
+        std::lock_guard lock(pImpl->mutex);
+        return pImpl->frameBudget;
+    }
+
+    void texture_streamer::set_frame_budget(std::size_t frameBudget) {
+        std::lock_guard lock(pImpl->mutex);
+        pImpl->frameBudget = frameBudget;
+    }
+
+    std::size_t texture_streamer::get_segment_size() const noexcept { return pImpl->segmentSize; }
+
+    texture_streamer_stats texture_streamer::get_stats() const {
+        std::lock_guard lock(pImpl->mutex);
+        auto result = pImpl->stats;
+        for (const auto &segment : pImpl->segments) {
+            result.pendingUploads += segment.uploads.size();
+            for (const auto &upload : segment.uploads) result.pendingBytes += upload.size;
+        }
+        return result;
+    }
+}
@@ -7,9 +7,19 @@
 #include <musubi/common.h>
 #include <musubi/gl/common.h>
 #include <musubi/gl/shaders.h>
+#include <musubi/gl/sprite_recorder.h>
+#include <musubi/gl/static_batch.h>
+#include <musubi/gl/stream_buffer.h>
 
+#include "simd/vertex_kernels.h"
+
+#include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -17,25 +27,169 @@
 namespace {
     using namespace std::literals;
 
-    constexpr GLenum getGlFormat(musubi::pixmap_format format) {
+    static_assert(sizeof(musubi::gl::sprite) == sizeof(musubi::detail::quad_source)
+                  && offsetof(musubi::gl::sprite, u1) == offsetof(musubi::detail::quad_source, u1)
+                  && offsetof(musubi::gl::sprite, tint) == offsetof(musubi::detail::quad_source, tint),
+                  "sprite must match the layout of the vertex kernels' quad_source");
+    static_assert(sizeof(musubi::gl::detail::sprite_vertex) == sizeof(musubi::detail::quad_vertex)
+                  && offsetof(musubi::gl::detail::sprite_vertex, tint) == offsetof(musubi::detail::quad_vertex, tint)
+                  && offsetof(musubi::gl::detail::sprite_vertex, slot) == offsetof(musubi::detail::quad_vertex, slot),
+                  "sprite_vertex must match the layout of the vertex kernels' quad_vertex");
+
+    /// Sets up format-specific sampling state of the currently-bound texture.
+    void set_format_parameters(musubi::pixmap_format format) {
+        if (format == musubi::pixmap_format::la8) {
+            // Luminance-alpha is stored as RG; expand it to (L, L, L, A) when sampling
+            const GLint swizzle[]{GL_RED, GL_RED, GL_RED, GL_GREEN};
+            glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+        }
+    }
+
+    /// Sets up the unpack state so that the rows of the specified pixmap can be read directly from its data.
+    /// Returns false if the pixmap's stride cannot be described by GL_UNPACK_ROW_LENGTH and GL_UNPACK_ALIGNMENT.
+    bool set_unpack_layout(const musubi::pixmap &source) {
+        const auto bytesPerPixel = musubi::get_bytes_per_pixel(source.get_format());
+        const auto stride = source.get_stride();
+        const auto rowLength = stride / bytesPerPixel;
+
+        for (const GLint alignment : {1, 2, 4, 8}) {
+            const auto alignedRowSize = (rowLength * bytesPerPixel + alignment - 1) / alignment * alignment;
+            if (alignedRowSize == stride) {
+                glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+                glPixelStorei(GL_UNPACK_ROW_LENGTH, rowLength == source.get_width() ? 0 : static_cast<GLint>(rowLength));
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void reset_unpack_layout() {
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    }
+
+    /// Uploads the pixels of a pixmap to the specified level of the currently-bound texture, allocating its storage.
+    void upload_pixmap(const musubi::pixmap &source, GLint level, GLenum internalFormat) {
+        const auto format = musubi::gl::get_pixel_format(source.get_format());
+        const auto type = musubi::gl::get_pixel_type(source.get_format());
+        const auto width = static_cast<GLsizei>(source.get_width());
+        const auto height = static_cast<GLsizei>(source.get_height());
+
+        if (!source.data() || set_unpack_layout(source)) {
+            glTexImage2D(GL_TEXTURE_2D, level, internalFormat, width, height, 0, format, type, source.data());
+        } else {
+            // Stride is not expressible through the unpack state; upload row by row instead
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            glTexImage2D(GL_TEXTURE_2D, level, internalFormat, width, height, 0, format, type, nullptr);
+            for (GLsizei y = 0; y < height; ++y) {
+                glTexSubImage2D(GL_TEXTURE_2D, level, 0, y, width, 1, format, type,
+                                source.data() + y * source.get_stride());
+            }
+        }
+        reset_unpack_layout();
+    }
+
+    /// Uploads the pixels of a pixmap to a position in the specified level of the currently-bound texture.
+    void upload_sub_pixmap(const musubi::pixmap &source, GLint level, GLint x, GLint y) {
+        const auto format = musubi::gl::get_pixel_format(source.get_format());
+        const auto type = musubi::gl::get_pixel_type(source.get_format());
+        const auto width = static_cast<GLsizei>(source.get_width());
+        const auto height = static_cast<GLsizei>(source.get_height());
+
+        if (!source.data()) {
+            // Unallocated pixmaps are conceptually zero-filled
+            const std::vector<musubi::byte> zeroes(source.get_width() * source.get_height()
+                                                   * musubi::get_bytes_per_pixel(source.get_format()));
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            glTexSubImage2D(GL_TEXTURE_2D, level, x, y, width, height, format, type, zeroes.data());
+        } else if (set_unpack_layout(source)) {
+            glTexSubImage2D(GL_TEXTURE_2D, level, x, y, width, height, format, type, source.data());
+        } else {
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            for (GLsizei row = 0; row < height; ++row) {
+                glTexSubImage2D(GL_TEXTURE_2D, level, x, y + row, width, 1, format, type,
+                                source.data() + row * source.get_stride());
+            }
+        }
+        reset_unpack_layout();
+    }
+
+    /// A decoded base level along with its mip chain.
+    struct mipmapped_pixmap {
+        std::unique_ptr<musubi::pixmap> base;
+        std::vector<std::unique_ptr<musubi::pixmap>> mips{};
+    };
+
+    template<musubi::pixmap_format Format>
+    void append_mip_chain(mipmapped_pixmap &target, musubi::downscale_filter filter, musubi::thread_pool *pool) {
+        for (auto &level : musubi::build_mip_chain<Format>(*target.base, filter, pool)) {
+            target.mips.push_back(std::make_unique<musubi::buffer_pixmap<Format>>(std::move(level)));
+        }
+    }
+}
+
+namespace musubi::gl {
+    using namespace musubi::detail;
+
+    GLenum get_pixel_format(pixmap_format format) {
         switch (format) {
-            case musubi::pixmap_format::r8:
+            case pixmap_format::r8:
                 return GL_RED;
-            case musubi::pixmap_format::rgb8:
+            case pixmap_format::rgb8:
+            case pixmap_format::rgb565:
                 return GL_RGB;
-            case musubi::pixmap_format::rgba8:
+            case pixmap_format::rgba8:
+            case pixmap_format::rgba4444:
+            case pixmap_format::rgba5551:
                 return GL_RGBA;
+            case pixmap_format::la8:
+                return GL_RG;
             default:
-                throw musubi::assertion_error(
+                throw assertion_error(
                         "Cannot construct image format GLenum from unknown pixmap_format "s +
-                        std::to_string(static_cast<std::underlying_type_t<musubi::pixmap_format>>(format))
+                        std::to_string(static_cast<std::underlying_type_t<pixmap_format>>(format))
                 );
         }
     }
-}
 
-namespace musubi::gl {
-    using namespace musubi::detail;
+    GLenum get_pixel_type(pixmap_format format) noexcept {
+        switch (format) {
+            case pixmap_format::rgb565:
+                return GL_UNSIGNED_SHORT_5_6_5;
+            case pixmap_format::rgba4444:
+                return GL_UNSIGNED_SHORT_4_4_4_4;
+            case pixmap_format::rgba5551:
+                return GL_UNSIGNED_SHORT_5_5_5_1;
+            default:
+                return GL_UNSIGNED_BYTE;
+        }
+    }
+
+    GLenum get_internal_format(pixmap_format format) {
+        switch (format) {
+            case pixmap_format::r8:
+                return GL_R8;
+            case pixmap_format::rgb8:
+                return GL_RGB8;
+            case pixmap_format::rgba8:
+                return GL_RGBA8;
+            case pixmap_format::rgb565:
+                // GL_RGB565 is only a valid internal format since OpenGL 4.1 (or with ARB_ES2_compatibility)
+                return epoxy_gl_version() >= 41 || epoxy_has_gl_extension("GL_ARB_ES2_compatibility")
+                       ? GL_RGB565 : GL_RGB5;
+            case pixmap_format::rgba4444:
+                return GL_RGBA4;
+            case pixmap_format::rgba5551:
+                return GL_RGB5_A1;
+            case pixmap_format::la8:
+                return GL_RG8;
+            default:
+                throw assertion_error(
+                        "Cannot determine internal format of unknown pixmap_format "s +
+                        std::to_string(static_cast<std::underlying_type_t<pixmap_format>>(format))
+                );
+        }
+    }
 
     texture::texture() noexcept = default;
 
@@ -44,47 +198,175 @@ namespace musubi::gl {
     }
 
     texture::texture(texture &&other) noexcept
-            : handle(std::exchange(other.handle, 0)) {}
+            : handle(std::exchange(other.handle, 0)), flip(std::exchange(other.flip, false)),
+              width(std::exchange(other.width, 0)), height(std::exchange(other.height, 0)), format(other.format),
+              category(other.category), memorySize(std::exchange(other.memorySize, 0)) {}
 
     texture &texture::operator=(texture &&other) noexcept {
+        if (this == &other) return *this;
+        release();
         handle = std::exchange(other.handle, 0);
+        flip = std::exchange(other.flip, false);
+        width = std::exchange(other.width, 0);
+        height = std::exchange(other.height, 0);
+        format = other.format;
+        category = other.category;
+        memorySize = std::exchange(other.memorySize, 0);
         return *this;
     }
 
-    texture::~texture() noexcept {
+    texture::~texture() noexcept { release(); }
+
+    void texture::release() noexcept {
         if (is_valid()) {
             glDeleteTextures(1, &handle);
+            detail::track_texture_memory(category, memorySize, -1);
             log_i("texture") << "Deleted texture " << handle << '\n';
         }
         flip = false;
         handle = 0;
+        width = height = 0;
+        memorySize = 0;
+    }
+
+    void texture::track_memory(GLenum internalFormat, uint32 levels) noexcept {
+        memorySize = get_texture_memory_size(internalFormat, width, height, levels);
+        detail::track_texture_memory(category, memorySize, 1);
+    }
+
+    void texture::unload() noexcept { release(); }
+
+    texture_category texture::get_category() const noexcept { return category; }
+
+    void texture::set_category(texture_category category) noexcept {
+        if (is_valid()) {
+            detail::track_texture_memory(this->category, memorySize, -1);
+            detail::track_texture_memory(category, memorySize, 1);
+        }
+        this->category = category;
     }
 
+    std::size_t texture::get_memory_size() const noexcept { return memorySize; }
+
     bool texture::should_flip() const noexcept { return is_valid() && flip; }
 
     GLuint texture::load(const pixmap &source, bool shouldFlip, GLenum internalFormat) {
-        if (handle != 0) this->~texture();
+        release();
         flip = shouldFlip;
 
         glGenTextures(1, &handle);
         glBindTexture(GL_TEXTURE_2D, handle);
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 
-        glTexImage2D(
-                GL_TEXTURE_2D, 0, internalFormat, source.get_width(), source.get_height(), 0,
-                getGlFormat(source.get_format()),
-                GL_UNSIGNED_BYTE,
-                source.data()
-        );
-//        glGenerateMipmap(GL_TEXTURE_2D);
+        set_format_parameters(source.get_format());
+        upload_pixmap(source, 0, internalFormat);
+        width = source.get_width();
+        height = source.get_height();
+        format = source.get_format();
+        track_memory(internalFormat, 1);
+
+        return handle;
+    }
+
+    GLuint texture::load(const pixmap &base, span<const pixmap_view> mips, bool shouldFlip, GLenum internalFormat) {
+        for (std::size_t i = 0; i < mips.size(); ++i) {
+            const auto &previous = i == 0 ? pixmap_view(base) : mips[i - 1];
+            if (mips[i].get_format() != base.get_format()) {
+                throw std::invalid_argument("Cannot load mip level "s + std::to_string(i + 1)
+                                            + "; its format differs from the base level's");
+            }
+            if (mips[i].get_width() != std::max<uint32>(previous.get_width() / 2, 1)
+                || mips[i].get_height() != std::max<uint32>(previous.get_height() / 2, 1)) {
+                throw std::invalid_argument("Cannot load mip level "s + std::to_string(i + 1)
+                                            + "; it is not half the size of the previous level");
+            }
+        }
+
+        release();
+        flip = shouldFlip;
+
+        glGenTextures(1, &handle);
+        glBindTexture(GL_TEXTURE_2D, handle);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, mips.empty() ? GL_LINEAR : GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(mips.size()));
+
+        set_format_parameters(base.get_format());
+        upload_pixmap(base, 0, internalFormat);
+        for (std::size_t i = 0; i < mips.size(); ++i) {
+            upload_pixmap(mips[i], static_cast<GLint>(i + 1), internalFormat);
+        }
+        width = base.get_width();
+        height = base.get_height();
+        format = base.get_format();
+        track_memory(internalFormat, static_cast<uint32>(mips.size() + 1));
 
         return handle;
     }
 
+    GLuint texture::allocate(uint32 width, uint32 height, pixmap_format format,
+                             bool shouldFlip, GLenum internalFormat) {
+        release();
+        flip = shouldFlip;
+
+        glGenTextures(1, &handle);
+        glBindTexture(GL_TEXTURE_2D, handle);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+        set_format_parameters(format);
+        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, static_cast<GLsizei>(width), static_cast<GLsizei>(height), 0,
+                     get_pixel_format(format), get_pixel_type(format), nullptr);
+        this->width = width;
+        this->height = height;
+        this->format = format;
+        track_memory(internalFormat, 1);
+
+        return handle;
+    }
+
+    void texture::update(const pixmap &source, const pixmap_rect &region) {
+        if (!is_valid()) throw illegal_state_error("Cannot update texture; texture is not valid");
+        if (source.get_width() != width || source.get_height() != height) {
+            throw std::invalid_argument("Cannot update texture; source size "s
+                                        + std::to_string(source.get_width()) + "x"s
+                                        + std::to_string(source.get_height())
+                                        + " differs from texture size "s
+                                        + std::to_string(width) + "x"s + std::to_string(height));
+        }
+        if (region.empty()) return;
+        upload(pixmap_view(source, region), region.x, region.y);
+    }
+
+    void texture::upload(const pixmap &source, uint32 x, uint32 y) {
+        if (!is_valid()) throw illegal_state_error("Cannot upload to texture; texture is not valid");
+        if (source.get_format() != format) {
+            throw std::invalid_argument("Cannot upload to texture; source format differs from texture format");
+        }
+        if (x > width || source.get_width() > width - x || y > height || source.get_height() > height - y) {
+            throw std::out_of_range("Cannot upload to texture; source does not fit at ("s
+                                    + std::to_string(x) + ", "s + std::to_string(y) + ")"s);
+        }
+        if (source.get_width() == 0 || source.get_height() == 0) return;
+
+        glBindTexture(GL_TEXTURE_2D, handle);
+        upload_sub_pixmap(source, 0, static_cast<GLint>(x), static_cast<GLint>(y));
+    }
+
+    uint32 texture::get_width() const noexcept { return width; }
+
+    uint32 texture::get_height() const noexcept { return height; }
+
+    pixmap_format texture::get_format() const noexcept { return format; }
+
     bool texture::is_valid() const noexcept { return handle != 0; }
 
     texture::operator bool() const noexcept(noexcept(is_valid())) { return is_valid(); }
@@ -93,6 +375,65 @@ namespace musubi::gl {
 
     texture::operator GLuint() const noexcept(noexcept(get_name())) { return get_name(); }
 
+    std::future<std::shared_ptr<texture>> load_texture_async(load_pipeline &pipeline,
+                                                             std::function<std::unique_ptr<pixmap>()> decode,
+                                                             bool shouldFlip, GLenum internalFormat) {
+        return pipeline.submit(std::move(decode), [shouldFlip, internalFormat](std::unique_ptr<pixmap> &&source) {
+            if (!source) throw std::invalid_argument("Cannot load texture; decoded pixmap pointer is empty");
+            return std::make_shared<texture>(*source, shouldFlip, internalFormat);
+        });
+    }
+
+    std::future<std::shared_ptr<texture>> load_texture_async(load_pipeline &pipeline,
+                                                             std::function<std::unique_ptr<pixmap>()> decode,
+                                                             downscale_filter filter,
+                                                             bool shouldFlip, GLenum internalFormat) {
+        auto &workers = pipeline.get_workers();
+        auto decodeChain = [decode = std::move(decode), filter, &workers]() {
+            mipmapped_pixmap result{decode()};
+            if (!result.base) return result;
+
+            switch (result.base->get_format()) {
+                case pixmap_format::r8:
+                    append_mip_chain<pixmap_format::r8>(result, filter, &workers);
+                    break;
+                case pixmap_format::rgb8:
+                    append_mip_chain<pixmap_format::rgb8>(result, filter, &workers);
+                    break;
+                case pixmap_format::rgba8:
+                    append_mip_chain<pixmap_format::rgba8>(result, filter, &workers);
+                    break;
+                case pixmap_format::rgb565:
+                    append_mip_chain<pixmap_format::rgb565>(result, filter, &workers);
+                    break;
+                case pixmap_format::rgba4444:
+                    append_mip_chain<pixmap_format::rgba4444>(result, filter, &workers);
+                    break;
+                case pixmap_format::rgba5551:
+                    append_mip_chain<pixmap_format::rgba5551>(result, filter, &workers);
+                    break;
+                case pixmap_format::la8:
+                    append_mip_chain<pixmap_format::la8>(result, filter, &workers);
+                    break;
+                default:
+                    throw assertion_error("Cannot build mip chain of unknown pixmap_format "s + std::to_string(
+                            static_cast<std::underlying_type_t<pixmap_format>>(result.base->get_format())
+                    ));
+            }
+            return result;
+        };
+
+        return pipeline.submit(std::move(decodeChain), [shouldFlip, internalFormat](mipmapped_pixmap &&source) {
+            if (!source.base) throw std::invalid_argument("Cannot load texture; decoded pixmap pointer is empty");
+            std::vector<pixmap_view> mips;
+            mips.reserve(source.mips.size());
+            for (const auto &level : source.mips) mips.emplace_back(*level);
+            auto result = std::make_shared<texture>();
+            result->load(*source.base, mips, shouldFlip, internalFormat);
+            return result;
+        });
+    }
+
     texture_region::texture_region(std::weak_ptr<::musubi::gl::texture> texture,
                                    GLfloat u1, GLfloat v1, GLfloat u2, GLfloat v2) noexcept
             : texture(std::move(texture)), u1(u1), v1(v1), u2(u2), v2(v2) {}
@@ -101,26 +442,111 @@ namespace musubi::gl {
             : texture(std::move(texture)), u1(0), v1(0), u2(1), v2(1) {}
 
     struct gl_texture_renderer::impl {
-        shader_program shader{};
-        // Cached locations
-        GLint modelMatrixUniform{-1}, viewMatrixUniform{-1}, projectionMatrixUniform{-1};
-        GLint textureUniform{-1};
+        /// The vertex layout of sprite quads.
+        using vertex = detail::sprite_vertex;
+
+        /// The per-instance layout of instanced sprites.
+        struct instance {
+            sprite_instance sprite;
+            GLuint slot;
+        };
+
+        /// The kind of the pending draw; switching modes flushes the pending draw.
+        enum class batch_mode {
+            quads,
+            instances
+        };
+
+        /// A sprite shader program and its cached uniform locations.
+        struct program {
+            shader_program shader{};
+            // Cached locations
+            GLint modelMatrixUniform{-1}, viewMatrixUniform{-1}, projectionMatrixUniform{-1};
+
+            void link(const std::string &vertexSource, const std::string &fragmentSource, uint32 maxSlots) {
+                shader.link(vertexSource, fragmentSource);
+
+                modelMatrixUniform = glGetUniformLocation(shader, "mM");
+                viewMatrixUniform = glGetUniformLocation(shader, "mV");
+                projectionMatrixUniform = glGetUniformLocation(shader, "mP");
+
+                // Sampler i always reads from texture unit i
+                std::vector<GLint> units(maxSlots);
+                for (uint32 slot = 0; slot < maxSlots; ++slot) units[slot] = static_cast<GLint>(slot);
+                glUseProgram(shader);
+                glUniform1iv(glGetUniformLocation(shader, "u_textures"), static_cast<GLsizei>(maxSlots), units.data());
+                glUseProgram(0);
+            }
+
+            /// Binds the program and sets its matrices from a renderer.
+            void use(const gl_texture_renderer &parent) const {
+                glUseProgram(shader);
+                glUniformMatrix4fv(modelMatrixUniform, 1, GL_FALSE, glm::value_ptr(parent.transform));
+                glUniformMatrix4fv(viewMatrixUniform, 1, GL_FALSE, glm::value_ptr(parent.camera.view));
+                glUniformMatrix4fv(projectionMatrixUniform, 1, GL_FALSE, glm::value_ptr(parent.camera.projection));
+            }
+        };
+
+        /// The largest number of quads drawn at once; limited by the range of 16-bit indices.
+        static constexpr std::size_t MAX_QUADS = 65536u / 4u;
+        /// The minimum number of quads or instances reserved from the stream buffer at once.
+        static constexpr std::size_t MIN_RESERVED_ELEMENTS = 1024u;
+
+        program quadProgram{}, instanceProgram{};
 
-        GLuint vao{0};
+        GLuint quadVao{0}, instanceVao{0}, indexBuffer{0};
+        std::unique_ptr<stream_buffer> vertexBuffer{};
+        uint32 maxSlots{1};
 
+        // Quads (four vertices each) or instances are written directly into the reserved stream buffer memory
+        batch_mode mode{batch_mode::quads};
         GLuint count{0};
-        std::vector<GLfloat> vertices{};
-        std::vector<GLfloat> texCoords{};
+        std::byte *memory{nullptr};
+        std::size_t capacity{0};
+
+        uint32 maxBatchSize{DEFAULT_MAX_BATCH_SIZE};
+        batch_stats stats{};
+        // Rebuilt on the first culled draw of a batch, and whenever the camera or transformation changes
+        view_culler_cache culler{};
 
         bool drawing{false};
         std::shared_ptr<texture> currentTexture{nullptr};
+        // Textures bound to consecutive sampler slots in the pending draw
+        std::vector<std::shared_ptr<texture>> slotTextures{};
 
         LIBMUSUBI_DELCP(impl)
 
         impl() = default;
 
         void init() {
-            shader.link(
+            GLint maxUnits{0};
+            glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &maxUnits);
+            maxSlots = std::clamp<uint32>(static_cast<uint32>(maxUnits), 1, MAX_TEXTURE_SLOTS);
+
+            // GLSL 3.30 only allows indexing sampler arrays with constant expressions, so select the sampler by branch
+            std::string fragmentSource =
+                    "#version 330\n"
+                    "\n"
+                    "uniform sampler2D u_textures["s + std::to_string(maxSlots) + "];\n"
+                    "\n"
+                    "in vec2 f_uv;\n"
+                    "in vec4 f_tint;\n"
+                    "flat in uint f_slot;\n"
+                    "\n"
+                    "out vec4 color;\n"
+                    "void main() {\n"
+                    "    vec4 texel = vec4(0);\n"
+                    "    switch (f_slot) {\n";
+            for (uint32 slot = 0; slot < maxSlots; ++slot) {
+                const auto index = std::to_string(slot);
+                fragmentSource += "        case "s + index + "u: texel = texture(u_textures["s + index + "], f_uv); break;\n"s;
+            }
+            fragmentSource +=
+                    "    }\n"
+                    "    color = texel * f_tint;\n"
+                    "}";
+
+            quadProgram.link(
                     "#version 330\n"
                     "\n"
                     "uniform mat4 mP;\n"
@@ -128,173 +554,433 @@ namespace musubi::gl {
                     "uniform mat4 mM;\n"
                     "layout (location = 0) in vec2 vPosition;\n"
                     "layout (location = 1) in vec2 uv;\n"
+                    "layout (location = 2) in uint slot;\n"
+                    "layout (location = 3) in vec4 tint;\n"
                     "\n"
                     "out vec2 f_uv;\n"
+                    "out vec4 f_tint;\n"
+                    "flat out uint f_slot;\n"
                     "\n"
                     "void main() {\n"
                     "    gl_Position = mP * mV * mM * vec4(vPosition, 0, 1);\n"
                     "    f_uv = uv;\n"
+                    "    f_tint = tint;\n"
+                    "    f_slot = slot;\n"
                     "}",
 
+                    fragmentSource, maxSlots
+            );
+
+            // Instances are expanded into a triangle strip of four corners, rotated around the sprite's center
+            instanceProgram.link(
                     "#version 330\n"
                     "\n"
-                    "uniform sampler2D u_texture;\n"
+                    "uniform mat4 mP;\n"
+                    "uniform mat4 mV;\n"
+                    "uniform mat4 mM;\n"
+                    "layout (location = 0) in vec4 iRect;\n"
+                    "layout (location = 1) in float iRotation;\n"
+                    "layout (location = 2) in vec4 iUv;\n"
+                    "layout (location = 3) in vec4 iTint;\n"
+                    "layout (location = 4) in uint iSlot;\n"
                     "\n"
-                    "in vec2 f_uv;\n"
+                    "out vec2 f_uv;\n"
+                    "out vec4 f_tint;\n"
+                    "flat out uint f_slot;\n"
                     "\n"
-                    "out vec4 color;\n"
                     "void main() {\n"
-                    "    color = texture2D(u_texture, f_uv);\n"
-                    "}"
+                    "    vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);\n"
+                    "    vec2 local = (corner - 0.5) * iRect.zw;\n"
+                    "    float s = sin(iRotation), c = cos(iRotation);\n"
+                    "    vec2 center = iRect.xy + 0.5 * iRect.zw;\n"
+                    "    vec2 position = center + vec2(c * local.x - s * local.y, s * local.x + c * local.y);\n"
+                    "    gl_Position = mP * mV * mM * vec4(position, 0, 1);\n"
+                    "    f_uv = mix(iUv.xy, iUv.zw, corner);\n"
+                    "    f_tint = iTint;\n"
+                    "    f_slot = iSlot;\n"
+                    "}",
+
+                    fragmentSource, maxSlots
             );
 
-            textureUniform = glGetUniformLocation(shader, "u_texture");
-            modelMatrixUniform = glGetUniformLocation(shader, "mM");
-            viewMatrixUniform = glGetUniformLocation(shader, "mV");
-            projectionMatrixUniform = glGetUniformLocation(shader, "mP");
+            // All quads share the same index pattern, so the index buffer is filled once
+            std::vector<GLushort> indices(MAX_QUADS * 6);
+            for (std::size_t quad = 0; quad < MAX_QUADS; ++quad) {
+                const auto first = static_cast<GLushort>(quad * 4);
+                const auto index = quad * 6;
+                indices[index] = first;
+                indices[index + 1] = first + 1;
+                indices[index + 2] = first + 2;
+                indices[index + 3] = first + 3;
+                indices[index + 4] = first + 2;
+                indices[index + 5] = first + 1;
+            }
+
+            glGenVertexArrays(1, &quadVao);
+            glGenBuffers(1, &indexBuffer);
+            glBindVertexArray(quadVao);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indices.size() * sizeof(GLushort)),
+                         indices.data(), GL_STATIC_DRAW);
+            for (GLuint attribute = 0; attribute < 4; ++attribute) glEnableVertexAttribArray(attribute);
+
+            glGenVertexArrays(1, &instanceVao);
+            glBindVertexArray(instanceVao);
+            for (GLuint attribute = 0; attribute < 5; ++attribute) {
+                glEnableVertexAttribArray(attribute);
+                glVertexAttribDivisor(attribute, 1);
+            }
+            glBindVertexArray(0);
 
-            glGenVertexArrays(1, &vao);
+            vertexBuffer = std::make_unique<stream_buffer>();
         }
 
-        ~impl() { glDeleteVertexArrays(1, &vao); }
+        ~impl() {
+            glDeleteBuffers(1, &indexBuffer);
+            glDeleteVertexArrays(1, &instanceVao);
+            glDeleteVertexArrays(1, &quadVao);
+        }
 
         void begin_batch(std::shared_ptr<texture> texture) {
             if (drawing) throw illegal_state_error("Cannot call begin_batch twice, renderer is already drawing");
-            if (!texture) throw std::invalid_argument("Cannot begin texture batch; specified texture pointer is empty");
-            if (!*texture) throw std::invalid_argument("Cannot begin texture batch; specified texture is invalid");
+            if (texture && !*texture) {
+                throw std::invalid_argument("Cannot begin texture batch; specified texture is invalid");
+            }
             currentTexture = std::move(texture);
+            culler.invalidate();
             drawing = true;
         }
 
         void end_batch(const gl_texture_renderer &parent) {
             if (!drawing) throw illegal_state_error("Cannot end texture batch, begin has not yet been called");
-            flush(parent);
+            flush(parent, flush_reason::explicit_flush);
             currentTexture.reset();
             drawing = false;
         }
 
-        void flush(const gl_texture_renderer &parent) {
-            GLuint vbo{0};
-            glBindVertexArray(vao);
-            glGenBuffers(1, &vbo);
-            glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        [[nodiscard]] std::size_t get_element_size() const noexcept {
+            return mode == batch_mode::quads ? 4 * sizeof(vertex) : sizeof(instance);
+        }
 
-            glBufferData(GL_ARRAY_BUFFER, count * 4 * sizeof(GLfloat), nullptr, GL_STREAM_DRAW);
-            glBufferSubData(GL_ARRAY_BUFFER, 0, count * 2 * sizeof(GLfloat), vertices.data());
-            glBufferSubData(
-                    GL_ARRAY_BUFFER,
-                    count * 2 * sizeof(GLfloat), count * 2 * sizeof(GLfloat),
-                    texCoords.data()
-            );
+        static void set_attribute(GLuint index, GLint size, GLenum type, GLboolean normalized,
+                                  GLsizei stride, std::size_t offset) {
+            glVertexAttribPointer(index, size, type, normalized, stride,
+                                  get_buffer_offset(static_cast<GLuint>(offset)));
+        }
 
-            glEnableVertexAttribArray(0);
-            glEnableVertexAttribArray(1);
-            glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
-            glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 0, get_buffer_offset(count * 2 * sizeof(GLfloat)));
+        static void set_integer_attribute(GLuint index, GLenum type, GLsizei stride, std::size_t offset) {
+            glVertexAttribIPointer(index, 1, type, stride, get_buffer_offset(static_cast<GLuint>(offset)));
+        }
 
-            glUseProgram(shader);
-            glActiveTexture(GL_TEXTURE0 + 0);
-            glBindTexture(GL_TEXTURE_2D, *currentTexture);
+        void flush(const gl_texture_renderer &parent, flush_reason reason) {
+            if (count == 0) {
+                slotTextures.clear();
+                return;
+            }
 
-            glUniform1i(textureUniform, 0);
-            glUniformMatrix4fv(modelMatrixUniform, 1, GL_FALSE, glm::value_ptr(parent.transform));
-            glUniformMatrix4fv(viewMatrixUniform, 1, GL_FALSE, glm::value_ptr(parent.camera.view));
-            glUniformMatrix4fv(projectionMatrixUniform, 1, GL_FALSE, glm::value_ptr(parent.camera.projection));
+            const auto offset = vertexBuffer->commit(count * get_element_size());
+            memory = nullptr;
+            capacity = 0;
 
-            glDrawArrays(GL_TRIANGLES, 0, count);
+            const auto &program = mode == batch_mode::quads ? quadProgram : instanceProgram;
+            glBindVertexArray(mode == batch_mode::quads ? quadVao : instanceVao);
+            glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer->get_buffer());
 
-            glDisableVertexAttribArray(0);
-            glDisableVertexAttribArray(1);
+            if (mode == batch_mode::quads) {
+                constexpr auto stride = static_cast<GLsizei>(sizeof(vertex));
+                set_attribute(0, 2, GL_FLOAT, GL_FALSE, stride, offset + offsetof(vertex, x));
+                set_attribute(1, 2, GL_FLOAT, GL_FALSE, stride, offset + offsetof(vertex, u));
+                set_integer_attribute(2, GL_UNSIGNED_BYTE, stride, offset + offsetof(vertex, slot));
+                set_attribute(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, offset + offsetof(vertex, tint));
+            } else {
+                constexpr auto stride = static_cast<GLsizei>(sizeof(instance));
+                const auto base = offset + offsetof(instance, sprite);
+                set_attribute(0, 4, GL_FLOAT, GL_FALSE, stride, base + offsetof(sprite_instance, x));
+                set_attribute(1, 1, GL_FLOAT, GL_FALSE, stride, base + offsetof(sprite_instance, rotation));
+                set_attribute(2, 4, GL_FLOAT, GL_FALSE, stride, base + offsetof(sprite_instance, u1));
+                set_attribute(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, base + offsetof(sprite_instance, tint));
+                set_integer_attribute(4, GL_UNSIGNED_INT, stride, offset + offsetof(instance, slot));
+            }
+
+            program.use(parent);
+            bind_textures(slotTextures);
 
-            glDeleteBuffers(1, &vbo);
+            if (mode == batch_mode::quads) {
+                glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(count * 6), GL_UNSIGNED_SHORT, nullptr);
+            } else {
+                glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(count));
+            }
+            stats.record(reason, count, count * std::size_t{4});
 
             glUseProgram(0);
             glBindVertexArray(0);
 
             count = 0;
-            vertices.clear();
-            texCoords.clear();
+            slotTextures.clear();
         }
 
-        std::shared_ptr<texture> check_current_texture(const std::weak_ptr<texture> &weakPtr) {
-            const auto ptr = weakPtr.lock();
+        static void bind_textures(const std::vector<std::shared_ptr<texture>> &textures) {
+            for (std::size_t slot = 0; slot < textures.size(); ++slot) {
+                glActiveTexture(GL_TEXTURE0 + static_cast<GLenum>(slot));
+                glBindTexture(GL_TEXTURE_2D, *textures[slot]);
+            }
+            glActiveTexture(GL_TEXTURE0);
+        }
 
-            if (!ptr) throw std::invalid_argument("Specified texture_region refers to a deleted texture");
-            if (!currentTexture) throw assertion_error("Current texture pointer is empty");
-            if (ptr != currentTexture)
-                throw std::invalid_argument("Cannot add operation to batch; "
-                                            "the current batch texture and the specified texture_region's texture differ");
+        /// Ensures that another quad or instance can be written, flushing the pending draw if its mode differs,
+        /// the reserved memory is full, or the batch size limit is reached.
+        /// When memory is reserved, room for up to `wanted` elements is requested.
+        void reserve(const gl_texture_renderer &parent, batch_mode drawMode,
+                     std::size_t wanted = MIN_RESERVED_ELEMENTS) {
+            if (drawMode == mode && count < capacity) return;
+            if (count > 0) {
+                flush(parent, drawMode == mode ? flush_reason::capacity : flush_reason::mode_change);
+            } else if (vertexBuffer->is_reserved()) {
+                vertexBuffer->commit(0);
+            }
+
+            mode = drawMode;
+            const auto elementSize = get_element_size();
+            auto limit = std::size_t{maxBatchSize};
+            if (mode == batch_mode::quads) limit = std::min(limit, MAX_QUADS);
+            const auto reserved = vertexBuffer->reserve(
+                    std::max(std::min(wanted, limit), MIN_RESERVED_ELEMENTS) * elementSize
+            );
+            memory = reserved.data();
+            capacity = std::min(reserved.size() / elementSize, limit);
+        }
+
+        /// Finds or assigns the sampler slot of a texture, flushing the pending draw if all slots are in use.
+        GLubyte get_slot(const std::shared_ptr<texture> &texture, const gl_texture_renderer &parent) {
+            for (std::size_t slot = 0; slot < slotTextures.size(); ++slot) {
+                if (slotTextures[slot] == texture) return static_cast<GLubyte>(slot);
+            }
+            if (slotTextures.size() == maxSlots) flush(parent, flush_reason::texture_change);
+            slotTextures.push_back(texture);
+            return static_cast<GLubyte>(slotTextures.size() - 1);
+        }
+
+        /// Reserves room for another quad or instance of a texture, and returns the texture's sampler slot.
+        GLubyte prepare(const std::shared_ptr<texture> &texture, const gl_texture_renderer &parent,
+                        batch_mode drawMode, std::size_t wanted = MIN_RESERVED_ELEMENTS) {
+            reserve(parent, drawMode, wanted);
+            const auto slot = get_slot(texture, parent);
+            // Assigning the slot may have flushed the pending draw, releasing the reserved memory
+            reserve(parent, drawMode, wanted);
+            return slot;
+        }
 
-            return ptr;
+        /// Generates the quads of consecutive sprites into the reserved memory.
+        /// Immediate, recorded and bulk draws all generate their vertices through the same vertex kernels.
+        void write_quads(const sprite *sprites, std::size_t n, GLubyte slot, bool flip,
+                         const gl_texture_renderer &parent) {
+            ::musubi::detail::get_vertex_kernels().generate_quads(
+                    reinterpret_cast<::musubi::detail::quad_vertex *>(memory) + count * 4,
+                    reinterpret_cast<const ::musubi::detail::quad_source *>(sprites), n,
+                    ::musubi::detail::to_affine_transform(glm::value_ptr(parent.drawTransform)), slot, flip
+            );
+            count += static_cast<GLuint>(n);
         }
 
-        void draw_region_impl(bool flip,
+        void draw_region_impl(const std::shared_ptr<texture> &texture, const gl_texture_renderer &parent,
                               GLfloat x, GLfloat y, GLfloat width, GLfloat height,
                               GLfloat u1, GLfloat v1, GLfloat u2, GLfloat v2) {
-            // Triangle 1
-            vertices.push_back(x);
-            vertices.push_back(y + height);
-            vertices.push_back(x);
-            vertices.push_back(y);
-            vertices.push_back(x + width);
-            vertices.push_back(y + height);
-
-            // Triangle 2
-            vertices.push_back(x + width);
-            vertices.push_back(y);
-            vertices.push_back(x + width);
-            vertices.push_back(y + height);
-            vertices.push_back(x);
-            vertices.push_back(y);
-
-            if (!flip) {
-                // Triangle 1
-                texCoords.push_back(u1);
-                texCoords.push_back(v2);
-                texCoords.push_back(u1);
-                texCoords.push_back(v1);
-                texCoords.push_back(u2);
-                texCoords.push_back(v2);
-
-                // Triangle 2
-                texCoords.push_back(u2);
-                texCoords.push_back(v1);
-                texCoords.push_back(u2);
-                texCoords.push_back(v2);
-                texCoords.push_back(u1);
-                texCoords.push_back(v1);
-            } else {
-                // Triangle 1
-                texCoords.push_back(u1);
-                texCoords.push_back(1 - v2);
-                texCoords.push_back(u1);
-                texCoords.push_back(1 - v1);
-                texCoords.push_back(u2);
-                texCoords.push_back(1 - v2);
-
-                // Triangle 2
-                texCoords.push_back(u2);
-                texCoords.push_back(1 - v1);
-                texCoords.push_back(u2);
-                texCoords.push_back(1 - v2);
-                texCoords.push_back(u1);
-                texCoords.push_back(1 - v1);
+            sprite entry{x, y, width, height, u1, v1, u2, v2};
+            if (parent.culling) {
+                culler.update(parent.camera, parent.transform);
+                if (!is_sprite_visible(entry, parent.drawTransform)) {
+                    ++stats.culled;
+                    return;
+                }
             }
 
-            count += 6;
+            const auto slot = prepare(texture, parent, batch_mode::quads);
+            ::musubi::detail::pack_color(entry.tint, glm::value_ptr(parent.tint));
+            write_quads(&entry, 1, slot, texture->should_flip(), parent);
         }
 
-        void batch_draw_texture(GLfloat x, GLfloat y, GLfloat width, GLfloat height) {
+        void batch_draw_texture(const std::shared_ptr<texture> &texture,
+                                GLfloat x, GLfloat y, GLfloat width, GLfloat height,
+                                GLfloat u1, GLfloat v1, GLfloat u2, GLfloat v2,
+                                const gl_texture_renderer &parent) {
             if (!drawing) throw illegal_state_error("Cannot add draw operation; batch has not been begun");
-            draw_region_impl(currentTexture->should_flip(), x, y, width, height, 0, 0, 1, 1);
+            if (!texture) throw std::invalid_argument("Cannot add draw operation; specified texture pointer is empty");
+            if (!*texture) throw std::invalid_argument("Cannot add draw operation; specified texture is invalid");
+
+            draw_region_impl(texture, parent, x, y, width, height, u1, v1, u2, v2);
         }
 
         void batch_draw_region(const texture_region &region,
-                               GLfloat x, GLfloat y, GLfloat width, GLfloat height) {
+                               GLfloat x, GLfloat y, GLfloat width, GLfloat height,
+                               const gl_texture_renderer &parent) {
             if (!drawing) throw illegal_state_error("Cannot add draw operation; batch has not been begun");
 
-            const auto texture = check_current_texture(region.texture);
-            draw_region_impl(texture->should_flip(), x, y, width, height, region.u1, region.v1, region.u2, region.v2);
+            const auto texture = region.texture.lock();
+            if (!texture) throw std::invalid_argument("Specified texture_region refers to a deleted texture");
+            draw_region_impl(texture, parent, x, y, width, height, region.u1, region.v1, region.u2, region.v2);
+        }
+
+        void batch_draw_instances(const std::shared_ptr<texture> &texture, span<const sprite_instance> sprites,
+                                  const gl_texture_renderer &parent) {
+            if (!drawing) throw illegal_state_error("Cannot add draw operation; batch has not been begun");
+            if (!texture) throw std::invalid_argument("Cannot add draw operation; specified texture pointer is empty");
+            if (!*texture) throw std::invalid_argument("Cannot add draw operation; specified texture is invalid");
+
+            const auto flip = texture->should_flip();
+            if (parent.culling) culler.update(parent.camera, parent.transform);
+            std::size_t next = 0;
+            while (next < sprites.size()) {
+                const auto slot = prepare(texture, parent, batch_mode::instances, sprites.size() - next);
+                const auto room = capacity - count;
+
+                auto *instances = reinterpret_cast<instance *>(memory) + count;
+                std::size_t written = 0;
+                for (; next < sprites.size() && written < room; ++next) {
+                    const auto &sprite = sprites[next];
+                    if (parent.culling && !is_instance_visible(sprite)) {
+                        ++stats.culled;
+                        continue;
+                    }
+
+                    auto &target = instances[written++];
+                    target.sprite = sprite;
+                    target.slot = slot;
+                    if (flip) {
+                        target.sprite.v1 = 1 - target.sprite.v1;
+                        target.sprite.v2 = 1 - target.sprite.v2;
+                    }
+                }
+                count += static_cast<GLuint>(written);
+            }
+        }
+
+        /// Tests the bounding box of a transformed quad, given its lower left corner and its two edges.
+        [[nodiscard]] bool is_quad_visible(const glm::vec2 &origin, const glm::vec2 &right,
+                                           const glm::vec2 &up) const noexcept {
+            const auto opposite = origin + right + up;
+            return culler.get().is_visible(std::min({origin.x, origin.x + right.x, origin.x + up.x, opposite.x}),
+                                           std::min({origin.y, origin.y + right.y, origin.y + up.y, opposite.y}),
+                                           std::max({origin.x, origin.x + right.x, origin.x + up.x, opposite.x}),
+                                           std::max({origin.y, origin.y + right.y, origin.y + up.y, opposite.y}));
+        }
+
+        /// Tests the bounding box of a sprite under the current draw transformation.
+        [[nodiscard]] bool is_sprite_visible(const sprite &sprite, const glm::mat3 &m) const noexcept {
+            return is_quad_visible(glm::vec2{m * glm::vec3{sprite.x, sprite.y, 1}},
+                                   glm::vec2{m[0] * sprite.width}, glm::vec2{m[1] * sprite.height});
+        }
+
+        /// Tests the bounding box of a sprite instance under any rotation, i.e. of its circumscribed circle.
+        [[nodiscard]] bool is_instance_visible(const sprite_instance &sprite) const noexcept {
+            const auto radius = 0.5f * std::sqrt(sprite.width * sprite.width + sprite.height * sprite.height);
+            const auto centerX = sprite.x + 0.5f * sprite.width, centerY = sprite.y + 0.5f * sprite.height;
+            return culler.get().is_visible(centerX - radius, centerY - radius, centerX + radius, centerY + radius);
+        }
+
+        /// Tests the bounding box of a recorded quad.
+        [[nodiscard]] bool is_quad_visible(const vertex *quad) const noexcept {
+            auto minX = quad[0].x, maxX = quad[0].x, minY = quad[0].y, maxY = quad[0].y;
+            for (std::size_t i = 1; i < 4; ++i) {
+                minX = std::min(minX, quad[i].x);
+                maxX = std::max(maxX, quad[i].x);
+                minY = std::min(minY, quad[i].y);
+                maxY = std::max(maxY, quad[i].y);
+            }
+            return culler.get().is_visible(minX, minY, maxX, maxY);
+        }
+
+        void batch_draw_recorded(const sprite_recorder &recorder, const gl_texture_renderer &parent) {
+            if (!drawing) throw illegal_state_error("Cannot add draw operation; batch has not been begun");
+
+            if (parent.culling) culler.update(parent.camera, parent.transform);
+            const auto *source = recorder.get_vertices().data();
+            auto remaining = recorder.size();
+            for (const auto &run : recorder.get_runs()) {
+                std::size_t next = 0;
+                while (next < run.sprites) {
+                    // Reserve room for the rest of the recorder, not just this run
+                    const auto slot = prepare(run.texture, parent, batch_mode::quads, remaining);
+                    const auto room = capacity - count;
+
+                    // Assemble each vertex before storing it, so that mapped memory is written sequentially
+                    auto *target = reinterpret_cast<vertex *>(memory) + count * 4;
+                    std::size_t written = 0;
+                    for (; next < run.sprites && written < room; ++next, --remaining, source += 4) {
+                        if (parent.culling && !is_quad_visible(source)) {
+                            ++stats.culled;
+                            continue;
+                        }
+
+                        for (std::size_t i = 0; i < 4; ++i) {
+                            auto entry = source[i];
+                            entry.slot = slot;
+                            target[written * 4 + i] = entry;
+                        }
+                        ++written;
+                    }
+                    count += static_cast<GLuint>(written);
+                }
+            }
+        }
+
+        void batch_draw_regions(const std::shared_ptr<texture> &texture, span<const sprite> sprites,
+                                const gl_texture_renderer &parent) {
+            if (!drawing) throw illegal_state_error("Cannot add draw operation; batch has not been begun");
+            if (!texture) throw std::invalid_argument("Cannot add draw operation; specified texture pointer is empty");
+            if (!*texture) throw std::invalid_argument("Cannot add draw operation; specified texture is invalid");
+
+            const auto flip = texture->should_flip();
+            if (parent.culling) culler.update(parent.camera, parent.transform);
+
+            std::size_t next = 0;
+            while (next < sprites.size()) {
+                if (parent.culling) {
+                    while (next < sprites.size() && !is_sprite_visible(sprites[next], parent.drawTransform)) {
+                        ++stats.culled;
+                        ++next;
+                    }
+                    if (next == sprites.size()) break;
+                }
+
+                const auto slot = prepare(texture, parent, batch_mode::quads, sprites.size() - next);
+                auto n = std::min<std::size_t>(sprites.size() - next, capacity - count);
+                if (parent.culling) {
+                    // Generate the run of visible sprites; the first one has already been tested
+                    std::size_t visible = 1;
+                    while (visible < n && is_sprite_visible(sprites[next + visible], parent.drawTransform)) ++visible;
+                    n = visible;
+                }
+
+                write_quads(&sprites[next], n, slot, flip, parent);
+                next += n;
+            }
+        }
+
+        void draw_static(const static_batch &batch, const gl_texture_renderer &parent) {
+            if (!batch.is_uploaded()) throw illegal_state_error("Cannot draw static batch; it has not been uploaded");
+            const auto segments = batch.get_segments();
+            if (segments.empty()) return;
+            // Pending operations were issued before the static batch, so they are drawn first
+            if (drawing) flush(parent, flush_reason::retained);
+
+            // The view volume is taken from the current camera, as static batches may be drawn outside of a batch
+            const view_culler staticCuller(parent.camera, parent.transform);
+            glBindVertexArray(batch.get_sprite_vertex_array());
+            quadProgram.use(parent);
+            for (const auto &segment : segments) {
+                if (parent.culling && !staticCuller.is_visible(segment.bounds)) {
+                    stats.culled += static_cast<uint64>(segment.quads);
+                    continue;
+                }
+
+                bind_textures(segment.textures);
+                glDrawElementsBaseVertex(GL_TRIANGLES, segment.quads * 6, GL_UNSIGNED_SHORT, nullptr,
+                                         segment.baseVertex);
+                stats.record(flush_reason::retained, static_cast<uint64>(segment.quads),
+                             static_cast<uint64>(segment.quads) * 4);
+            }
+            glUseProgram(0);
+            glBindVertexArray(0);
         }
     };
 
@@ -304,19 +990,76 @@ namespace musubi::gl {
 
     void gl_texture_renderer::init() { pImpl->init(); }
 
-    void gl_texture_renderer::begin_batch(std::shared_ptr<texture> texture) { pImpl->begin_batch(std::move(texture)); }
+    void gl_texture_renderer::begin_batch() { pImpl->begin_batch(nullptr); }
+
+    void gl_texture_renderer::begin_batch(std::shared_ptr<texture> texture) {
+        if (!texture) throw std::invalid_argument("Cannot begin texture batch; specified texture pointer is empty");
+        pImpl->begin_batch(std::move(texture));
+    }
 
     void gl_texture_renderer::end_batch(bool resetTransform) {
         pImpl->end_batch(*this);
-        if (resetTransform) transform = glm::mat4{1};
+        if (resetTransform) {
+            transform = glm::mat4{1};
+            drawTransform = glm::mat3{1};
+        }
     }
 
     void gl_texture_renderer::batch_draw_texture(GLfloat x, GLfloat y, GLfloat width, GLfloat height) {
-        pImpl->batch_draw_texture(x, y, width, height);
+        if (pImpl->drawing && !pImpl->currentTexture) {
+            throw illegal_state_error("Cannot draw batch texture; batch was begun without a texture");
+        }
+        pImpl->batch_draw_texture(pImpl->currentTexture, x, y, width, height, 0, 0, 1, 1, *this);
+    }
+
+    void gl_texture_renderer::batch_draw_texture(const std::shared_ptr<texture> &texture,
+                                                 GLfloat x, GLfloat y, GLfloat width, GLfloat height) {
+        pImpl->batch_draw_texture(texture, x, y, width, height, 0, 0, 1, 1, *this);
+    }
+
+    void gl_texture_renderer::batch_draw_texture(const std::shared_ptr<texture> &texture,
+                                                 GLfloat x, GLfloat y, GLfloat width, GLfloat height,
+                                                 GLfloat u1, GLfloat v1, GLfloat u2, GLfloat v2) {
+        pImpl->batch_draw_texture(texture, x, y, width, height, u1, v1, u2, v2, *this);
     }
 
     void gl_texture_renderer::batch_draw_region(const texture_region &region,
                                                 GLfloat x, GLfloat y, GLfloat width, GLfloat height) {
-        pImpl->batch_draw_region(region, x, y, width, height);
+        pImpl->batch_draw_region(region, x, y, width, height, *this);
     }
+
+    void gl_texture_renderer::batch_draw_instance(const std::shared_ptr<texture> &texture,
+                                                  const sprite_instance &instance) {
+        pImpl->batch_draw_instances(texture, {&instance, 1}, *this);
+    }
+
+    void gl_texture_renderer::batch_draw_instances(const std::shared_ptr<texture> &texture,
+                                                   span<const sprite_instance> instances) {
+        pImpl->batch_draw_instances(texture, instances, *this);
+    }
+
+    void gl_texture_renderer::batch_draw_recorded(const sprite_recorder &recorder) {
+        pImpl->batch_draw_recorded(recorder, *this);
+    }
+
+    void gl_texture_renderer::batch_draw_regions(const std::shared_ptr<texture> &texture, span<const sprite> sprites) {
+        pImpl->batch_draw_regions(texture, sprites, *this);
+    }
+
+    void gl_texture_renderer::draw_static(const static_batch &batch) { pImpl->draw_static(batch, *this); }
+
+    uint32 gl_texture_renderer::get_max_batch_size() const noexcept { return pImpl->maxBatchSize; }
+
+    void gl_texture_renderer::set_max_batch_size(uint32 sprites) {
+        if (sprites == 0) throw std::invalid_argument("Maximum batch size must be positive");
+        pImpl->maxBatchSize = sprites;
+        // Takes effect for the pending draw at its next operation
+        pImpl->capacity = std::min<std::size_t>(pImpl->capacity, sprites);
+    }
+
+    batch_stats gl_texture_renderer::get_stats() const noexcept { return pImpl->stats; }
+
+    void gl_texture_renderer::reset_stats() noexcept { pImpl->stats = {}; }
+
+    uint32 gl_texture_renderer::get_texture_slots() const noexcept { return pImpl->maxSlots; }
 }
@@ -0,0 +1,233 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#include <musubi/mapped_pixmap.h>
+
+#include <musubi/exception.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+    using namespace musubi;
+
+    constexpr char MAGIC[4]{'M', 'P', 'X', 'M'};
+    constexpr uint16 VERSION = 1u;
+    // Keeps the first row cache-line aligned, since mappings start at a page boundary
+    constexpr std::size_t MIN_DATA_ALIGNMENT = 64u;
+
+    struct file_header {
+        pixmap_format format;
+        uint32 width, height;
+        std::size_t stride, offset;
+    };
+
+    template<typename T>
+    void put_le(unsigned char *out, T value, std::size_t bytes) noexcept {
+        for (std::size_t i = 0; i < bytes; ++i) out[i] = static_cast<unsigned char>((value >> (i * 8u)) & 0xFFu);
+    }
+
+    std::uint64_t get_le(const unsigned char *in, std::size_t bytes) noexcept {
+        std::uint64_t value = 0;
+        for (std::size_t i = 0; i < bytes; ++i) value |= std::uint64_t{in[i]} << (i * 8u);
+        return value;
+    }
+
+    void encode_header(unsigned char (&out)[mapped_pixmap::HEADER_SIZE], const file_header &header) noexcept {
+        std::memset(out, 0, sizeof(out));
+        std::memcpy(out, MAGIC, sizeof(MAGIC));
+        put_le(out + 4, VERSION, 2);
+        out[6] = static_cast<unsigned char>(header.format);
+        put_le(out + 8, header.width, 4);
+        put_le(out + 12, header.height, 4);
+        put_le(out + 16, header.stride, 8);
+        put_le(out + 24, header.offset, 8);
+    }
+
+    std::string errno_string() { return std::strerror(errno); }
+
+    /// A file descriptor that is closed when it goes out of scope.
+    struct scoped_fd {
+        int fd;
+
+        ~scoped_fd() { if (fd >= 0) ::close(fd); }
+    };
+}
+
+namespace musubi {
+    mapped_pixmap::mapped_pixmap(const std::filesystem::path &path, access_mode mode) : mode(mode) {
+        const auto fail = [&](const std::string &reason) {
+            return resource_read_error("Could not map pixmap "s + path.string() + ": "s + reason);
+        };
+
+        const scoped_fd file{::open(path.c_str(), mode == access_mode::read_write ? O_RDWR : O_RDONLY)};
+        if (file.fd < 0) throw fail(errno_string());
+
+        struct stat status{};
+        if (::fstat(file.fd, &status) != 0) throw fail(errno_string());
+        const auto fileSize = static_cast<std::size_t>(status.st_size);
+        if (fileSize < HEADER_SIZE) throw fail("file is too small to contain a header");
+
+        const auto protection = mode == access_mode::read_write ? PROT_READ | PROT_WRITE : PROT_READ;
+        const auto address = ::mmap(nullptr, fileSize, protection, MAP_SHARED, file.fd, 0);
+        if (address == MAP_FAILED) throw fail(errno_string());
+        mapping = static_cast<byte *>(address);
+        mappingSize = fileSize;
+
+        try {
+            const auto header = reinterpret_cast<const unsigned char *>(mapping);
+            if (std::memcmp(header, MAGIC, sizeof(MAGIC)) != 0) throw fail("invalid magic bytes");
+            if (get_le(header + 4, 2) != VERSION) {
+                throw fail("unsupported version "s + std::to_string(get_le(header + 4, 2)));
+            }
+            if (header[6] > static_cast<unsigned char>(pixmap_format::la8)) {
+                throw fail("unknown pixel format "s + std::to_string(header[6]));
+            }
+
+            format = static_cast<pixmap_format>(header[6]);
+            width = static_cast<uint32>(get_le(header + 8, 4));
+            height = static_cast<uint32>(get_le(header + 12, 4));
+            stride = static_cast<std::size_t>(get_le(header + 16, 8));
+            const auto offset = static_cast<std::size_t>(get_le(header + 24, 8));
+
+            const auto rowSize = width * get_bytes_per_pixel(format);
+            if (stride < rowSize) throw fail("row stride is smaller than a row");
+            if (offset < HEADER_SIZE || offset > fileSize) throw fail("invalid data offset");
+            // Zero-width images (whose stride may be 0) have no pixel data to check
+            if (height != 0 && stride != 0
+                && (fileSize - offset < rowSize || (fileSize - offset - rowSize) / stride < height - 1)) {
+                throw fail("file is too small to contain " + std::to_string(height) + " rows");
+            }
+            pixels = mapping + offset;
+        } catch (...) {
+            unmap();
+            throw;
+        }
+    }
+
+    mapped_pixmap::mapped_pixmap(mapped_pixmap &&other) noexcept
+            : mapping(std::exchange(other.mapping, nullptr)), mappingSize(std::exchange(other.mappingSize, 0)),
+              pixels(std::exchange(other.pixels, nullptr)),
+              width(std::exchange(other.width, 0)), height(std::exchange(other.height, 0)),
+              stride(std::exchange(other.stride, 0)), format(other.format), mode(other.mode) {}
+
+    mapped_pixmap &mapped_pixmap::operator=(mapped_pixmap &&other) noexcept {
+        if (this != &other) {
+            unmap();
+            mapping = std::exchange(other.mapping, nullptr);
+            mappingSize = std::exchange(other.mappingSize, 0);
+            pixels = std::exchange(other.pixels, nullptr);
+            width = std::exchange(other.width, 0);
+            height = std::exchange(other.height, 0);
+            stride = std::exchange(other.stride, 0);
+            format = other.format;
+            mode = other.mode;
+        }
+        return *this;
+    }
+
+    mapped_pixmap::~mapped_pixmap() noexcept { unmap(); }
+
+    void mapped_pixmap::unmap() noexcept {
+        if (mapping) ::munmap(mapping, mappingSize);
+        mapping = nullptr;
+        mappingSize = 0;
+        pixels = nullptr;
+    }
+
+    mapped_pixmap mapped_pixmap::create(const std::filesystem::path &path, pixmap_format format,
+                                        uint32 width, uint32 height, std::size_t rowAlignment) {
+        if (rowAlignment == 0 || (rowAlignment & (rowAlignment - 1)) != 0) {
+            throw std::invalid_argument("Pixmap row alignment must be a power of two, was: "s
+                                        + std::to_string(rowAlignment));
+        }
+
+        file_header header{format, width, height, 0, 0};
+        header.stride = detail::align_up(width * get_bytes_per_pixel(format), rowAlignment);
+        header.offset = detail::align_up(HEADER_SIZE, std::max(rowAlignment, MIN_DATA_ALIGNMENT));
+
+        const auto fail = [&](const std::string &reason) {
+            return resource_write_error("Could not create mapped pixmap "s + path.string() + ": "s + reason);
+        };
+        {
+            const scoped_fd file{::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644)};
+            if (file.fd < 0) throw fail(errno_string());
+
+            unsigned char bytes[HEADER_SIZE];
+            encode_header(bytes, header);
+            if (::pwrite(file.fd, bytes, sizeof(bytes), 0) != static_cast<ssize_t>(sizeof(bytes))) {
+                throw fail(errno_string());
+            }
+            // Extending the file leaves a sparse, zero-filled region for the pixel data
+            if (::ftruncate(file.fd, static_cast<off_t>(header.offset + header.stride * height)) != 0) {
+                throw fail(errno_string());
+            }
+        }
+        return mapped_pixmap(path, access_mode::read_write);
+    }
+
+    void mapped_pixmap::write(const std::filesystem::path &path, const pixmap &source) {
+        const auto rowSize = source.get_width() * get_bytes_per_pixel(source.get_format());
+        const file_header header{source.get_format(), source.get_width(), source.get_height(),
+                                 rowSize, detail::align_up(HEADER_SIZE, MIN_DATA_ALIGNMENT)};
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        const auto fail = [&]() {
+            return resource_write_error("Could not write mapped pixmap "s + path.string());
+        };
+        if (!out) throw fail();
+
+        unsigned char bytes[HEADER_SIZE];
+        encode_header(bytes, header);
+        out.write(reinterpret_cast<const char *>(bytes), sizeof(bytes));
+        const std::vector<char> padding(header.offset - HEADER_SIZE, 0);
+        out.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+
+        const pixmap_view view(source);
+        const std::vector<char> emptyRow(source.data() ? 0 : rowSize, 0);
+        for (uint32 y = 0; y < view.get_height(); ++y) {
+            const auto row = source.data() ? reinterpret_cast<const char *>(view.row_data(y)) : emptyRow.data();
+            out.write(row, static_cast<std::streamsize>(rowSize));
+        }
+        if (!out.flush()) throw fail();
+    }
+
+    byte *mapped_pixmap::mutable_data() {
+        if (mode != access_mode::read_write) {
+            throw illegal_state_error("Cannot modify a read-only mapped pixmap");
+        }
+        return pixels;
+    }
+
+    void mapped_pixmap::prefetch_rows(uint32 firstRow, uint32 rowCount) const noexcept {
+        if (!mapping || firstRow >= height) return;
+        rowCount = std::min(rowCount, height - firstRow);
+        if (rowCount == 0) return;
+
+        // madvise requires a page-aligned start address
+        const auto pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        const auto begin = static_cast<std::size_t>(pixels - mapping) + firstRow * stride;
+        const auto end = std::min(mappingSize, begin + rowCount * stride);
+        const auto alignedBegin = begin / pageSize * pageSize;
+        ::madvise(mapping + alignedBegin, end - alignedBegin, MADV_WILLNEED);
+    }
+
+    void mapped_pixmap::flush() {
+        if (!mapping || mode != access_mode::read_write) return;
+        if (::msync(mapping, mappingSize, MS_SYNC) != 0) {
+            throw resource_write_error("Could not flush mapped pixmap: "s + errno_string());
+        }
+    }
+}
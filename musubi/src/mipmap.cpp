@@ -0,0 +1,173 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#include <musubi/mipmap.h>
+
+#include <musubi/thread_pool.h>
+
+#include "simd/pixmap_kernels.h"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+    using namespace musubi;
+
+    /// Runs a row function over [0, count), splitting rows across a pool if one is specified.
+    template<typename Function>
+    void for_rows(std::size_t count, thread_pool *pool, Function &&function) {
+        if (pool) {
+            pool->parallel_for(count, function);
+        } else {
+            function(0, count);
+        }
+    }
+
+    void downscale_box(const pixmap_view &source, byte *dst, std::size_t dstStride,
+                       uint32 dstWidth, uint32 dstHeight, thread_pool *pool) {
+        const auto srcWidth = source.get_width(), srcHeight = source.get_height();
+        const auto channels = get_bytes_per_pixel(source.get_format());
+        const auto &kernels = detail::get_pixmap_kernels();
+        // Kernels read 2 * dstWidth pixels per row; with a single column, both samples are the same pixel
+        const auto useKernel = source.get_format() == pixmap_format::rgba8 && srcWidth >= 2;
+
+        for_rows(dstHeight, pool, [&](std::size_t first, std::size_t last) {
+            for (auto y = first; y < last; ++y) {
+                const auto row0 = reinterpret_cast<const std::uint8_t *>(source.row_data(std::min<uint32>(y * 2, srcHeight - 1)));
+                const auto row1 = reinterpret_cast<const std::uint8_t *>(source.row_data(std::min<uint32>(y * 2 + 1, srcHeight - 1)));
+                const auto out = reinterpret_cast<std::uint8_t *>(dst + y * dstStride);
+
+                if (useKernel) {
+                    kernels.downscale_box_rgba8(out, row0, row1, dstWidth);
+                    continue;
+                }
+                for (uint32 x = 0; x < dstWidth; ++x) {
+                    const auto x0 = std::min<uint32>(x * 2, srcWidth - 1) * channels;
+                    const auto x1 = std::min<uint32>(x * 2 + 1, srcWidth - 1) * channels;
+                    for (std::size_t c = 0; c < channels; ++c) {
+                        out[x * channels + c] = static_cast<std::uint8_t>(
+                                (row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c] + 2u) >> 2u
+                        );
+                    }
+                }
+            }
+        });
+    }
+
+    float lanczos3(float x) noexcept {
+        constexpr auto lobes = 3.0f;
+        if (x == 0.0f) return 1.0f;
+        if (std::abs(x) >= lobes) return 0.0f;
+        const auto px = pi<float> * x;
+        return lobes * std::sin(px) * std::sin(px / lobes) / (px * px);
+    }
+
+    /// Precomputed, normalized filter taps for resampling one axis.
+    struct axis_weights {
+        std::size_t taps{};
+        std::vector<uint32> indices{};
+        std::vector<float> weights{};
+
+        axis_weights(uint32 srcSize, uint32 dstSize) {
+            const auto scale = static_cast<float>(srcSize) / static_cast<float>(dstSize);
+            const auto support = 3.0f * std::max(scale, 1.0f);
+            taps = static_cast<std::size_t>(std::ceil(support)) * 2 + 1;
+            indices.resize(dstSize * taps);
+            weights.resize(dstSize * taps);
+
+            for (uint32 i = 0; i < dstSize; ++i) {
+                const auto center = (static_cast<float>(i) + 0.5f) * scale;
+                const auto first = static_cast<int64>(std::floor(center - support));
+                float sum = 0.0f;
+                for (std::size_t k = 0; k < taps; ++k) {
+                    const auto position = first + static_cast<int64>(k);
+                    const auto weight = lanczos3((static_cast<float>(position) + 0.5f - center) / std::max(scale, 1.0f));
+                    // Clamp to the edge; out-of-range taps sample the border pixel
+                    indices[i * taps + k] = static_cast<uint32>(std::clamp<int64>(position, 0, srcSize - 1));
+                    weights[i * taps + k] = weight;
+                    sum += weight;
+                }
+                for (std::size_t k = 0; k < taps; ++k) weights[i * taps + k] /= sum;
+            }
+        }
+    };
+
+    void downscale_lanczos3(const pixmap_view &source, byte *dst, std::size_t dstStride,
+                            uint32 dstWidth, uint32 dstHeight, thread_pool *pool) {
+        const auto srcHeight = source.get_height();
+        const auto channels = get_bytes_per_pixel(source.get_format());
+        const axis_weights horizontal(source.get_width(), dstWidth), vertical(srcHeight, dstHeight);
+
+        // Separable: resample rows horizontally into an intermediate buffer, then resample columns
+        const auto intermediateStride = dstWidth * channels;
+        std::vector<float> intermediate(srcHeight * intermediateStride);
+
+        for_rows(srcHeight, pool, [&](std::size_t first, std::size_t last) {
+            for (auto y = first; y < last; ++y) {
+                const auto in = reinterpret_cast<const std::uint8_t *>(source.row_data(y));
+                const auto out = intermediate.data() + y * intermediateStride;
+                for (uint32 x = 0; x < dstWidth; ++x) {
+                    const auto indices = horizontal.indices.data() + x * horizontal.taps;
+                    const auto weights = horizontal.weights.data() + x * horizontal.taps;
+                    for (std::size_t c = 0; c < channels; ++c) {
+                        float value = 0.0f;
+                        for (std::size_t k = 0; k < horizontal.taps; ++k) {
+                            value += weights[k] * in[indices[k] * channels + c];
+                        }
+                        out[x * channels + c] = value;
+                    }
+                }
+            }
+        });
+
+        for_rows(dstHeight, pool, [&](std::size_t first, std::size_t last) {
+            std::vector<float> row(intermediateStride);
+            for (auto y = first; y < last; ++y) {
+                const auto indices = vertical.indices.data() + y * vertical.taps;
+                const auto weights = vertical.weights.data() + y * vertical.taps;
+                std::fill(row.begin(), row.end(), 0.0f);
+                // Accumulate whole rows, so the inner loop runs over contiguous memory
+                for (std::size_t k = 0; k < vertical.taps; ++k) {
+                    const auto in = intermediate.data() + indices[k] * intermediateStride;
+                    for (std::size_t i = 0; i < intermediateStride; ++i) row[i] += weights[k] * in[i];
+                }
+                const auto out = reinterpret_cast<std::uint8_t *>(dst + y * dstStride);
+                for (std::size_t i = 0; i < intermediateStride; ++i) {
+                    out[i] = static_cast<std::uint8_t>(std::clamp(std::lround(row[i]), 0L, 255L));
+                }
+            }
+        });
+    }
+}
+
+namespace musubi::detail {
+    void downscale_pixels(const pixmap_view &source, byte *dst, std::size_t dstStride,
+                          downscale_filter filter, thread_pool *pool) {
+        const auto dstWidth = std::max<uint32>(source.get_width() / 2, 1);
+        const auto dstHeight = std::max<uint32>(source.get_height() / 2, 1);
+        if (source.get_width() == 0 || source.get_height() == 0) return;
+
+        if (is_packed_format(source.get_format())) {
+            // Packed components cannot be filtered bytewise; filter an rgba8 copy instead
+            const auto unpacked = convert_pixmap<pixmap_format::rgba8>(source);
+            buffer_pixmap<pixmap_format::rgba8> downscaled(dstWidth, dstHeight);
+            downscaled.ensure_buffer();
+            downscale_pixels(unpacked, downscaled.data(), downscaled.get_stride(), filter, pool);
+            copy_pixels(dst, dstStride, source.get_format(), downscaled, blend_mode::copy);
+            return;
+        }
+
+        switch (filter) {
+            case downscale_filter::box:
+                downscale_box(source, dst, dstStride, dstWidth, dstHeight, pool);
+                break;
+            case downscale_filter::lanczos3:
+                downscale_lanczos3(source, dst, dstStride, dstWidth, dstHeight, pool);
+                break;
+            default:
+                throw assertion_error("Unknown downscale_filter "s
+                                      + std::to_string(static_cast<std::underlying_type_t<downscale_filter>>(filter)));
+        }
+    }
+}
@@ -4,6 +4,199 @@
 
 #include <musubi/pixmap.h>
 
+#include <musubi/thread_pool.h>
+
+#include "simd/pixmap_kernels.h"
+
+#include <vector>
+
+namespace {
+    using namespace musubi;
+
+    inline std::uint8_t *as_bytes(byte *ptr) noexcept { return reinterpret_cast<std::uint8_t *>(ptr); }
+
+    inline const std::uint8_t *as_bytes(const byte *ptr) noexcept {
+        return reinterpret_cast<const std::uint8_t *>(ptr);
+    }
+
+    using row_kernel = void (*)(std::uint8_t *, const std::uint8_t *, std::size_t);
+
+    void r8_to_rgb8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i, dst += 3) {
+            dst[0] = src[i];
+            dst[1] = 0u;
+            dst[2] = 0u;
+        }
+    }
+
+    void rgb8_to_r8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) dst[i] = src[i * 3];
+    }
+
+    void la8_to_rgba8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i, src += 2, dst += 4) {
+            dst[0] = dst[1] = dst[2] = src[0];
+            dst[3] = src[1];
+        }
+    }
+
+    void rgba8_to_la8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+        // Rec. 601 luma, in 8-bit fixed point
+        for (std::size_t i = 0; i < count; ++i, src += 4, dst += 2) {
+            dst[0] = static_cast<std::uint8_t>((77u * src[0] + 150u * src[1] + 29u * src[2] + 128u) >> 8u);
+            dst[1] = src[3];
+        }
+    }
+
+    /// Selects the row kernel converting from a format to rgba8.
+    row_kernel get_rgba8_decoder(const detail::pixmap_kernels &kernels, pixmap_format from) {
+        switch (from) {
+            case pixmap_format::r8:
+                return kernels.r8_to_rgba8;
+            case pixmap_format::rgb8:
+                return kernels.rgb8_to_rgba8;
+            case pixmap_format::rgb565:
+                return kernels.rgb565_to_rgba8;
+            case pixmap_format::rgba4444:
+                return kernels.rgba4444_to_rgba8;
+            case pixmap_format::rgba5551:
+                return kernels.rgba5551_to_rgba8;
+            case pixmap_format::la8:
+                return la8_to_rgba8;
+            default:
+                throw assertion_error("No conversion kernel from pixmap format "s
+                                      + std::to_string(static_cast<std::underlying_type_t<pixmap_format>>(from))
+                                      + " to rgba8"s);
+        }
+    }
+
+    /// Selects the row kernel converting from rgba8 to a format.
+    row_kernel get_rgba8_encoder(const detail::pixmap_kernels &kernels, pixmap_format to) {
+        switch (to) {
+            case pixmap_format::r8:
+                return kernels.rgba8_to_r8;
+            case pixmap_format::rgb8:
+                return kernels.rgba8_to_rgb8;
+            case pixmap_format::rgb565:
+                return kernels.rgba8_to_rgb565;
+            case pixmap_format::rgba4444:
+                return kernels.rgba8_to_rgba4444;
+            case pixmap_format::rgba5551:
+                return kernels.rgba8_to_rgba5551;
+            case pixmap_format::la8:
+                return rgba8_to_la8;
+            default:
+                throw assertion_error("No conversion kernel from rgba8 to pixmap format "s
+                                      + std::to_string(static_cast<std::underlying_type_t<pixmap_format>>(to)));
+        }
+    }
+
+    /// Converts rows between two distinct formats; conversions without a direct kernel go through rgba8.
+    class row_converter final {
+    public:
+        row_converter(pixmap_format from, pixmap_format to, uint32 width) {
+            const auto &kernels = detail::get_pixmap_kernels();
+            if (from == pixmap_format::r8 && to == pixmap_format::rgb8) {
+                direct = r8_to_rgb8;
+            } else if (from == pixmap_format::rgb8 && to == pixmap_format::r8) {
+                direct = rgb8_to_r8;
+            } else if (to == pixmap_format::rgba8) {
+                direct = get_rgba8_decoder(kernels, from);
+            } else if (from == pixmap_format::rgba8) {
+                direct = get_rgba8_encoder(kernels, to);
+            } else {
+                decode = get_rgba8_decoder(kernels, from);
+                encode = get_rgba8_encoder(kernels, to);
+                scratch.resize(width * 4u);
+            }
+        }
+
+        void operator()(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+            if (direct) {
+                direct(dst, src, count);
+            } else {
+                decode(scratch.data(), src, count);
+                encode(dst, scratch.data(), count);
+            }
+        }
+
+    private:
+        row_kernel direct{nullptr}, decode{nullptr}, encode{nullptr};
+        std::vector<std::uint8_t> scratch{};
+    };
+}
+
 namespace musubi {
     pixmap::~pixmap() = default;
+
+    std::size_t pixmap::get_stride() const { return get_width() * get_bytes_per_pixel(get_format()); }
+
+    namespace detail {
+        void fill_pixels(byte *dst, std::size_t stride, pixmap_format format,
+                         uint32 width, uint32 height, const byte *pixel) {
+            if (width == 0 || height == 0) return;
+            const auto bytesPerPixel = get_bytes_per_pixel(format);
+            const auto rowSize = width * bytesPerPixel;
+
+            // Fill the first row, then replicate it
+            switch (format) {
+                case pixmap_format::r8:
+                    std::memset(dst, std::to_integer<int>(pixel[0]), rowSize);
+                    break;
+                case pixmap_format::rgba8: {
+                    std::uint32_t value;
+                    std::memcpy(&value, pixel, sizeof(value));
+                    get_pixmap_kernels().fill_rgba8(as_bytes(dst), value, width);
+                    break;
+                }
+                default:
+                    for (uint32 x = 0; x < width; ++x) std::memcpy(dst + x * bytesPerPixel, pixel, bytesPerPixel);
+                    break;
+            }
+            for (uint32 y = 1; y < height; ++y) std::memcpy(dst + y * stride, dst, rowSize);
+        }
+
+        void copy_pixels(byte *dst, std::size_t stride, pixmap_format format,
+                         const pixmap_view &source, blend_mode mode) {
+            const auto width = source.get_width(), height = source.get_height();
+            const auto &kernels = get_pixmap_kernels();
+
+            if (mode == blend_mode::source_over) {
+                if (format != pixmap_format::rgba8 || source.get_format() != pixmap_format::rgba8) {
+                    throw std::invalid_argument("Source-over blending requires rgba8 source and destination pixmaps");
+                }
+                // An unallocated source is fully transparent
+                if (!source.data()) return;
+                for (uint32 y = 0; y < height; ++y) {
+                    kernels.blend_rgba8(as_bytes(dst + y * stride), as_bytes(source.row_data(y)), width);
+                }
+                return;
+            }
+
+            if (!source.data()) {
+                // An unallocated source is all zeroes in its own format
+                const std::uint8_t zero[4]{0u, 0u, 0u, 0u};
+                std::uint8_t pixel[4]{0u, 0u, 0u, 0u};
+                if (source.get_format() != format) row_converter(source.get_format(), format, 1)(pixel, zero, 1);
+                fill_pixels(dst, stride, format, width, height, reinterpret_cast<const byte *>(pixel));
+                return;
+            }
+
+            if (source.get_format() == format) {
+                const auto rowSize = width * get_bytes_per_pixel(format);
+                for (uint32 y = 0; y < height; ++y) std::memcpy(dst + y * stride, source.row_data(y), rowSize);
+                return;
+            }
+
+            row_converter convert(source.get_format(), format, width);
+            for (uint32 y = 0; y < height; ++y) {
+                convert(as_bytes(dst + y * stride), as_bytes(source.row_data(y)), width);
+            }
+        }
+
+        void parallel_rows(thread_pool &pool, uint32 rows,
+                           const std::function<void(std::size_t, std::size_t)> &visitRows) {
+            pool.parallel_for(rows, visitRows);
+        }
+    }
 }
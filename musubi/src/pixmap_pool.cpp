@@ -0,0 +1,132 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#include <musubi/pixmap_pool.h>
+
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace musubi::detail {
+    struct pixmap_pool_state {
+        std::mutex mutex{};
+        std::size_t maxCachedBytes;
+        /// Whether the owning pool has been destroyed; buffers are then freed on release.
+        bool closed{false};
+        /// Cached buffers, keyed by size class and alignment.
+        std::map<std::pair<std::size_t, std::size_t>, std::vector<byte *>> cache{};
+        pixmap_pool_stats stats{};
+
+        explicit pixmap_pool_state(std::size_t maxCachedBytes) noexcept : maxCachedBytes(maxCachedBytes) {}
+
+        ~pixmap_pool_state() { clear(); }
+
+        /// Frees all cached buffers; the mutex must be held (or the state be otherwise unshared).
+        void clear() noexcept {
+            for (auto &[key, buffers] : cache) {
+                for (const auto buffer : buffers) free_pixmap_buffer(buffer, key.second);
+            }
+            cache.clear();
+            stats.cachedBuffers = 0;
+            stats.cachedBytes = 0;
+        }
+    };
+
+    void release_pooled_buffer(pixmap_pool_state &pool, byte *buffer,
+                               std::size_t capacity, std::size_t alignment) noexcept {
+        std::unique_lock lock(pool.mutex);
+        ++pool.stats.releases;
+        --pool.stats.outstandingBuffers;
+        pool.stats.outstandingBytes -= capacity;
+
+        if (!pool.closed && pool.stats.cachedBytes + capacity <= pool.maxCachedBytes) {
+            try {
+                pool.cache[{capacity, alignment}].push_back(buffer);
+                ++pool.stats.cachedBuffers;
+                pool.stats.cachedBytes += capacity;
+                return;
+            } catch (...) {
+                // Could not grow the free list; fall through and free the buffer instead
+            }
+        }
+        ++pool.stats.evictions;
+        lock.unlock();
+        free_pixmap_buffer(buffer, alignment);
+    }
+
+    pixmap_buffer_ptr allocate_pooled_buffer(const std::shared_ptr<pixmap_pool_state> &pool,
+                                             std::size_t size, std::size_t alignment) {
+        const auto capacity = pixmap_pool::get_size_class(size);
+        byte *buffer = nullptr;
+        {
+            std::lock_guard lock(pool->mutex);
+            const auto entry = pool->cache.find({capacity, alignment});
+            if (entry != pool->cache.end() && !entry->second.empty()) {
+                buffer = entry->second.back();
+                entry->second.pop_back();
+                --pool->stats.cachedBuffers;
+                pool->stats.cachedBytes -= capacity;
+                ++pool->stats.reuses;
+            } else {
+                ++pool->stats.allocations;
+            }
+            ++pool->stats.outstandingBuffers;
+            pool->stats.outstandingBytes += capacity;
+        }
+
+        if (buffer) {
+            std::memset(buffer, 0, size);
+        } else {
+            try {
+                buffer = allocate_pixmap_buffer(capacity, alignment).release();
+            } catch (...) {
+                std::lock_guard lock(pool->mutex);
+                --pool->stats.outstandingBuffers;
+                pool->stats.outstandingBytes -= capacity;
+                throw;
+            }
+        }
+        return pixmap_buffer_ptr(buffer, {alignment, pool, capacity});
+    }
+}
+
+namespace musubi {
+    pixmap_pool::pixmap_pool(std::size_t maxCachedBytes)
+            : state(std::make_shared<detail::pixmap_pool_state>(maxCachedBytes)) {}
+
+    pixmap_pool::~pixmap_pool() noexcept {
+        std::lock_guard lock(state->mutex);
+        state->closed = true;
+        state->clear();
+    }
+
+    pixmap_pool_stats pixmap_pool::get_stats() const {
+        std::lock_guard lock(state->mutex);
+        return state->stats;
+    }
+
+    void pixmap_pool::reset_stats() {
+        std::lock_guard lock(state->mutex);
+        state->stats.allocations = 0;
+        state->stats.reuses = 0;
+        state->stats.releases = 0;
+        state->stats.evictions = 0;
+    }
+
+    void pixmap_pool::trim() {
+        std::lock_guard lock(state->mutex);
+        state->clear();
+    }
+
+    std::size_t pixmap_pool::get_size_class(std::size_t size) noexcept {
+        if (size <= MIN_SIZE_CLASS) return MIN_SIZE_CLASS;
+        // Four classes per power of two: each is at most 25% larger than any size it serves
+        std::size_t power = MIN_SIZE_CLASS;
+        while (power < size) power <<= 1u;
+        const auto step = power / 8u;
+        return detail::align_up(size, step);
+    }
+}
@@ -0,0 +1,80 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#include <musubi/sdl/sdl_error.h>
+#include <musubi/sdl/sdl_gl_loader.h>
+
+#include <musubi/common.h>
+
+#include <string>
+#include <utility>
+
+namespace {
+    using namespace std::literals;
+
+    /// Creates a context shared with the specified context, then makes the specified context current again.
+    SDL_GLContext create_shared_context(SDL_Window *window, SDL_GLContext shareWith) {
+        SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 1);
+        const auto context = SDL_GL_CreateContext(window);
+        SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 0);
+        if (context == nullptr) throw musubi::sdl::sdl_error("Could not create GL loader context: "s + SDL_GetError());
+
+        // Creating a context makes it current; hand it over to the upload thread instead
+        SDL_GL_MakeCurrent(window, shareWith);
+        return context;
+    }
+}
+
+namespace musubi::sdl {
+    using namespace musubi::detail;
+
+    sdl_gl_loader::sdl_gl_loader(SDL_Window *window, SDL_GLContext shareWith)
+            : window(window), context(create_shared_context(window, shareWith)), uploader(1) {
+        try {
+            uploader.submit([window, context = context]() {
+                if (SDL_GL_MakeCurrent(window, context) != 0) {
+                    throw sdl_error("Could not make GL loader context current: "s + SDL_GetError());
+                }
+            }).get();
+        } catch (...) {
+            SDL_GL_DeleteContext(context);
+            throw;
+        }
+        log_i("sdl_gl_loader") << "Created shared GL loader context\n";
+    }
+
+    sdl_gl_loader::~sdl_gl_loader() noexcept {
+        try {
+            // The context must not be current on the upload thread when it is deleted
+            uploader.submit([window = window]() { SDL_GL_MakeCurrent(window, nullptr); }).wait();
+        } catch (...) {
+            log_e("sdl_gl_loader") << "Could not release GL loader context\n";
+        }
+        SDL_GL_DeleteContext(context);
+    }
+
+    std::future<std::shared_ptr<gl::texture>> sdl_gl_loader::load_texture(std::shared_ptr<const pixmap> source,
+                                                                           bool shouldFlip, GLenum internalFormat) {
+        if (!source) throw std::invalid_argument("Cannot load texture; source pixmap pointer is empty");
+        return submit([source = std::move(source), shouldFlip, internalFormat]() {
+            return std::make_shared<gl::texture>(*source, shouldFlip, internalFormat);
+        });
+    }
+
+    std::future<std::shared_ptr<gl::shader_program>> sdl_gl_loader::link_program(std::string vertexSource,
+                                                                                  std::string fragmentSource) {
+        return submit([vertexSource = std::move(vertexSource), fragmentSource = std::move(fragmentSource)]() {
+            return std::make_shared<gl::shader_program>(vertexSource, fragmentSource);
+        });
+    }
+
+    void sdl_gl_loader::await_completion() {
+        const auto fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        // Flush once, then keep waiting until the fence has been signaled
+        auto status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000'000u);
+        while (status == GL_TIMEOUT_EXPIRED) status = glClientWaitSync(fence, 0, 1'000'000'000u);
+        glDeleteSync(fence);
+        if (status == GL_WAIT_FAILED) log_w("sdl_gl_loader") << "Failed to wait for upload fence\n";
+    }
+}
@@ -80,11 +80,13 @@ namespace musubi::sdl {
 
     sdl_window::sdl_window(sdl_window &&other) noexcept
             : wrapped(std::exchange(other.wrapped, nullptr)),
-              context(std::exchange(other.context, nullptr)) {}
+              context(std::exchange(other.context, nullptr)),
+              loader(std::move(other.loader)) {}
 
     sdl_window &sdl_window::operator=(sdl_window &&other) noexcept {
         wrapped = std::exchange(other.wrapped, nullptr);
         context = std::exchange(other.context, nullptr);
+        loader = std::move(other.loader);
         return *this;
     }
 
@@ -92,6 +94,9 @@ namespace musubi::sdl {
         if (currentScreen) currentScreen->on_detached(this);
         currentScreen.reset();
 
+        // The loader context shares objects with this window's context; release it first
+        loader.reset();
+
         if (wrapped) {
             SDL_GL_DeleteContext(context);
             SDL_DestroyWindow(wrapped);
@@ -111,6 +116,10 @@ namespace musubi::sdl {
         const auto now = clock_type::now();
         const auto dt = std::chrono::duration_cast<delta_type>(now - lastTime).count();
         lastTime = now;
+        if (!taskQueue.empty()) {
+            make_current();
+            taskQueue.run(taskBudget);
+        }
         if (currentScreen) {
             make_current();
             // Extend this screen's lifetime in case on_update sets another screen
@@ -122,6 +131,20 @@ namespace musubi::sdl {
 
     sdl_window::id_type sdl_window::get_id() const { return SDL_GetWindowID(wrapped); }
 
+    frame_task_queue &sdl_window::get_task_queue() { return taskQueue; }
+
+    void sdl_window::set_task_budget(frame_task_queue::clock_type::duration budget) noexcept { taskBudget = budget; }
+
+    sdl_gl_loader &sdl_window::enable_loader() {
+        if (!loader) {
+            make_current();
+            loader = std::make_unique<sdl_gl_loader>(wrapped, context);
+        }
+        return *loader;
+    }
+
+    sdl_gl_loader *sdl_window::get_loader() const noexcept { return loader.get(); }
+
     void sdl_window::make_current() const {
         SDL_GL_MakeCurrent(wrapped, context);
     }
@@ -0,0 +1,172 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#include "simd/pixmap_kernels.h"
+
+#include <cstring>
+
+namespace musubi::detail {
+    namespace scalar {
+        void fill_rgba8(std::uint8_t *dst, std::uint32_t pixel, std::size_t count) {
+            for (std::size_t i = 0; i < count; ++i) std::memcpy(dst + i * 4, &pixel, 4);
+        }
+
+        void blend_rgba8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+            for (std::size_t i = 0; i < count; ++i, src += 4, dst += 4) {
+                const std::uint32_t alpha = src[3];
+                if (alpha == 0) continue;
+                const std::uint32_t inverse = 255u - alpha;
+
+                // Porter-Duff over on non-premultiplied colors: the destination is weighted by its own alpha,
+                // and the sum is divided by the resulting alpha. All terms are scaled by 255 * 255.
+                const std::uint32_t dstWeight = dst[3] * inverse;
+                const std::uint32_t outAlpha = 255u * alpha + dstWeight;
+                const std::uint32_t half = outAlpha / 2;
+                dst[0] = static_cast<std::uint8_t>((255u * src[0] * alpha + dst[0] * dstWeight + half) / outAlpha);
+                dst[1] = static_cast<std::uint8_t>((255u * src[1] * alpha + dst[1] * dstWeight + half) / outAlpha);
+                dst[2] = static_cast<std::uint8_t>((255u * src[2] * alpha + dst[2] * dstWeight + half) / outAlpha);
+                dst[3] = static_cast<std::uint8_t>(div255(outAlpha));
+            }
+        }
+
+        void rgb8_to_rgba8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+            for (std::size_t i = 0; i < count; ++i, src += 3, dst += 4) {
+                dst[0] = src[0];
+                dst[1] = src[1];
+                dst[2] = src[2];
+                dst[3] = 255u;
+            }
+        }
+
+        void rgba8_to_rgb8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+            for (std::size_t i = 0; i < count; ++i, src += 4, dst += 3) {
+                dst[0] = src[0];
+                dst[1] = src[1];
+                dst[2] = src[2];
+            }
+        }
+
+        void r8_to_rgba8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+            for (std::size_t i = 0; i < count; ++i, dst += 4) {
+                dst[0] = src[i];
+                dst[1] = 0u;
+                dst[2] = 0u;
+                dst[3] = 255u;
+            }
+        }
+
+        void rgba8_to_r8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+            for (std::size_t i = 0; i < count; ++i) dst[i] = src[i * 4];
+        }
+
+        void downscale_box_rgba8(std::uint8_t *dst, const std::uint8_t *row0, const std::uint8_t *row1,
+                                 std::size_t count) {
+            for (std::size_t i = 0; i < count * 4; ++i) {
+                const auto c = (i / 4) * 8 + i % 4;
+                dst[i] = static_cast<std::uint8_t>((row0[c] + row0[c + 4] + row1[c] + row1[c + 4] + 2u) >> 2u);
+            }
+        }
+
+        template<typename Pack>
+        inline void pack_rgba8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count, Pack pack) {
+            for (std::size_t i = 0; i < count; ++i, src += 4, dst += 2) {
+                const auto value = static_cast<std::uint16_t>(pack(src[0], src[1], src[2], src[3]));
+                std::memcpy(dst, &value, sizeof(value));
+            }
+        }
+
+        template<typename Unpack>
+        inline void unpack_rgba8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count, Unpack unpack) {
+            for (std::size_t i = 0; i < count; ++i, src += 2, dst += 4) {
+                std::uint16_t value;
+                std::memcpy(&value, src, sizeof(value));
+                unpack(value, dst);
+            }
+        }
+
+        /// Expands a component of the specified bit depth to 8 bits by replicating its high bits.
+        template<unsigned bits>
+        constexpr std::uint8_t expand(std::uint32_t value) noexcept {
+            return static_cast<std::uint8_t>((value << (8u - bits)) | (value >> (2u * bits - 8u)));
+        }
+
+        void rgba8_to_rgb565(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+            pack_rgba8(dst, src, count, [](std::uint32_t r, std::uint32_t g, std::uint32_t b, std::uint32_t) {
+                return ((r & 0xF8u) << 8u) | ((g & 0xFCu) << 3u) | (b >> 3u);
+            });
+        }
+
+        void rgb565_to_rgba8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+            unpack_rgba8(dst, src, count, [](std::uint32_t value, std::uint8_t *out) {
+                out[0] = expand<5>(value >> 11u);
+                out[1] = expand<6>((value >> 5u) & 0x3Fu);
+                out[2] = expand<5>(value & 0x1Fu);
+                out[3] = 255u;
+            });
+        }
+
+        void rgba8_to_rgba4444(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+            pack_rgba8(dst, src, count, [](std::uint32_t r, std::uint32_t g, std::uint32_t b, std::uint32_t a) {
+                return ((r & 0xF0u) << 8u) | ((g & 0xF0u) << 4u) | (b & 0xF0u) | (a >> 4u);
+            });
+        }
+
+        void rgba4444_to_rgba8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+            unpack_rgba8(dst, src, count, [](std::uint32_t value, std::uint8_t *out) {
+                out[0] = static_cast<std::uint8_t>((value >> 12u) * 17u);
+                out[1] = static_cast<std::uint8_t>(((value >> 8u) & 0xFu) * 17u);
+                out[2] = static_cast<std::uint8_t>(((value >> 4u) & 0xFu) * 17u);
+                out[3] = static_cast<std::uint8_t>((value & 0xFu) * 17u);
+            });
+        }
+
+        void rgba8_to_rgba5551(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+            pack_rgba8(dst, src, count, [](std::uint32_t r, std::uint32_t g, std::uint32_t b, std::uint32_t a) {
+                return ((r & 0xF8u) << 8u) | ((g & 0xF8u) << 3u) | ((b & 0xF8u) >> 2u) | (a >> 7u);
+            });
+        }
+
+        void rgba5551_to_rgba8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+            unpack_rgba8(dst, src, count, [](std::uint32_t value, std::uint8_t *out) {
+                out[0] = expand<5>(value >> 11u);
+                out[1] = expand<5>((value >> 6u) & 0x1Fu);
+                out[2] = expand<5>((value >> 1u) & 0x1Fu);
+                out[3] = (value & 1u) ? 255u : 0u;
+            });
+        }
+    }
+
+    const pixmap_kernels scalar_pixmap_kernels{
+            scalar::fill_rgba8,
+            scalar::blend_rgba8,
+            scalar::rgb8_to_rgba8,
+            scalar::rgba8_to_rgb8,
+            scalar::r8_to_rgba8,
+            scalar::rgba8_to_r8,
+            scalar::rgba8_to_rgb565,
+            scalar::rgb565_to_rgba8,
+            scalar::rgba8_to_rgba4444,
+            scalar::rgba4444_to_rgba8,
+            scalar::rgba8_to_rgba5551,
+            scalar::rgba5551_to_rgba8,
+            scalar::downscale_box_rgba8
+    };
+
+    const pixmap_kernels &get_pixmap_kernels() noexcept {
+        switch (get_simd_level()) {
+#if defined(LIBMUSUBI_SIMD_X86)
+            case simd_level::sse2:
+                return sse2_pixmap_kernels;
+            case simd_level::avx2:
+                return avx2_pixmap_kernels;
+#endif
+#if defined(LIBMUSUBI_SIMD_NEON)
+            case simd_level::neon:
+                return neon_pixmap_kernels;
+#endif
+            default:
+                return scalar_pixmap_kernels;
+        }
+    }
+}
@@ -0,0 +1,120 @@
+/// @file
+/// Row kernels for bulk pixmap operations, implemented once per @ref musubi::simd_level.
+/// @author agent
+/// @date 19 October 2026
+
+#ifndef MUSUBI_SIMD_PIXMAP_KERNELS_H
+#define MUSUBI_SIMD_PIXMAP_KERNELS_H
+
+#include <musubi/simd.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace musubi::detail {
+    /// A table of row kernels. Every kernel processes `count` pixels of a single row;
+    /// rgba8 pixels are stored as R, G, B, A bytes.
+    struct pixmap_kernels {
+        /// Fills a row of rgba8 pixels with a pixel, given as its 4 bytes in memory order.
+        void (*fill_rgba8)(std::uint8_t *dst, std::uint32_t pixel, std::size_t count);
+
+        /// Blends a row of non-premultiplied rgba8 pixels onto another (source-over).
+        /// Vectorized kernels only handle runs of opaque destination pixels, where no division is needed,
+        /// and defer to the scalar kernel otherwise.
+        void (*blend_rgba8)(std::uint8_t *dst, const std::uint8_t *src, std::size_t count);
+
+        void (*rgb8_to_rgba8)(std::uint8_t *dst, const std::uint8_t *src, std::size_t count);
+
+        void (*rgba8_to_rgb8)(std::uint8_t *dst, const std::uint8_t *src, std::size_t count);
+
+        void (*r8_to_rgba8)(std::uint8_t *dst, const std::uint8_t *src, std::size_t count);
+
+        void (*rgba8_to_r8)(std::uint8_t *dst, const std::uint8_t *src, std::size_t count);
+
+        // Packed formats are native-endian 16-bit integers; packing truncates, unpacking replicates high bits
+        void (*rgba8_to_rgb565)(std::uint8_t *dst, const std::uint8_t *src, std::size_t count);
+
+        void (*rgb565_to_rgba8)(std::uint8_t *dst, const std::uint8_t *src, std::size_t count);
+
+        void (*rgba8_to_rgba4444)(std::uint8_t *dst, const std::uint8_t *src, std::size_t count);
+
+        void (*rgba4444_to_rgba8)(std::uint8_t *dst, const std::uint8_t *src, std::size_t count);
+
+        void (*rgba8_to_rgba5551)(std::uint8_t *dst, const std::uint8_t *src, std::size_t count);
+
+        void (*rgba5551_to_rgba8)(std::uint8_t *dst, const std::uint8_t *src, std::size_t count);
+
+        /// Averages 2x2 blocks of rgba8 pixels from two source rows, producing `count` pixels;
+        /// each source row must contain at least `2 * count` pixels.
+        void (*downscale_box_rgba8)(std::uint8_t *dst, const std::uint8_t *row0, const std::uint8_t *row1,
+                                    std::size_t count);
+    };
+
+    /// Divides a value in [0, 255 * 255] by 255, rounding to nearest; this is exact for all 16-bit SIMD lanes.
+    constexpr std::uint32_t div255(std::uint32_t value) noexcept {
+        value += 128u;
+        return (value + (value >> 8u)) >> 8u;
+    }
+
+    namespace scalar {
+        void fill_rgba8(std::uint8_t *dst, std::uint32_t pixel, std::size_t count);
+
+        void blend_rgba8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count);
+
+        void rgb8_to_rgba8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count);
+
+        void rgba8_to_rgb8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count);
+
+        void r8_to_rgba8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count);
+
+        void rgba8_to_r8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count);
+
+        void downscale_box_rgba8(std::uint8_t *dst, const std::uint8_t *row0, const std::uint8_t *row1,
+                                 std::size_t count);
+
+        void rgba8_to_rgb565(std::uint8_t *dst, const std::uint8_t *src, std::size_t count);
+
+        void rgb565_to_rgba8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count);
+
+        void rgba8_to_rgba4444(std::uint8_t *dst, const std::uint8_t *src, std::size_t count);
+
+        void rgba4444_to_rgba8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count);
+
+        void rgba8_to_rgba5551(std::uint8_t *dst, const std::uint8_t *src, std::size_t count);
+
+        void rgba5551_to_rgba8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count);
+    }
+
+#if defined(LIBMUSUBI_SIMD_X86)
+    namespace sse2 {
+        void downscale_box_rgba8(std::uint8_t *dst, const std::uint8_t *row0, const std::uint8_t *row1,
+                                 std::size_t count);
+
+        void rgba8_to_rgb565(std::uint8_t *dst, const std::uint8_t *src, std::size_t count);
+
+        void rgb565_to_rgba8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count);
+
+        void rgba8_to_rgba4444(std::uint8_t *dst, const std::uint8_t *src, std::size_t count);
+
+        void rgba4444_to_rgba8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count);
+
+        void rgba8_to_rgba5551(std::uint8_t *dst, const std::uint8_t *src, std::size_t count);
+
+        void rgba5551_to_rgba8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count);
+    }
+#endif
+
+    extern const pixmap_kernels scalar_pixmap_kernels;
+#if defined(LIBMUSUBI_SIMD_X86)
+    extern const pixmap_kernels sse2_pixmap_kernels;
+    extern const pixmap_kernels avx2_pixmap_kernels;
+#endif
+#if defined(LIBMUSUBI_SIMD_NEON)
+    extern const pixmap_kernels neon_pixmap_kernels;
+#endif
+
+    /// Retrieves the kernel table for the active @ref musubi::simd_level.
+    const pixmap_kernels &get_pixmap_kernels() noexcept;
+}
+
+#endif //MUSUBI_SIMD_PIXMAP_KERNELS_H
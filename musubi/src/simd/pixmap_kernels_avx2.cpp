@@ -0,0 +1,131 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+// This file is compiled with AVX2 code generation enabled;
+// its kernels must only be dispatched after checking for AVX2 support.
+
+#include "simd/pixmap_kernels.h"
+
+#include <immintrin.h>
+#include <cstring>
+
+namespace {
+    using namespace musubi::detail;
+
+    void fill_rgba8(std::uint8_t *dst, std::uint32_t pixel, std::size_t count) {
+        const auto value = _mm256_set1_epi32(static_cast<int>(pixel));
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i * 4), value);
+        scalar::fill_rgba8(dst + i * 4, pixel, count - i);
+    }
+
+    /// Blends four pixels onto opaque destination pixels, unpacked to 16-bit lanes. See the SSE2 kernel for details.
+    inline __m256i blend_16(__m256i src, __m256i dst) {
+        const auto rgbMask = _mm256_set_epi16(0, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1);
+        const auto opaqueAlpha = _mm256_set_epi16(255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0);
+        const auto max = _mm256_set1_epi16(255);
+        const auto half = _mm256_set1_epi16(128);
+
+        auto alpha = _mm256_shufflelo_epi16(src, _MM_SHUFFLE(3, 3, 3, 3));
+        alpha = _mm256_shufflehi_epi16(alpha, _MM_SHUFFLE(3, 3, 3, 3));
+        const auto inverse = _mm256_sub_epi16(max, alpha);
+
+        src = _mm256_or_si256(_mm256_and_si256(src, rgbMask), opaqueAlpha);
+
+        auto value = _mm256_add_epi16(_mm256_mullo_epi16(src, alpha), _mm256_mullo_epi16(dst, inverse));
+        value = _mm256_add_epi16(value, half);
+        return _mm256_srli_epi16(_mm256_add_epi16(value, _mm256_srli_epi16(value, 8)), 8);
+    }
+
+    void blend_rgba8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+        const auto zero = _mm256_setzero_si256();
+        const auto rgbBytes = _mm256_set1_epi32(0x00FFFFFF);
+        const auto ones = _mm256_set1_epi32(-1);
+        std::size_t i = 0;
+        // Unpacking and packing both operate within 128-bit lanes, so pixel order is preserved
+        for (; i + 8 <= count; i += 8) {
+            const auto s = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i * 4));
+            const auto d = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i * 4));
+            if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_or_si256(d, rgbBytes), ones)) != -1) {
+                scalar::blend_rgba8(dst + i * 4, src + i * 4, 8);
+                continue;
+            }
+            const auto low = blend_16(_mm256_unpacklo_epi8(s, zero), _mm256_unpacklo_epi8(d, zero));
+            const auto high = blend_16(_mm256_unpackhi_epi8(s, zero), _mm256_unpackhi_epi8(d, zero));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i * 4), _mm256_packus_epi16(low, high));
+        }
+        scalar::blend_rgba8(dst + i * 4, src + i * 4, count - i);
+    }
+
+    void rgb8_to_rgba8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+        const auto shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+        const auto alpha = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+        std::size_t i = 0;
+        // Each iteration loads 16 bytes but consumes 12; stop while 6 pixels (18 bytes) remain readable
+        for (; i + 6 <= count; i += 4) {
+            const auto in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 3));
+            const auto out = _mm_or_si128(_mm_shuffle_epi8(in, shuffle), alpha);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4), out);
+        }
+        scalar::rgb8_to_rgba8(dst + i * 4, src + i * 3, count - i);
+    }
+
+    void rgba8_to_rgb8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+        const auto shuffle = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const auto in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 4));
+            const auto out = _mm_shuffle_epi8(in, shuffle);
+            // Store exactly 12 bytes
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(dst + i * 3), out);
+            const auto tail = _mm_extract_epi32(out, 2);
+            std::memcpy(dst + i * 3 + 8, &tail, 4);
+        }
+        scalar::rgba8_to_rgb8(dst + i * 3, src + i * 4, count - i);
+    }
+
+    void r8_to_rgba8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+        const auto alpha = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const auto r = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + i));
+            const auto out = _mm256_or_si256(_mm256_cvtepu8_epi32(r), alpha);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i * 4), out);
+        }
+        scalar::r8_to_rgba8(dst + i * 4, src + i, count - i);
+    }
+
+    void rgba8_to_r8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+        const auto shuffle = _mm_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+        std::size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            const auto in = reinterpret_cast<const __m128i *>(src + i * 4);
+            const auto a = _mm_shuffle_epi8(_mm_loadu_si128(in + 0), shuffle);
+            const auto b = _mm_shuffle_epi8(_mm_loadu_si128(in + 1), shuffle);
+            const auto c = _mm_shuffle_epi8(_mm_loadu_si128(in + 2), shuffle);
+            const auto d = _mm_shuffle_epi8(_mm_loadu_si128(in + 3), shuffle);
+            const auto packed = _mm_unpacklo_epi64(_mm_unpacklo_epi32(a, b), _mm_unpacklo_epi32(c, d));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), packed);
+        }
+        scalar::rgba8_to_r8(dst + i, src + i * 4, count - i);
+    }
+}
+
+namespace musubi::detail {
+    const pixmap_kernels avx2_pixmap_kernels{
+            fill_rgba8,
+            blend_rgba8,
+            rgb8_to_rgba8,
+            rgba8_to_rgb8,
+            r8_to_rgba8,
+            rgba8_to_r8,
+            sse2::rgba8_to_rgb565,
+            sse2::rgb565_to_rgba8,
+            sse2::rgba8_to_rgba4444,
+            sse2::rgba4444_to_rgba8,
+            sse2::rgba8_to_rgba5551,
+            sse2::rgba5551_to_rgba8,
+            sse2::downscale_box_rgba8
+    };
+}
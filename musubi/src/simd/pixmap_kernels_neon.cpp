@@ -0,0 +1,210 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#include "simd/pixmap_kernels.h"
+
+#include <arm_neon.h>
+
+namespace {
+    using namespace musubi::detail;
+
+    void fill_rgba8(std::uint8_t *dst, std::uint32_t pixel, std::size_t count) {
+        const auto value = vreinterpretq_u8_u32(vdupq_n_u32(pixel));
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4) vst1q_u8(dst + i * 4, value);
+        scalar::fill_rgba8(dst + i * 4, pixel, count - i);
+    }
+
+    /// Computes div255(a * alpha + b * inverse) for eight components.
+    inline uint8x8_t blend_8(uint8x8_t a, uint8x8_t b, uint8x8_t alpha, uint8x8_t inverse) {
+        const auto value = vmlal_u8(vmull_u8(a, alpha), b, inverse);
+        // (v + 128 + ((v + 128) >> 8)) >> 8
+        const auto rounded = vaddq_u16(value, vdupq_n_u16(128));
+        return vshrn_n_u16(vaddq_u16(rounded, vshrq_n_u16(rounded, 8)), 8);
+    }
+
+    void blend_rgba8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+        const auto opaque = vdup_n_u8(255);
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const auto s = vld4_u8(src + i * 4);
+            auto d = vld4_u8(dst + i * 4);
+            if (vget_lane_u64(vreinterpret_u64_u8(d.val[3]), 0) != ~std::uint64_t{0}) {
+                // Translucent destination pixels need a division by the resulting alpha
+                scalar::blend_rgba8(dst + i * 4, src + i * 4, 8);
+                continue;
+            }
+            const auto alpha = s.val[3];
+            const auto inverse = vsub_u8(opaque, alpha);
+            d.val[0] = blend_8(s.val[0], d.val[0], alpha, inverse);
+            d.val[1] = blend_8(s.val[1], d.val[1], alpha, inverse);
+            d.val[2] = blend_8(s.val[2], d.val[2], alpha, inverse);
+            d.val[3] = blend_8(opaque, d.val[3], alpha, inverse);
+            vst4_u8(dst + i * 4, d);
+        }
+        scalar::blend_rgba8(dst + i * 4, src + i * 4, count - i);
+    }
+
+    void rgb8_to_rgba8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+        std::size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            const auto rgb = vld3q_u8(src + i * 3);
+            const uint8x16x4_t rgba{{rgb.val[0], rgb.val[1], rgb.val[2], vdupq_n_u8(255)}};
+            vst4q_u8(dst + i * 4, rgba);
+        }
+        scalar::rgb8_to_rgba8(dst + i * 4, src + i * 3, count - i);
+    }
+
+    void rgba8_to_rgb8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+        std::size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            const auto rgba = vld4q_u8(src + i * 4);
+            const uint8x16x3_t rgb{{rgba.val[0], rgba.val[1], rgba.val[2]}};
+            vst3q_u8(dst + i * 3, rgb);
+        }
+        scalar::rgba8_to_rgb8(dst + i * 3, src + i * 4, count - i);
+    }
+
+    void r8_to_rgba8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+        const auto zero = vdupq_n_u8(0);
+        std::size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            const uint8x16x4_t rgba{{vld1q_u8(src + i), zero, zero, vdupq_n_u8(255)}};
+            vst4q_u8(dst + i * 4, rgba);
+        }
+        scalar::r8_to_rgba8(dst + i * 4, src + i, count - i);
+    }
+
+    void rgba8_to_r8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+        std::size_t i = 0;
+        for (; i + 16 <= count; i += 16) vst1q_u8(dst + i, vld4q_u8(src + i * 4).val[0]);
+        scalar::rgba8_to_r8(dst + i, src + i * 4, count - i);
+    }
+
+    /// Replicates the high bits of 5-bit values to form 8-bit values.
+    inline uint8x8_t expand5(uint16x8_t value) {
+        return vmovn_u16(vorrq_u16(vshlq_n_u16(value, 3), vshrq_n_u16(value, 2)));
+    }
+
+    void rgba8_to_rgb565(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const auto rgba = vld4_u8(src + i * 4);
+            const auto r = vshll_n_u8(vand_u8(rgba.val[0], vdup_n_u8(0xF8)), 8);
+            const auto g = vshlq_n_u16(vmovl_u8(vand_u8(rgba.val[1], vdup_n_u8(0xFC))), 3);
+            const auto b = vmovl_u8(vshr_n_u8(rgba.val[2], 3));
+            vst1q_u16(reinterpret_cast<std::uint16_t *>(dst + i * 2), vorrq_u16(vorrq_u16(r, g), b));
+        }
+        scalar::rgba8_to_rgb565(dst + i * 2, src + i * 4, count - i);
+    }
+
+    void rgb565_to_rgba8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const auto p = vld1q_u16(reinterpret_cast<const std::uint16_t *>(src + i * 2));
+            const auto g6 = vandq_u16(vshrq_n_u16(p, 5), vdupq_n_u16(0x3F));
+            const uint8x8x4_t rgba{{
+                    expand5(vshrq_n_u16(p, 11)),
+                    vmovn_u16(vorrq_u16(vshlq_n_u16(g6, 2), vshrq_n_u16(g6, 4))),
+                    expand5(vandq_u16(p, vdupq_n_u16(0x1F))),
+                    vdup_n_u8(255)
+            }};
+            vst4_u8(dst + i * 4, rgba);
+        }
+        scalar::rgb565_to_rgba8(dst + i * 4, src + i * 2, count - i);
+    }
+
+    void rgba8_to_rgba4444(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const auto rgba = vld4_u8(src + i * 4);
+            const auto high = vsri_n_u8(rgba.val[0], rgba.val[1], 4); // r4:g4
+            const auto low = vsri_n_u8(rgba.val[2], rgba.val[3], 4); // b4:a4
+            vst1q_u16(reinterpret_cast<std::uint16_t *>(dst + i * 2), vorrq_u16(vshll_n_u8(high, 8), vmovl_u8(low)));
+        }
+        scalar::rgba8_to_rgba4444(dst + i * 2, src + i * 4, count - i);
+    }
+
+    void rgba4444_to_rgba8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const auto p = vld1q_u16(reinterpret_cast<const std::uint16_t *>(src + i * 2));
+            const auto high = vshrn_n_u16(p, 8), low = vmovn_u16(p);
+            // Replicate each nibble into both halves of a byte (x * 17)
+            const auto nibble = vdup_n_u8(0x0F);
+            const auto r = vshr_n_u8(high, 4), g = vand_u8(high, nibble);
+            const auto b = vshr_n_u8(low, 4), a = vand_u8(low, nibble);
+            const uint8x8x4_t rgba{{
+                    vorr_u8(vshl_n_u8(r, 4), r), vorr_u8(vshl_n_u8(g, 4), g),
+                    vorr_u8(vshl_n_u8(b, 4), b), vorr_u8(vshl_n_u8(a, 4), a)
+            }};
+            vst4_u8(dst + i * 4, rgba);
+        }
+        scalar::rgba4444_to_rgba8(dst + i * 4, src + i * 2, count - i);
+    }
+
+    void rgba8_to_rgba5551(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const auto rgba = vld4_u8(src + i * 4);
+            const auto r = vshll_n_u8(vand_u8(rgba.val[0], vdup_n_u8(0xF8)), 8);
+            const auto g = vshlq_n_u16(vmovl_u8(vand_u8(rgba.val[1], vdup_n_u8(0xF8))), 3);
+            const auto b = vmovl_u8(vshr_n_u8(vand_u8(rgba.val[2], vdup_n_u8(0xF8)), 2));
+            const auto a = vmovl_u8(vshr_n_u8(rgba.val[3], 7));
+            vst1q_u16(reinterpret_cast<std::uint16_t *>(dst + i * 2), vorrq_u16(vorrq_u16(r, g), vorrq_u16(b, a)));
+        }
+        scalar::rgba8_to_rgba5551(dst + i * 2, src + i * 4, count - i);
+    }
+
+    void rgba5551_to_rgba8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const auto p = vld1q_u16(reinterpret_cast<const std::uint16_t *>(src + i * 2));
+            const auto channel = vdupq_n_u16(0x1F);
+            const uint8x8x4_t rgba{{
+                    expand5(vshrq_n_u16(p, 11)),
+                    expand5(vandq_u16(vshrq_n_u16(p, 6), channel)),
+                    expand5(vandq_u16(vshrq_n_u16(p, 1), channel)),
+                    vmovn_u16(vtstq_u16(p, vdupq_n_u16(1)))
+            }};
+            vst4_u8(dst + i * 4, rgba);
+        }
+        scalar::rgba5551_to_rgba8(dst + i * 4, src + i * 2, count - i);
+    }
+
+    void downscale_box_rgba8(std::uint8_t *dst, const std::uint8_t *row0, const std::uint8_t *row1,
+                             std::size_t count) {
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const auto a = vld4q_u8(row0 + i * 8);
+            const auto b = vld4q_u8(row1 + i * 8);
+            uint8x8x4_t out;
+            for (int c = 0; c < 4; ++c) {
+                // Pairwise horizontal sums of both rows, then a rounding shift: (sum + 2) >> 2
+                const auto sum = vaddq_u16(vpaddlq_u8(a.val[c]), vpaddlq_u8(b.val[c]));
+                out.val[c] = vrshrn_n_u16(sum, 2);
+            }
+            vst4_u8(dst + i * 4, out);
+        }
+        scalar::downscale_box_rgba8(dst + i * 4, row0 + i * 8, row1 + i * 8, count - i);
+    }
+}
+
+namespace musubi::detail {
+    const pixmap_kernels neon_pixmap_kernels{
+            fill_rgba8,
+            blend_rgba8,
+            rgb8_to_rgba8,
+            rgba8_to_rgb8,
+            r8_to_rgba8,
+            rgba8_to_r8,
+            rgba8_to_rgb565,
+            rgb565_to_rgba8,
+            rgba8_to_rgba4444,
+            rgba4444_to_rgba8,
+            rgba8_to_rgba5551,
+            rgba5551_to_rgba8,
+            downscale_box_rgba8
+    };
+}
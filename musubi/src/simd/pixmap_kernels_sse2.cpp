@@ -0,0 +1,239 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#include "simd/pixmap_kernels.h"
+
+#include <emmintrin.h>
+
+namespace {
+    using namespace musubi::detail;
+
+    void fill_rgba8(std::uint8_t *dst, std::uint32_t pixel, std::size_t count) {
+        const auto value = _mm_set1_epi32(static_cast<int>(pixel));
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4) _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4), value);
+        scalar::fill_rgba8(dst + i * 4, pixel, count - i);
+    }
+
+    /// Blends two pixels onto opaque destination pixels, unpacked to 16-bit lanes.
+    inline __m128i blend_16(__m128i src, __m128i dst) {
+        const auto rgbMask = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+        const auto opaqueAlpha = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+        const auto max = _mm_set1_epi16(255);
+        const auto half = _mm_set1_epi16(128);
+
+        // Broadcast each pixel's alpha to all of its lanes
+        auto alpha = _mm_shufflelo_epi16(src, _MM_SHUFFLE(3, 3, 3, 3));
+        alpha = _mm_shufflehi_epi16(alpha, _MM_SHUFFLE(3, 3, 3, 3));
+        const auto inverse = _mm_sub_epi16(max, alpha);
+
+        // The destination alpha is blended against a source value of 255
+        src = _mm_or_si128(_mm_and_si128(src, rgbMask), opaqueAlpha);
+
+        auto value = _mm_add_epi16(_mm_mullo_epi16(src, alpha), _mm_mullo_epi16(dst, inverse));
+        value = _mm_add_epi16(value, half);
+        return _mm_srli_epi16(_mm_add_epi16(value, _mm_srli_epi16(value, 8)), 8);
+    }
+
+    void blend_rgba8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+        const auto zero = _mm_setzero_si128();
+        const auto rgbBytes = _mm_set1_epi32(0x00FFFFFF);
+        const auto ones = _mm_set1_epi32(-1);
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const auto s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 4));
+            const auto d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + i * 4));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_or_si128(d, rgbBytes), ones)) != 0xFFFF) {
+                // Translucent destination pixels need a division by the resulting alpha
+                scalar::blend_rgba8(dst + i * 4, src + i * 4, 4);
+                continue;
+            }
+            const auto low = blend_16(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero));
+            const auto high = blend_16(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4), _mm_packus_epi16(low, high));
+        }
+        scalar::blend_rgba8(dst + i * 4, src + i * 4, count - i);
+    }
+
+    void r8_to_rgba8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+        const auto zero = _mm_setzero_si128();
+        // Each 16-bit lane holds the bytes (0, 255), forming the B and A components
+        const auto alpha = _mm_set1_epi16(static_cast<short>(0xFF00));
+        std::size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            const auto r = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+            const auto low = _mm_unpacklo_epi8(r, zero);
+            const auto high = _mm_unpackhi_epi8(r, zero);
+            auto out = reinterpret_cast<__m128i *>(dst + i * 4);
+            _mm_storeu_si128(out + 0, _mm_unpacklo_epi16(low, alpha));
+            _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(low, alpha));
+            _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(high, alpha));
+            _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(high, alpha));
+        }
+        scalar::r8_to_rgba8(dst + i * 4, src + i, count - i);
+    }
+
+    void rgba8_to_r8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+        const auto mask = _mm_set1_epi32(0xFF);
+        std::size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            const auto in = reinterpret_cast<const __m128i *>(src + i * 4);
+            const auto a = _mm_and_si128(_mm_loadu_si128(in + 0), mask);
+            const auto b = _mm_and_si128(_mm_loadu_si128(in + 1), mask);
+            const auto c = _mm_and_si128(_mm_loadu_si128(in + 2), mask);
+            const auto d = _mm_and_si128(_mm_loadu_si128(in + 3), mask);
+            const auto packed = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), packed);
+        }
+        scalar::rgba8_to_r8(dst + i, src + i * 4, count - i);
+    }
+}
+
+namespace musubi::detail::sse2 {
+    void downscale_box_rgba8(std::uint8_t *dst, const std::uint8_t *row0, const std::uint8_t *row1,
+                             std::size_t count) {
+        const auto zero = _mm_setzero_si128();
+        const auto two = _mm_set1_epi16(2);
+        std::size_t i = 0;
+        // Each iteration reduces 8 pixels of both rows to 4 pixels
+        for (; i + 4 <= count; i += 4) {
+            const auto a0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row0 + i * 8));
+            const auto a1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row0 + i * 8 + 16));
+            const auto b0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row1 + i * 8));
+            const auto b1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row1 + i * 8 + 16));
+
+            // Vertical sums; each register holds two horizontally-adjacent pixels
+            const auto s0 = _mm_add_epi16(_mm_unpacklo_epi8(a0, zero), _mm_unpacklo_epi8(b0, zero));
+            const auto s1 = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(b0, zero));
+            const auto s2 = _mm_add_epi16(_mm_unpacklo_epi8(a1, zero), _mm_unpacklo_epi8(b1, zero));
+            const auto s3 = _mm_add_epi16(_mm_unpackhi_epi8(a1, zero), _mm_unpackhi_epi8(b1, zero));
+
+            // Horizontal sums: add the high pixel of each register to its low pixel
+            const auto low = _mm_add_epi16(_mm_unpacklo_epi64(s0, s1), _mm_unpackhi_epi64(s0, s1));
+            const auto high = _mm_add_epi16(_mm_unpacklo_epi64(s2, s3), _mm_unpackhi_epi64(s2, s3));
+
+            const auto out = _mm_packus_epi16(_mm_srli_epi16(_mm_add_epi16(low, two), 2),
+                                              _mm_srli_epi16(_mm_add_epi16(high, two), 2));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4), out);
+        }
+        scalar::downscale_box_rgba8(dst + i * 4, row0 + i * 8, row1 + i * 8, count - i);
+    }
+}
+
+namespace {
+    /// Packs 8 rgba8 pixels per iteration into 16-bit pixels; `pack` computes packed values in 32-bit lanes.
+    template<typename Pack>
+    inline void pack_rgba8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count,
+                           Pack pack, void (*fallback)(std::uint8_t *, const std::uint8_t *, std::size_t)) {
+        // SSE2 only packs 32-bit lanes with signed saturation; bias values into the signed range and back
+        const auto bias32 = _mm_set1_epi32(0x8000);
+        const auto bias16 = _mm_set1_epi16(static_cast<short>(0x8000));
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const auto in = reinterpret_cast<const __m128i *>(src + i * 4);
+            const auto low = _mm_sub_epi32(pack(_mm_loadu_si128(in + 0)), bias32);
+            const auto high = _mm_sub_epi32(pack(_mm_loadu_si128(in + 1)), bias32);
+            const auto out = _mm_xor_si128(_mm_packs_epi32(low, high), bias16);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 2), out);
+        }
+        fallback(dst + i * 2, src + i * 4, count - i);
+    }
+
+    /// Unpacks 8 16-bit pixels per iteration into rgba8 pixels; `unpack` operates on zero-extended 32-bit lanes.
+    template<typename Unpack>
+    inline void unpack_rgba8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count,
+                             Unpack unpack, void (*fallback)(std::uint8_t *, const std::uint8_t *, std::size_t)) {
+        const auto zero = _mm_setzero_si128();
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const auto in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 2));
+            auto out = reinterpret_cast<__m128i *>(dst + i * 4);
+            _mm_storeu_si128(out + 0, unpack(_mm_unpacklo_epi16(in, zero)));
+            _mm_storeu_si128(out + 1, unpack(_mm_unpackhi_epi16(in, zero)));
+        }
+        fallback(dst + i * 4, src + i * 2, count - i);
+    }
+
+    inline __m128i mask(__m128i value, int bits) { return _mm_and_si128(value, _mm_set1_epi32(bits)); }
+
+    /// Replicates the high bits of 5-bit values in 32-bit lanes to form 8-bit values.
+    inline __m128i expand5(__m128i value) { return _mm_or_si128(_mm_slli_epi32(value, 3), _mm_srli_epi32(value, 2)); }
+}
+
+namespace musubi::detail::sse2 {
+    void rgba8_to_rgb565(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+        pack_rgba8(dst, src, count, [](__m128i v) {
+            return _mm_or_si128(_mm_or_si128(_mm_slli_epi32(mask(v, 0xF8), 8), _mm_srli_epi32(mask(v, 0xFC00), 5)),
+                                _mm_srli_epi32(mask(v, 0xF80000), 19));
+        }, scalar::rgba8_to_rgb565);
+    }
+
+    void rgb565_to_rgba8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+        unpack_rgba8(dst, src, count, [](__m128i p) {
+            const auto r = expand5(_mm_srli_epi32(p, 11));
+            const auto g6 = mask(_mm_srli_epi32(p, 5), 0x3F);
+            const auto g = _mm_or_si128(_mm_slli_epi32(g6, 2), _mm_srli_epi32(g6, 4));
+            const auto b = expand5(mask(p, 0x1F));
+            const auto rgb = _mm_or_si128(_mm_or_si128(r, _mm_slli_epi32(g, 8)), _mm_slli_epi32(b, 16));
+            return _mm_or_si128(rgb, _mm_set1_epi32(static_cast<int>(0xFF000000u)));
+        }, scalar::rgb565_to_rgba8);
+    }
+
+    void rgba8_to_rgba4444(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+        pack_rgba8(dst, src, count, [](__m128i v) {
+            const auto rg = _mm_or_si128(_mm_slli_epi32(mask(v, 0xF0), 8), _mm_srli_epi32(mask(v, 0xF000), 4));
+            const auto ba = _mm_or_si128(_mm_srli_epi32(mask(v, 0xF00000), 16), _mm_srli_epi32(v, 28));
+            return _mm_or_si128(rg, ba);
+        }, scalar::rgba8_to_rgba4444);
+    }
+
+    void rgba4444_to_rgba8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+        unpack_rgba8(dst, src, count, [](__m128i p) {
+            // Move each nibble into its own byte, then replicate it into the high nibble (x * 17)
+            const auto r = _mm_srli_epi32(p, 12);
+            const auto g = mask(p, 0x0F00);
+            const auto b = _mm_slli_epi32(mask(p, 0x00F0), 12);
+            const auto a = _mm_slli_epi32(mask(p, 0x000F), 24);
+            const auto nibbles = _mm_or_si128(_mm_or_si128(r, g), _mm_or_si128(b, a));
+            return _mm_or_si128(nibbles, _mm_slli_epi32(nibbles, 4));
+        }, scalar::rgba4444_to_rgba8);
+    }
+
+    void rgba8_to_rgba5551(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+        pack_rgba8(dst, src, count, [](__m128i v) {
+            const auto rg = _mm_or_si128(_mm_slli_epi32(mask(v, 0xF8), 8), _mm_srli_epi32(mask(v, 0xF800), 5));
+            const auto ba = _mm_or_si128(_mm_srli_epi32(mask(v, 0xF80000), 18), _mm_srli_epi32(v, 31));
+            return _mm_or_si128(rg, ba);
+        }, scalar::rgba8_to_rgba5551);
+    }
+
+    void rgba5551_to_rgba8(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+        unpack_rgba8(dst, src, count, [](__m128i p) {
+            const auto r = expand5(_mm_srli_epi32(p, 11));
+            const auto g = expand5(mask(_mm_srli_epi32(p, 6), 0x1F));
+            const auto b = expand5(mask(_mm_srli_epi32(p, 1), 0x1F));
+            const auto a = _mm_slli_epi32(_mm_sub_epi32(_mm_setzero_si128(), mask(p, 1)), 24);
+            return _mm_or_si128(_mm_or_si128(r, _mm_slli_epi32(g, 8)), _mm_or_si128(_mm_slli_epi32(b, 16), a));
+        }, scalar::rgba5551_to_rgba8);
+    }
+}
+
+namespace musubi::detail {
+    // RGB shuffles require SSSE3; they are provided by the AVX2 kernels
+    const pixmap_kernels sse2_pixmap_kernels{
+            fill_rgba8,
+            blend_rgba8,
+            scalar::rgb8_to_rgba8,
+            scalar::rgba8_to_rgb8,
+            r8_to_rgba8,
+            rgba8_to_r8,
+            sse2::rgba8_to_rgb565,
+            sse2::rgb565_to_rgba8,
+            sse2::rgba8_to_rgba4444,
+            sse2::rgba4444_to_rgba8,
+            sse2::rgba8_to_rgba5551,
+            sse2::rgba5551_to_rgba8,
+            sse2::downscale_box_rgba8
+    };
+}
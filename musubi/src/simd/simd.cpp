@@ -0,0 +1,82 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#include <musubi/simd.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    using namespace std::literals;
+    using musubi::simd_level;
+
+    simd_level detect_simd_level() noexcept {
+#if defined(LIBMUSUBI_SIMD_X86)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return simd_level::avx2;
+        if (__builtin_cpu_supports("sse2")) return simd_level::sse2;
+        return simd_level::scalar;
+#elif defined(LIBMUSUBI_SIMD_NEON)
+        return simd_level::neon;
+#else
+        return simd_level::scalar;
+#endif
+    }
+
+    bool is_supported(simd_level level, simd_level supported) noexcept {
+        switch (level) {
+            case simd_level::scalar:
+                return true;
+            case simd_level::sse2:
+                return supported == simd_level::sse2 || supported == simd_level::avx2;
+            case simd_level::avx2:
+            case simd_level::neon:
+                return supported == level;
+            default:
+                return false;
+        }
+    }
+
+    // Function-local statics, since kernels may be dispatched during static initialization
+    simd_level supported_level() noexcept {
+        static const simd_level level = detect_simd_level();
+        return level;
+    }
+
+    std::atomic<simd_level> &active_level() noexcept {
+        static std::atomic<simd_level> level{supported_level()};
+        return level;
+    }
+}
+
+namespace musubi {
+    simd_level get_supported_simd_level() noexcept { return supported_level(); }
+
+    simd_level get_simd_level() noexcept { return active_level().load(std::memory_order_relaxed); }
+
+    void set_simd_level(simd_level level) {
+        if (!is_supported(level, supported_level())) {
+            throw std::invalid_argument("Instruction set level "s + get_simd_level_name(level)
+                                        + " is not supported (highest supported level: "s
+                                        + get_simd_level_name(supported_level()) + ")"s);
+        }
+        active_level().store(level, std::memory_order_relaxed);
+    }
+
+    const char *get_simd_level_name(simd_level level) noexcept {
+        switch (level) {
+            case simd_level::scalar:
+                return "scalar";
+            case simd_level::sse2:
+                return "SSE2";
+            case simd_level::avx2:
+                return "AVX2";
+            case simd_level::neon:
+                return "NEON";
+            default:
+                return "unknown";
+        }
+    }
+}
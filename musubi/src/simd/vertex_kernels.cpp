@@ -0,0 +1,74 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#include "simd/vertex_kernels.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace musubi::detail {
+    affine_transform to_affine_transform(const float *matrix) noexcept {
+        return {{{matrix[0], matrix[1]}, {matrix[3], matrix[4]}, {matrix[6], matrix[7]}}};
+    }
+
+    void pack_color(std::uint8_t (&dst)[4], const float *color) noexcept {
+        for (std::size_t i = 0; i < 4; ++i) {
+            dst[i] = static_cast<std::uint8_t>(std::min(std::max(color[i], 0.0f), 1.0f) * 255.0f + 0.5f);
+        }
+    }
+
+    namespace scalar {
+        void generate_quads(quad_vertex *dst, const quad_source *src, std::size_t count,
+                            const affine_transform &transform, std::uint8_t slot, bool flip) {
+            const auto &m = transform.columns;
+            for (std::size_t i = 0; i < count; ++i, ++src, dst += 4) {
+                const auto originX = (m[0][0] * src->x + m[1][0] * src->y) + m[2][0];
+                const auto originY = (m[0][1] * src->x + m[1][1] * src->y) + m[2][1];
+                const auto rightX = m[0][0] * src->width, rightY = m[0][1] * src->width;
+                const auto upX = m[1][0] * src->height, upY = m[1][1] * src->height;
+                const auto v1 = flip ? 1 - src->v1 : src->v1, v2 = flip ? 1 - src->v2 : src->v2;
+
+                dst[0] = {originX + upX, originY + upY, src->u1, v2, {}, slot, {}};
+                dst[1] = {originX, originY, src->u1, v1, {}, slot, {}};
+                dst[2] = {originX + rightX + upX, originY + rightY + upY, src->u2, v2, {}, slot, {}};
+                dst[3] = {originX + rightX, originY + rightY, src->u2, v1, {}, slot, {}};
+                for (std::size_t j = 0; j < 4; ++j) std::memcpy(dst[j].tint, src->tint, sizeof(src->tint));
+            }
+        }
+
+        void generate_lines(line_vertex *dst, const line_source *src, std::size_t count,
+                            const affine_transform &transform) {
+            const auto &m = transform.columns;
+            for (std::size_t i = 0; i < count; ++i, ++src, dst += 2) {
+                const auto &c = src->color;
+                dst[0] = {(m[0][0] * src->x1 + m[1][0] * src->y1) + m[2][0],
+                          (m[0][1] * src->x1 + m[1][1] * src->y1) + m[2][1], 0.0f, c[0], c[1], c[2], c[3]};
+                dst[1] = {(m[0][0] * src->x2 + m[1][0] * src->y2) + m[2][0],
+                          (m[0][1] * src->x2 + m[1][1] * src->y2) + m[2][1], 0.0f, c[0], c[1], c[2], c[3]};
+            }
+        }
+    }
+
+    const vertex_kernels scalar_vertex_kernels{
+            scalar::generate_quads,
+            scalar::generate_lines
+    };
+
+    const vertex_kernels &get_vertex_kernels() noexcept {
+        switch (get_simd_level()) {
+#if defined(LIBMUSUBI_SIMD_X86)
+            // Vertices are generated one primitive per 128-bit register; wider registers do not help
+            case simd_level::sse2:
+            case simd_level::avx2:
+                return sse2_vertex_kernels;
+#endif
+#if defined(LIBMUSUBI_SIMD_NEON)
+            case simd_level::neon:
+                return neon_vertex_kernels;
+#endif
+            default:
+                return scalar_vertex_kernels;
+        }
+    }
+}
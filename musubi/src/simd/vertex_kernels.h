@@ -0,0 +1,92 @@
+/// @file
+/// Kernels generating batched vertices for the OpenGL renderers, implemented once per @ref musubi::simd_level.
+/// @author agent
+/// @date 19 October 2026
+
+#ifndef MUSUBI_SIMD_VERTEX_KERNELS_H
+#define MUSUBI_SIMD_VERTEX_KERNELS_H
+
+#include <musubi/simd.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace musubi::detail {
+    // The layouts below mirror gl::sprite, gl::detail::sprite_vertex, gl::line and the shape renderer's vertex,
+    // without depending on OpenGL; the renderers assert that they match.
+
+    /// A sprite: its rectangle, its texture coordinates and its RGBA tint.
+    struct quad_source {
+        float x, y, width, height;
+        float u1, v1, u2, v2;
+        std::uint8_t tint[4];
+    };
+
+    /// A sprite quad vertex.
+    struct quad_vertex {
+        float x, y;
+        float u, v;
+        std::uint8_t tint[4];
+        std::uint8_t slot;
+        std::uint8_t padding[3];
+    };
+
+    /// A line: its two end points and its RGBA color.
+    struct line_source {
+        float x1, y1, x2, y2;
+        float color[4];
+    };
+
+    /// A line vertex.
+    struct line_vertex {
+        float x, y, z;
+        float r, g, b, a;
+    };
+
+    /// A 2D affine transformation; the first two rows of a column-major 3x3 matrix.
+    struct affine_transform {
+        float columns[3][2];
+    };
+
+    /// A table of vertex kernels. Every kernel writes its vertices sequentially, so that the destination
+    /// may be write-combined (mapped) memory. Positions are transformed exactly like glm would:
+    /// `(m[0] * x + m[1] * y) + m[2]`, followed by adding the transformed edges one at a time.
+    struct vertex_kernels {
+        /// Generates four vertices per sprite, in the order upper left, lower left, upper right, lower right.
+        /// If `flip` is set, V coordinates are replaced by `1 - v`.
+        void (*generate_quads)(quad_vertex *dst, const quad_source *src, std::size_t count,
+                               const affine_transform &transform, std::uint8_t slot, bool flip);
+
+        /// Generates two vertices per line.
+        void (*generate_lines)(line_vertex *dst, const line_source *src, std::size_t count,
+                               const affine_transform &transform);
+    };
+
+    /// Converts a column-major 3x3 matrix (such as a `glm::mat3`) into the transformation applied by the kernels.
+    affine_transform to_affine_transform(const float *matrix) noexcept;
+
+    /// Packs a normalized RGBA color into the tint bytes of sprite vertices,
+    /// clamping each component to [0, 1] and rounding to nearest.
+    void pack_color(std::uint8_t (&dst)[4], const float *color) noexcept;
+
+    namespace scalar {
+        void generate_quads(quad_vertex *dst, const quad_source *src, std::size_t count,
+                            const affine_transform &transform, std::uint8_t slot, bool flip);
+
+        void generate_lines(line_vertex *dst, const line_source *src, std::size_t count,
+                            const affine_transform &transform);
+    }
+
+    extern const vertex_kernels scalar_vertex_kernels;
+#if defined(LIBMUSUBI_SIMD_X86)
+    extern const vertex_kernels sse2_vertex_kernels;
+#endif
+#if defined(LIBMUSUBI_SIMD_NEON)
+    extern const vertex_kernels neon_vertex_kernels;
+#endif
+
+    /// Retrieves the kernel table for the active @ref musubi::simd_level.
+    const vertex_kernels &get_vertex_kernels() noexcept;
+}
+
+#endif //MUSUBI_SIMD_VERTEX_KERNELS_H
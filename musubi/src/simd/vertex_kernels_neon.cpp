@@ -0,0 +1,90 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#include "simd/vertex_kernels.h"
+
+#include <arm_neon.h>
+
+#include <cstring>
+
+namespace {
+    using namespace musubi::detail;
+
+    /// Broadcasts a column of a transformation to both halves of a register.
+    inline float32x4_t load_column(const float (&column)[2]) {
+        const auto half = vld1_f32(column);
+        return vcombine_f32(half, half);
+    }
+
+    void generate_quads(quad_vertex *dst, const quad_source *src, std::size_t count,
+                        const affine_transform &transform, std::uint8_t slot, bool flip) {
+        const auto col0 = load_column(transform.columns[0]);
+        const auto col1 = load_column(transform.columns[1]);
+        const auto col2 = load_column(transform.columns[2]);
+        const std::uint32_t lowLanes[4]{~0u, ~0u, 0u, 0u};
+        const std::uint32_t flipLanes[4]{0u, flip ? ~0u : 0u, 0u, flip ? ~0u : 0u};
+        const auto lowMask = vld1q_u32(lowLanes);
+        const auto flipMask = vld1q_u32(flipLanes);
+        const auto one = vdupq_n_f32(1);
+        const auto slotBits = std::uint64_t{slot} << 32u;
+
+        for (std::size_t i = 0; i < count; ++i, ++src, dst += 4) {
+            // Each register holds two points: (x, y, x, y)
+            const auto origin = vaddq_f32(vaddq_f32(vmulq_f32(col0, vdupq_n_f32(src->x)),
+                                                    vmulq_f32(col1, vdupq_n_f32(src->y))), col2);
+            const auto up = vmulq_f32(col1, vdupq_n_f32(src->height));
+            const auto originRight = vaddq_f32(origin, vmulq_f32(col0, vdupq_n_f32(src->width)));
+            // (upper left, lower left) and (upper right, lower right)
+            const auto left = vbslq_f32(lowMask, vaddq_f32(origin, up), origin);
+            const auto right = vbslq_f32(lowMask, vaddq_f32(originRight, up), originRight);
+
+            auto uv = vld1q_f32(&src->u1);
+            uv = vbslq_f32(flipMask, vsubq_f32(one, uv), uv);
+            const auto uv1 = vget_low_f32(uv), uv2 = vget_high_f32(uv); // (u1, v1), (u2, v2)
+            const auto u1v2 = vcopy_lane_f32(uv1, 1, uv2, 1), u2v1 = vcopy_lane_f32(uv2, 1, uv1, 1);
+
+            // The tint and slot bytes of each vertex
+            std::uint32_t tint;
+            std::memcpy(&tint, src->tint, sizeof(tint));
+            const auto tail = vcreate_u8(slotBits | tint);
+
+            vst1q_f32(&dst[0].x, vcombine_f32(vget_low_f32(left), u1v2));
+            vst1_u8(dst[0].tint, tail);
+            vst1q_f32(&dst[1].x, vcombine_f32(vget_high_f32(left), uv1));
+            vst1_u8(dst[1].tint, tail);
+            vst1q_f32(&dst[2].x, vcombine_f32(vget_low_f32(right), uv2));
+            vst1_u8(dst[2].tint, tail);
+            vst1q_f32(&dst[3].x, vcombine_f32(vget_high_f32(right), u2v1));
+            vst1_u8(dst[3].tint, tail);
+        }
+    }
+
+    void generate_lines(line_vertex *dst, const line_source *src, std::size_t count,
+                        const affine_transform &transform) {
+        const auto col0 = load_column(transform.columns[0]);
+        const auto col1 = load_column(transform.columns[1]);
+        const auto col2 = load_column(transform.columns[2]);
+        const auto zero = vdup_n_f32(0);
+
+        for (std::size_t i = 0; i < count; ++i, ++src, dst += 2) {
+            const auto xs = vcombine_f32(vdup_n_f32(src->x1), vdup_n_f32(src->x2));
+            const auto ys = vcombine_f32(vdup_n_f32(src->y1), vdup_n_f32(src->y2));
+            const auto positions = vaddq_f32(vaddq_f32(vmulq_f32(col0, xs), vmulq_f32(col1, ys)), col2);
+            const auto color = vld1q_f32(src->color);
+
+            // Each position is stored with z = 0 and a fourth lane that is overwritten by the color
+            vst1q_f32(&dst[0].x, vcombine_f32(vget_low_f32(positions), zero));
+            vst1q_f32(&dst[0].r, color);
+            vst1q_f32(&dst[1].x, vcombine_f32(vget_high_f32(positions), zero));
+            vst1q_f32(&dst[1].r, color);
+        }
+    }
+}
+
+namespace musubi::detail {
+    const vertex_kernels neon_vertex_kernels{
+            generate_quads,
+            generate_lines
+    };
+}
@@ -0,0 +1,98 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#include "simd/vertex_kernels.h"
+
+#include <emmintrin.h>
+
+#include <cstring>
+
+namespace {
+    using namespace musubi::detail;
+
+    /// Selects the lanes of `a` where `mask` is set, and the lanes of `b` elsewhere.
+    inline __m128 select(__m128 mask, __m128 a, __m128 b) {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+
+    /// Broadcasts a column of a transformation to both halves of a register.
+    inline __m128 load_column(const float (&column)[2]) {
+        return _mm_set_ps(column[1], column[0], column[1], column[0]);
+    }
+
+    void generate_quads(quad_vertex *dst, const quad_source *src, std::size_t count,
+                        const affine_transform &transform, std::uint8_t slot, bool flip) {
+        const auto col0 = load_column(transform.columns[0]);
+        const auto col1 = load_column(transform.columns[1]);
+        const auto col2 = load_column(transform.columns[2]);
+        const auto lowMask = _mm_castsi128_ps(_mm_set_epi32(0, 0, -1, -1));
+        const auto flipMask = flip ? _mm_castsi128_ps(_mm_set_epi32(-1, 0, -1, 0)) : _mm_setzero_ps();
+        const auto one = _mm_set1_ps(1);
+
+        for (std::size_t i = 0; i < count; ++i, ++src, dst += 4) {
+            // Each register holds two points: (x, y, x, y)
+            const auto rect = _mm_loadu_ps(&src->x);
+            const auto xs = _mm_shuffle_ps(rect, rect, _MM_SHUFFLE(0, 0, 0, 0));
+            const auto ys = _mm_shuffle_ps(rect, rect, _MM_SHUFFLE(1, 1, 1, 1));
+            const auto widths = _mm_shuffle_ps(rect, rect, _MM_SHUFFLE(2, 2, 2, 2));
+            const auto heights = _mm_shuffle_ps(rect, rect, _MM_SHUFFLE(3, 3, 3, 3));
+
+            const auto origin = _mm_add_ps(_mm_add_ps(_mm_mul_ps(col0, xs), _mm_mul_ps(col1, ys)), col2);
+            const auto up = _mm_mul_ps(col1, heights);
+            const auto originRight = _mm_add_ps(origin, _mm_mul_ps(col0, widths));
+            // (upper left, lower left) and (upper right, lower right)
+            const auto left = select(lowMask, _mm_add_ps(origin, up), origin);
+            const auto right = select(lowMask, _mm_add_ps(originRight, up), originRight);
+
+            auto uv = _mm_loadu_ps(&src->u1);
+            uv = select(flipMask, _mm_sub_ps(one, uv), uv);
+            const auto uvLeft = _mm_shuffle_ps(uv, uv, _MM_SHUFFLE(1, 0, 3, 0)); // (u1, v2, u1, v1)
+            const auto uvRight = _mm_shuffle_ps(uv, uv, _MM_SHUFFLE(1, 2, 3, 2)); // (u2, v2, u2, v1)
+
+            // The tint and slot bytes of each vertex
+            std::int32_t tint;
+            std::memcpy(&tint, src->tint, sizeof(tint));
+            const auto tail = _mm_set_epi32(0, 0, slot, tint);
+
+            _mm_storeu_ps(&dst[0].x, _mm_movelh_ps(left, uvLeft));
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(dst[0].tint), tail);
+            _mm_storeu_ps(&dst[1].x, _mm_movehl_ps(uvLeft, left));
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(dst[1].tint), tail);
+            _mm_storeu_ps(&dst[2].x, _mm_movelh_ps(right, uvRight));
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(dst[2].tint), tail);
+            _mm_storeu_ps(&dst[3].x, _mm_movehl_ps(uvRight, right));
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(dst[3].tint), tail);
+        }
+    }
+
+    void generate_lines(line_vertex *dst, const line_source *src, std::size_t count,
+                        const affine_transform &transform) {
+        const auto col0 = load_column(transform.columns[0]);
+        const auto col1 = load_column(transform.columns[1]);
+        const auto col2 = load_column(transform.columns[2]);
+        const auto lowMask = _mm_castsi128_ps(_mm_set_epi32(0, 0, -1, -1));
+        const auto zero = _mm_setzero_ps();
+
+        for (std::size_t i = 0; i < count; ++i, ++src, dst += 2) {
+            const auto points = _mm_loadu_ps(&src->x1);
+            const auto xs = _mm_shuffle_ps(points, points, _MM_SHUFFLE(2, 2, 0, 0));
+            const auto ys = _mm_shuffle_ps(points, points, _MM_SHUFFLE(3, 3, 1, 1));
+            const auto positions = _mm_add_ps(_mm_add_ps(_mm_mul_ps(col0, xs), _mm_mul_ps(col1, ys)), col2);
+            const auto color = _mm_loadu_ps(src->color);
+
+            // Each position is stored with z = 0 and a fourth lane that is overwritten by the color
+            _mm_storeu_ps(&dst[0].x, _mm_and_ps(positions, lowMask));
+            _mm_storeu_ps(&dst[0].r, color);
+            _mm_storeu_ps(&dst[1].x, _mm_movehl_ps(zero, positions));
+            _mm_storeu_ps(&dst[1].r, color);
+        }
+    }
+}
+
+namespace musubi::detail {
+    const vertex_kernels sse2_vertex_kernels{
+            generate_quads,
+            generate_lines
+    };
+}
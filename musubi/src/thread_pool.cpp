@@ -0,0 +1,83 @@
+/// @file
+/// @author agent
+/// @date 19 October 2026
+
+#include <musubi/thread_pool.h>
+
+#include <musubi/exception.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+namespace musubi {
+    using namespace musubi::detail;
+
+    struct thread_pool::impl {
+        std::mutex mutex;
+        std::condition_variable available;
+        std::deque<std::function<void()>> tasks;
+        bool stopping{false};
+
+        std::vector<std::thread> workers;
+
+        LIBMUSUBI_DELCP(impl)
+
+        explicit impl(uint32 threadCount) {
+            if (threadCount == 0) threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+            workers.reserve(threadCount);
+            for (uint32 i = 0; i < threadCount; ++i) workers.emplace_back([this]() { work(); });
+        }
+
+        ~impl() {
+            {
+                std::lock_guard lock(mutex);
+                stopping = true;
+                tasks.clear();
+            }
+            available.notify_all();
+            for (auto &worker : workers) worker.join();
+        }
+
+        void post(std::function<void()> task) {
+            {
+                std::lock_guard lock(mutex);
+                if (stopping) throw illegal_state_error("Cannot post task; thread pool is shutting down");
+                tasks.push_back(std::move(task));
+            }
+            available.notify_one();
+        }
+
+        void work() {
+            while (true) {
+                std::function<void()> task;
+                {
+                    std::unique_lock lock(mutex);
+                    available.wait(lock, [this]() { return stopping || !tasks.empty(); });
+                    if (stopping) return;
+                    task = std::move(tasks.front());
+                    tasks.pop_front();
+                }
+
+                try {
+                    task();
+                } catch (const std::exception &e) {
+                    log_e("thread_pool") << "Uncaught exception in pooled task: " << e.what() << '\n';
+                } catch (...) {
+                    log_e("thread_pool") << "Uncaught exception in pooled task\n";
+                }
+            }
+        }
+    };
+
+    thread_pool::thread_pool(uint32 threadCount) : pImpl(std::make_unique<impl>(threadCount)) {}
+
+    thread_pool::~thread_pool() noexcept = default;
+
+    void thread_pool::post(std::function<void()> task) { pImpl->post(std::move(task)); }
+
+    uint32 thread_pool::get_thread_count() const noexcept { return pImpl->workers.size(); }
+}
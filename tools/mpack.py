@@ -1,6 +1,10 @@
 #!/usr/bin/env python3
 """
 Generates asset packs from a specified list of directories (or pack.json files.)
+
+A pack.json file that specifies a "base" pack name produces a patch pack;
+patch packs only need to list the entries they change or add, and are layered over their base pack at runtime
+in ascending order of their optional "priority".
 """
 import argparse
 import io
@@ -48,6 +52,13 @@ class MPack:
 
         name = name or meta.get("name", meta_path.parent.name)
 
+        base = meta.get("base")
+        if base is not None:
+            if base == name:
+                self.error(f"{meta_path}: patch pack {name} cannot name itself as its base")
+                return -1
+            self.verbose(f"{meta_path}: is a patch pack for {base} (priority {meta.get('priority', 0)})")
+
         if destination_parent.is_dir():
             destination_path = destination_parent / f"{name}.mpack"
         elif self.single: